@@ -2,13 +2,18 @@
 # pipeline_radar_inference.sh - Radar cube inference pipeline
 #
 # Subscribes to a Zenoh RadarCube topic, runs inference via NNStreamer
-# tensor_filter, and publishes results back to Zenoh.
+# tensor_filter, and publishes the detections back to Zenoh as
+# edgefirst_msgs/Detect. edgefirstoverlay decodes the model output and
+# attaches the boxes as EdgefirstDetectionMeta; radar has no camera frame,
+# so it draws onto a blank live canvas that is never displayed.
 #
 # Prerequisites:
 #   - Zenoh router running (zenohd)
 #   - Radar publisher on the configured topic (e.g., EdgeFirst radarpub)
 #   - NNStreamer with TensorFlow Lite support
-#   - A radar detection model (e.g., radar_detector.tflite)
+#   - A radar detection model (e.g., radar_detector.tflite) whose output
+#     edgefirstoverlay can decode (YOLO-style, or describe it in a
+#     model-config file)
 #
 # Usage: ./pipeline_radar_inference.sh [model] [in_topic] [out_topic]
 #   model:     Path to TFLite model (default: radar_detector.tflite)
@@ -31,7 +36,9 @@ fi
 echo "==> Radar inference: ${IN_TOPIC} -> ${MODEL} -> ${OUT_TOPIC}"
 
 gst-launch-1.0 \
+  edgefirstoverlay name=ov model-sync=true frame-id=radar \
+  videotestsrc is-live=true pattern=black \
+  ! video/x-raw,format=RGBA,width=640,height=640,framerate=10/1 ! ov.video \
   edgefirstzenohsub topic="${IN_TOPIC}" message-type=radarcube session="${SESSION}" \
-  ! tensor_filter framework=tensorflow2-lite model="${MODEL}" \
-  ! tensor_decoder mode=bounding_boxes \
-  ! edgefirstzenohpub topic="${OUT_TOPIC}" message-type=image session="${SESSION}"
+  ! tensor_filter framework=tensorflow2-lite model="${MODEL}" ! ov.tensors \
+  ov. ! edgefirstzenohpub topic="${OUT_TOPIC}" message-type=detect session="${SESSION}"
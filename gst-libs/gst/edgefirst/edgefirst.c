@@ -33,6 +33,7 @@ edgefirst_perception_init (void)
   edgefirst_radar_cube_meta_get_info ();
   edgefirst_transform_meta_get_info ();
   edgefirst_camera_info_meta_get_info ();
+  edgefirst_detection_meta_get_info ();
 
   /* Ensure detection GTypes are registered */
   edgefirst_detect_box_get_type ();
@@ -14,6 +14,8 @@
 #include <gst/edgefirst/edgefirsttransformmeta.h>
 #include <gst/edgefirst/edgefirstcamerainfometa.h>
 #include <gst/edgefirst/edgefirstdetection.h>
+#include <gst/edgefirst/edgefirstdetectionmeta.h>
+#include <gst/edgefirst/edgefirstcdr.h>
 
 G_BEGIN_DECLS
 
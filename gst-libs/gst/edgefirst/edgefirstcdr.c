@@ -0,0 +1,570 @@
+/*
+ * EdgeFirst Perception for GStreamer
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstcdr.h"
+#include <string.h>
+
+/* ── Bounds-checked CDR reader ─────────────────────────────────────── */
+
+/* Size of the encapsulation header; CDR alignment is relative to its end. */
+#define CDR_ENCAPSULATION_LEN 4
+
+/* The reader normally walks one contiguous buffer.  For payloads that
+ * arrive in several pieces it can instead see a linearized @head and @tail
+ * of a longer message: scalars must then fall entirely inside one of the
+ * two, while sequences in between are bounds-checked against @total and
+ * skipped without being touched. */
+typedef struct {
+  const guint8 *data;
+  gsize len;
+  const guint8 *tail;
+  gsize tail_off;
+  gsize total;
+  gsize off;
+  gboolean swap;
+} CdrReader;
+
+static gboolean
+cdr_reader_init_split (CdrReader *r, const guint8 *head, gsize head_len,
+    const guint8 *tail, gsize tail_len, gsize total_len)
+{
+  if (!head || head_len < CDR_ENCAPSULATION_LEN || head[0] != 0x00)
+    return FALSE;
+  if (head_len > total_len || tail_len > total_len || (tail_len && !tail))
+    return FALSE;
+
+  /* 0x0000 = CDR_BE, 0x0001 = CDR_LE */
+  if (head[1] == 0x01)
+    r->swap = (G_BYTE_ORDER == G_BIG_ENDIAN);
+  else if (head[1] == 0x00)
+    r->swap = (G_BYTE_ORDER == G_LITTLE_ENDIAN);
+  else
+    return FALSE;
+
+  r->data = head;
+  r->len = head_len;
+  r->tail = tail_len ? tail : NULL;
+  r->tail_off = total_len - tail_len;
+  r->total = total_len;
+  r->off = CDR_ENCAPSULATION_LEN;
+  return TRUE;
+}
+
+static gboolean
+cdr_reader_init (CdrReader *r, const guint8 *data, gsize len)
+{
+  return cdr_reader_init_split (r, data, len, NULL, 0, len);
+}
+
+/* Returns the @n bytes at the read position, or NULL if they are past the
+ * end of the message or not linearized in either the head or the tail. */
+static inline const guint8 *
+cdr_peek (const CdrReader *r, gsize n)
+{
+  if (n > r->total - r->off)
+    return NULL;
+  if (n <= r->len && r->off <= r->len - n)
+    return r->data + r->off;
+  if (r->tail && r->off >= r->tail_off)
+    return r->tail + (r->off - r->tail_off);
+  return NULL;
+}
+
+static inline gboolean
+cdr_align (CdrReader *r, gsize align)
+{
+  gsize rel = r->off - CDR_ENCAPSULATION_LEN;
+  gsize pad = (align - (rel % align)) % align;
+
+  if (pad > r->total - r->off)
+    return FALSE;
+  r->off += pad;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_u8 (CdrReader *r, guint8 *v)
+{
+  const guint8 *p = cdr_peek (r, 1);
+
+  if (!p)
+    return FALSE;
+  *v = *p;
+  r->off++;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_bool (CdrReader *r, gboolean *v)
+{
+  guint8 b;
+
+  if (!cdr_read_u8 (r, &b))
+    return FALSE;
+  *v = b != 0;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_u16 (CdrReader *r, guint16 *v)
+{
+  const guint8 *p;
+
+  if (!cdr_align (r, 2) || !(p = cdr_peek (r, 2)))
+    return FALSE;
+  memcpy (v, p, 2);
+  if (r->swap)
+    *v = GUINT16_SWAP_LE_BE (*v);
+  r->off += 2;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_u32 (CdrReader *r, guint32 *v)
+{
+  const guint8 *p;
+
+  if (!cdr_align (r, 4) || !(p = cdr_peek (r, 4)))
+    return FALSE;
+  memcpy (v, p, 4);
+  if (r->swap)
+    *v = GUINT32_SWAP_LE_BE (*v);
+  r->off += 4;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_i32 (CdrReader *r, gint32 *v)
+{
+  return cdr_read_u32 (r, (guint32 *) v);
+}
+
+static inline gboolean
+cdr_read_u64 (CdrReader *r, guint64 *v)
+{
+  const guint8 *p;
+
+  if (!cdr_align (r, 8) || !(p = cdr_peek (r, 8)))
+    return FALSE;
+  memcpy (v, p, 8);
+  if (r->swap)
+    *v = GUINT64_SWAP_LE_BE (*v);
+  r->off += 8;
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_f32 (CdrReader *r, gfloat *v)
+{
+  guint32 bits;
+
+  if (!cdr_read_u32 (r, &bits))
+    return FALSE;
+  memcpy (v, &bits, 4);
+  return TRUE;
+}
+
+static inline gboolean
+cdr_read_f64 (CdrReader *r, gdouble *v)
+{
+  guint64 bits;
+
+  if (!cdr_read_u64 (r, &bits))
+    return FALSE;
+  memcpy (v, &bits, 8);
+  return TRUE;
+}
+
+/* Strings are a uint32 length (including the NUL) followed by the chars.
+ * A zero length is accepted as the empty string. */
+static gboolean
+cdr_read_string (CdrReader *r, const gchar **str, guint32 *str_len)
+{
+  const guint8 *p;
+  guint32 n;
+
+  if (!cdr_read_u32 (r, &n))
+    return FALSE;
+
+  if (n == 0) {
+    *str = "";
+    if (str_len)
+      *str_len = 0;
+    return TRUE;
+  }
+
+  p = cdr_peek (r, n);
+  if (!p || p[n - 1] != '\0')
+    return FALSE;
+
+  *str = (const gchar *) p;
+  if (str_len)
+    *str_len = n - 1;
+  r->off += n;
+  return TRUE;
+}
+
+/* Reads a sequence length and skips over its elements, returning the
+ * message offset of the (aligned) first element.  @elems is set to the
+ * elements when they are linearized, or NULL for a split payload whose
+ * elements lie outside the head and tail. */
+static gboolean
+cdr_read_sequence (CdrReader *r, gsize elem_size, const guint8 **elems,
+    gsize *elems_off, guint32 *count)
+{
+  guint32 n;
+  gsize size;
+
+  if (!cdr_read_u32 (r, &n))
+    return FALSE;
+  if (n > 0 && !cdr_align (r, elem_size))
+    return FALSE;
+  if ((guint64) n * elem_size > r->total - r->off)
+    return FALSE;
+
+  size = (gsize) n * elem_size;
+  *elems = cdr_peek (r, size);
+  if (elems_off)
+    *elems_off = r->off;
+  *count = n;
+  r->off += size;
+  return TRUE;
+}
+
+/* Returns a reader positioned on the sequence element at message offset
+ * @off, so the elements can be decoded in wire byte order. */
+static inline CdrReader
+cdr_reader_at (const CdrReader *r, gsize off)
+{
+  CdrReader sub = *r;
+
+  sub.off = off;
+  return sub;
+}
+
+static gboolean
+cdr_read_f64_array (CdrReader *r, gdouble *out, guint n)
+{
+  for (guint i = 0; i < n; i++) {
+    if (!cdr_read_f64 (r, &out[i]))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static gboolean
+cdr_read_header (CdrReader *r, EdgefirstCdrHeader *header)
+{
+  return cdr_read_i32 (r, &header->stamp_sec) &&
+      cdr_read_u32 (r, &header->stamp_nanosec) &&
+      cdr_read_string (r, &header->frame_id, &header->frame_id_len);
+}
+
+/* ── Header ────────────────────────────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_header_parse (const guint8 *data, gsize len,
+    EdgefirstCdrHeader *header)
+{
+  CdrReader r;
+
+  g_return_val_if_fail (header != NULL, FALSE);
+
+  return cdr_reader_init (&r, data, len) && cdr_read_header (&r, header);
+}
+
+guint64
+edgefirst_cdr_header_get_timestamp_ns (const EdgefirstCdrHeader *header)
+{
+  g_return_val_if_fail (header != NULL, 0);
+
+  if (header->stamp_sec < 0)
+    return 0;
+
+  return (guint64) header->stamp_sec * G_GUINT64_CONSTANT (1000000000)
+      + header->stamp_nanosec;
+}
+
+/* ── sensor_msgs/PointCloud2 ───────────────────────────────────────── */
+
+/* PointField: string name, uint32 offset, uint8 datatype, uint32 count */
+static gboolean
+cdr_read_point_field (CdrReader *r, EdgefirstPointFieldDesc *field)
+{
+  const gchar *name;
+  guint32 offset, count;
+  guint8 datatype;
+
+  if (!cdr_read_string (r, &name, NULL) ||
+      !cdr_read_u32 (r, &offset) ||
+      !cdr_read_u8 (r, &datatype) ||
+      !cdr_read_u32 (r, &count))
+    return FALSE;
+
+  if (field) {
+    g_strlcpy (field->name, name, sizeof (field->name));
+    field->offset = offset;
+    field->datatype = datatype;
+    field->count = count;
+  }
+  return TRUE;
+}
+
+gboolean
+edgefirst_cdr_pointcloud2_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrPointCloud2View *view)
+{
+  return edgefirst_cdr_pointcloud2_view_parse_split (data, len, NULL, 0, len,
+      view);
+}
+
+gboolean
+edgefirst_cdr_pointcloud2_view_parse_split (const guint8 *head,
+    gsize head_len, const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrPointCloud2View *view)
+{
+  CdrReader r;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  if (!cdr_reader_init_split (&r, head, head_len, tail, tail_len, total_len) ||
+      !cdr_read_header (&r, &view->header) ||
+      !cdr_read_u32 (&r, &view->height) ||
+      !cdr_read_u32 (&r, &view->width) ||
+      !cdr_read_u32 (&r, &view->num_fields))
+    return FALSE;
+
+  /* Validate every field now so get_fields() cannot fail later */
+  view->_fields_offset = r.off;
+  for (guint32 i = 0; i < view->num_fields; i++) {
+    if (!cdr_read_point_field (&r, NULL))
+      return FALSE;
+  }
+  /* get_fields() re-reads the fields from the head alone */
+  if (r.off > head_len)
+    return FALSE;
+  view->fields = head + view->_fields_offset;
+  view->fields_len = (guint32) (r.off - view->_fields_offset);
+
+  if (!cdr_read_bool (&r, &view->is_bigendian) ||
+      !cdr_read_u32 (&r, &view->point_step) ||
+      !cdr_read_u32 (&r, &view->row_step) ||
+      !cdr_read_sequence (&r, 1, &view->data, &view->data_offset,
+          &view->data_len) ||
+      !cdr_read_bool (&r, &view->is_dense))
+    return FALSE;
+
+  view->_cdr = head;
+  view->_cdr_len = head_len;
+  return TRUE;
+}
+
+guint
+edgefirst_cdr_pointcloud2_view_get_fields (
+    const EdgefirstCdrPointCloud2View *view,
+    EdgefirstPointFieldDesc *out_fields, guint max_fields)
+{
+  CdrReader r;
+  guint n;
+
+  g_return_val_if_fail (view != NULL, 0);
+  g_return_val_if_fail (out_fields != NULL || max_fields == 0, 0);
+
+  if (!cdr_reader_init (&r, view->_cdr, view->_cdr_len))
+    return 0;
+  r.off = view->_fields_offset;
+
+  n = MIN (view->num_fields, max_fields);
+  for (guint i = 0; i < n; i++) {
+    if (!cdr_read_point_field (&r, &out_fields[i]))
+      return i;
+  }
+  return n;
+}
+
+/* ── edgefirst_msgs/RadarCube ──────────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_radar_cube_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrRadarCubeView *view)
+{
+  return edgefirst_cdr_radar_cube_view_parse_split (data, len, NULL, 0, len,
+      view);
+}
+
+gboolean
+edgefirst_cdr_radar_cube_view_parse_split (const guint8 *head,
+    gsize head_len, const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrRadarCubeView *view)
+{
+  CdrReader r, elems;
+  const guint8 *p;
+  gsize off;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  if (!cdr_reader_init_split (&r, head, head_len, tail, tail_len, total_len) ||
+      !cdr_read_header (&r, &view->header) ||
+      !cdr_read_u64 (&r, &view->timestamp))
+    return FALSE;
+
+  /* layout: sequence<uint8> */
+  if (!cdr_read_sequence (&r, 1, &p, NULL, &view->layout_len) || !p)
+    return FALSE;
+  memset (view->layout, 0, sizeof (view->layout));
+  memcpy (view->layout, p, MIN (view->layout_len, EDGEFIRST_RADAR_MAX_DIMS));
+
+  /* shape: sequence<uint16> */
+  memset (view->shape, 0, sizeof (view->shape));
+  if (!cdr_read_sequence (&r, 2, &p, &off, &view->shape_len) || !p)
+    return FALSE;
+  elems = cdr_reader_at (&r, off);
+  for (guint32 i = 0; i < MIN (view->shape_len, EDGEFIRST_RADAR_MAX_DIMS); i++)
+    cdr_read_u16 (&elems, &view->shape[i]);
+
+  /* scales: sequence<float32> */
+  memset (view->scales, 0, sizeof (view->scales));
+  if (!cdr_read_sequence (&r, 4, &p, &off, &view->scales_len) || !p)
+    return FALSE;
+  elems = cdr_reader_at (&r, off);
+  for (guint32 i = 0; i < MIN (view->scales_len, EDGEFIRST_RADAR_MAX_DIMS); i++)
+    cdr_read_f32 (&elems, &view->scales[i]);
+
+  /* cube: sequence<int16>, left in wire order */
+  return cdr_read_sequence (&r, 2, &view->cube, &view->cube_offset,
+      &view->cube_len) && cdr_read_bool (&r, &view->is_complex);
+}
+
+/* ── sensor_msgs/Image ─────────────────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_image_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrImageView *view)
+{
+  return edgefirst_cdr_image_view_parse_split (data, len, NULL, 0, len, view);
+}
+
+gboolean
+edgefirst_cdr_image_view_parse_split (const guint8 *head, gsize head_len,
+    const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrImageView *view)
+{
+  CdrReader r;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  return cdr_reader_init_split (&r, head, head_len, tail, tail_len,
+          total_len) &&
+      cdr_read_header (&r, &view->header) &&
+      cdr_read_u32 (&r, &view->height) &&
+      cdr_read_u32 (&r, &view->width) &&
+      cdr_read_string (&r, &view->encoding, &view->encoding_len) &&
+      cdr_read_bool (&r, &view->is_bigendian) &&
+      cdr_read_u32 (&r, &view->step) &&
+      cdr_read_sequence (&r, 1, &view->data, &view->data_offset,
+          &view->data_len);
+}
+
+/* ── sensor_msgs/CameraInfo ────────────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_camera_info_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrCameraInfoView *view)
+{
+  CdrReader r, elems;
+  const guint8 *p;
+  gsize off;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  if (!cdr_reader_init (&r, data, len) ||
+      !cdr_read_header (&r, &view->header) ||
+      !cdr_read_u32 (&r, &view->height) ||
+      !cdr_read_u32 (&r, &view->width) ||
+      !cdr_read_string (&r, &view->distortion_model, NULL))
+    return FALSE;
+
+  /* d: sequence<float64> */
+  memset (view->D, 0, sizeof (view->D));
+  if (!cdr_read_sequence (&r, 8, &p, &off, &view->D_len) || !p)
+    return FALSE;
+  elems = cdr_reader_at (&r, off);
+  cdr_read_f64_array (&elems, view->D,
+      MIN (view->D_len, EDGEFIRST_MAX_DISTORTION_COEFFS));
+
+  /* k, r, p: fixed-size float64 arrays (no length prefix) */
+  if (!cdr_read_f64_array (&r, view->K, 9) ||
+      !cdr_read_f64_array (&r, view->R, 9) ||
+      !cdr_read_f64_array (&r, view->P, 12))
+    return FALSE;
+
+  return cdr_read_u32 (&r, &view->binning_x) &&
+      cdr_read_u32 (&r, &view->binning_y) &&
+      cdr_read_u32 (&r, &view->roi_x_offset) &&
+      cdr_read_u32 (&r, &view->roi_y_offset) &&
+      cdr_read_u32 (&r, &view->roi_height) &&
+      cdr_read_u32 (&r, &view->roi_width) &&
+      cdr_read_bool (&r, &view->roi_do_rectify);
+}
+
+/* ── geometry_msgs/TransformStamped ────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_transform_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrTransformView *view)
+{
+  CdrReader r;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  return cdr_reader_init (&r, data, len) &&
+      cdr_read_header (&r, &view->header) &&
+      cdr_read_string (&r, &view->child_frame_id, &view->child_frame_id_len) &&
+      cdr_read_f64_array (&r, view->translation, 3) &&
+      cdr_read_f64_array (&r, view->rotation, 4);
+}
+
+/* ── edgefirst_msgs/DmaBuffer ──────────────────────────────────────── */
+
+gboolean
+edgefirst_cdr_dma_buffer_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrDmaBufferView *view)
+{
+  CdrReader r;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  return cdr_reader_init (&r, data, len) &&
+      cdr_read_header (&r, &view->header) &&
+      cdr_read_u32 (&r, &view->pid) &&
+      cdr_read_i32 (&r, &view->fd) &&
+      cdr_read_u32 (&r, &view->width) &&
+      cdr_read_u32 (&r, &view->height) &&
+      cdr_read_u32 (&r, &view->stride) &&
+      cdr_read_u32 (&r, &view->fourcc) &&
+      cdr_read_u32 (&r, &view->length);
+}
+
+void
+edgefirst_cdr_transform_view_to_data (const EdgefirstCdrTransformView *view,
+    EdgefirstTransformData *transform)
+{
+  g_return_if_fail (view != NULL);
+  g_return_if_fail (transform != NULL);
+
+  memcpy (transform->translation, view->translation,
+      sizeof (transform->translation));
+  memcpy (transform->rotation, view->rotation, sizeof (transform->rotation));
+  g_strlcpy (transform->child_frame_id, view->child_frame_id,
+      EDGEFIRST_FRAME_ID_MAX_LEN);
+  g_strlcpy (transform->parent_frame_id, view->header.frame_id,
+      EDGEFIRST_FRAME_ID_MAX_LEN);
+  transform->timestamp_ns = edgefirst_cdr_header_get_timestamp_ns (&view->header);
+}
@@ -0,0 +1,404 @@
+/*
+ * EdgeFirst Perception for GStreamer
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_CDR_H__
+#define __EDGEFIRST_CDR_H__
+
+#include <glib.h>
+#include <gst/edgefirst/edgefirst-perception-types.h>
+#include <gst/edgefirst/edgefirstpointcloud2meta.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Zero-allocation CDR "views" of EdgeFirst / ROS2 messages.
+ *
+ * A view is filled in place from a serialized message (including the 4-byte
+ * encapsulation header, little- or big-endian).  Strings and large sequences
+ * are returned as pointers and offsets into the original payload, so the
+ * payload must outlive the view.  Small fixed-size arrays (radar cube shape,
+ * camera matrices) are copied into the view.  Every parse function walks the
+ * whole message with bounds checks and returns FALSE on malformed input.
+ *
+ * The _parse_split() variants accept a message that is not contiguous in
+ * memory: only a linearized head (everything up to the bulk data) and tail
+ * (the trailing scalars) are read, while the bulk sequence in between is
+ * located by offset only.  Its pointer is NULL unless it lies in @head.
+ */
+
+/**
+ * EdgefirstCdrHeader:
+ * @stamp_sec: std_msgs/Header stamp seconds
+ * @stamp_nanosec: std_msgs/Header stamp nanoseconds
+ * @frame_id: NUL-terminated frame id, points into the payload
+ * @frame_id_len: length of @frame_id excluding the terminator
+ *
+ * View of a std_msgs/Header.
+ */
+typedef struct {
+  gint32 stamp_sec;
+  guint32 stamp_nanosec;
+  const gchar *frame_id;
+  guint32 frame_id_len;
+} EdgefirstCdrHeader;
+
+/**
+ * EdgefirstCdrPointCloud2View:
+ * @header: message header
+ * @height: cloud height (1 for unordered clouds)
+ * @width: cloud width
+ * @num_fields: number of PointField entries, see
+ *   edgefirst_cdr_pointcloud2_view_get_fields()
+ * @fields: serialized PointField entries, points into the payload; equal
+ *   bytes mean an equal point layout
+ * @fields_len: length of @fields in bytes
+ * @is_bigendian: point data byte order
+ * @point_step: bytes per point
+ * @row_step: bytes per row
+ * @data: point data, points into the payload; NULL after a split parse when
+ *   the data is not inside the head
+ * @data_offset: offset of @data from the start of the payload
+ * @data_len: length of @data in bytes
+ * @is_dense: TRUE if the cloud has no invalid points
+ *
+ * View of a sensor_msgs/PointCloud2.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  guint32 height;
+  guint32 width;
+  guint32 num_fields;
+  const guint8 *fields;
+  guint32 fields_len;
+  gboolean is_bigendian;
+  guint32 point_step;
+  guint32 row_step;
+  const guint8 *data;
+  gsize data_offset;
+  guint32 data_len;
+  gboolean is_dense;
+
+  /*< private >*/
+  const guint8 *_cdr;
+  gsize _cdr_len;
+  gsize _fields_offset;
+} EdgefirstCdrPointCloud2View;
+
+/**
+ * EdgefirstCdrRadarCubeView:
+ * @header: message header
+ * @timestamp: radar module timestamp
+ * @layout: dimension labels (first EDGEFIRST_RADAR_MAX_DIMS entries)
+ * @layout_len: number of dimension labels on the wire
+ * @shape: dimension sizes (first EDGEFIRST_RADAR_MAX_DIMS entries)
+ * @shape_len: number of dimension sizes on the wire
+ * @scales: per-dimension scales (first EDGEFIRST_RADAR_MAX_DIMS entries)
+ * @scales_len: number of scales on the wire
+ * @cube: int16 cube data in wire byte order, points into the payload; NULL
+ *   after a split parse when the cube is not inside the head
+ * @cube_offset: offset of @cube from the start of the payload
+ * @cube_len: number of int16 elements in @cube
+ * @is_complex: TRUE if the cube holds (real, imaginary) pairs
+ *
+ * View of an edgefirst_msgs/RadarCube.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  guint64 timestamp;
+  guint8 layout[EDGEFIRST_RADAR_MAX_DIMS];
+  guint32 layout_len;
+  guint16 shape[EDGEFIRST_RADAR_MAX_DIMS];
+  guint32 shape_len;
+  gfloat scales[EDGEFIRST_RADAR_MAX_DIMS];
+  guint32 scales_len;
+  const guint8 *cube;
+  gsize cube_offset;
+  guint32 cube_len;
+  gboolean is_complex;
+} EdgefirstCdrRadarCubeView;
+
+/**
+ * EdgefirstCdrImageView:
+ * @header: message header
+ * @height: image height in pixels
+ * @width: image width in pixels
+ * @encoding: NUL-terminated ROS encoding string, points into the payload
+ * @encoding_len: length of @encoding excluding the terminator
+ * @is_bigendian: pixel data byte order
+ * @step: row stride in bytes
+ * @data: pixel data, points into the payload; NULL after a split parse when
+ *   the data is not inside the head
+ * @data_offset: offset of @data from the start of the payload
+ * @data_len: length of @data in bytes
+ *
+ * View of a sensor_msgs/Image.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  guint32 height;
+  guint32 width;
+  const gchar *encoding;
+  guint32 encoding_len;
+  gboolean is_bigendian;
+  guint32 step;
+  const guint8 *data;
+  gsize data_offset;
+  guint32 data_len;
+} EdgefirstCdrImageView;
+
+/**
+ * EdgefirstCdrCameraInfoView:
+ * @header: message header
+ * @height: calibrated image height
+ * @width: calibrated image width
+ * @distortion_model: NUL-terminated model name, points into the payload
+ * @D: distortion coefficients (first EDGEFIRST_MAX_DISTORTION_COEFFS entries)
+ * @D_len: number of distortion coefficients on the wire
+ * @K: intrinsic matrix (3x3, row-major)
+ * @R: rectification matrix (3x3, row-major)
+ * @P: projection matrix (3x4, row-major)
+ * @binning_x: horizontal binning
+ * @binning_y: vertical binning
+ * @roi_x_offset: region of interest left edge
+ * @roi_y_offset: region of interest top edge
+ * @roi_height: region of interest height
+ * @roi_width: region of interest width
+ * @roi_do_rectify: region of interest rectification flag
+ *
+ * View of a sensor_msgs/CameraInfo.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  guint32 height;
+  guint32 width;
+  const gchar *distortion_model;
+  gdouble D[EDGEFIRST_MAX_DISTORTION_COEFFS];
+  guint32 D_len;
+  gdouble K[9];
+  gdouble R[9];
+  gdouble P[12];
+  guint32 binning_x;
+  guint32 binning_y;
+  guint32 roi_x_offset;
+  guint32 roi_y_offset;
+  guint32 roi_height;
+  guint32 roi_width;
+  gboolean roi_do_rectify;
+} EdgefirstCdrCameraInfoView;
+
+/**
+ * EdgefirstCdrTransformView:
+ * @header: message header (frame_id is the parent frame)
+ * @child_frame_id: NUL-terminated child frame, points into the payload
+ * @child_frame_id_len: length of @child_frame_id excluding the terminator
+ * @translation: translation (x, y, z) in meters
+ * @rotation: rotation quaternion (x, y, z, w)
+ *
+ * View of a geometry_msgs/TransformStamped.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  const gchar *child_frame_id;
+  guint32 child_frame_id_len;
+  gdouble translation[3];
+  gdouble rotation[4];
+} EdgefirstCdrTransformView;
+
+/**
+ * EdgefirstCdrDmaBufferView:
+ * @header: message header
+ * @pid: process that owns @fd
+ * @fd: DMA-BUF file descriptor, valid in process @pid
+ * @width: image width in pixels
+ * @height: image height in pixels
+ * @stride: row stride in bytes
+ * @fourcc: V4L2 pixel format
+ * @length: size of the DMA-BUF in bytes
+ *
+ * View of an edgefirst_msgs/DmaBuffer.
+ */
+typedef struct {
+  EdgefirstCdrHeader header;
+  guint32 pid;
+  gint32 fd;
+  guint32 width;
+  guint32 height;
+  guint32 stride;
+  guint32 fourcc;
+  guint32 length;
+} EdgefirstCdrDmaBufferView;
+
+/**
+ * edgefirst_cdr_header_parse:
+ * @data: serialized message
+ * @len: length of @data
+ * @header: (out caller-allocates): header view to fill
+ *
+ * Parses only the leading std_msgs/Header of any stamped message.
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_header_parse (const guint8 *data, gsize len,
+    EdgefirstCdrHeader *header);
+
+/**
+ * edgefirst_cdr_header_get_timestamp_ns:
+ * @header: a #EdgefirstCdrHeader
+ *
+ * Returns: the header stamp in nanoseconds
+ */
+guint64 edgefirst_cdr_header_get_timestamp_ns (const EdgefirstCdrHeader *header);
+
+/**
+ * edgefirst_cdr_pointcloud2_view_parse:
+ * @data: serialized sensor_msgs/PointCloud2
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_pointcloud2_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrPointCloud2View *view);
+
+/**
+ * edgefirst_cdr_pointcloud2_view_parse_split:
+ * @head: the first @head_len bytes of the serialized message
+ * @head_len: length of @head, at least up to the point data length
+ * @tail: (nullable): the last @tail_len bytes of the message
+ * @tail_len: length of @tail
+ * @total_len: length of the whole message
+ * @view: (out caller-allocates): view to fill
+ *
+ * Like edgefirst_cdr_pointcloud2_view_parse() for a message split across
+ * several buffers.  @tail must hold the trailing is_dense
+ * flag.
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_pointcloud2_view_parse_split (const guint8 *head,
+    gsize head_len, const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrPointCloud2View *view);
+
+/**
+ * edgefirst_cdr_pointcloud2_view_get_fields:
+ * @view: a parsed #EdgefirstCdrPointCloud2View
+ * @out_fields: (out caller-allocates): array to fill
+ * @max_fields: capacity of @out_fields
+ *
+ * Decodes the PointField sequence into caller-provided descriptors.
+ *
+ * Returns: number of fields written
+ */
+guint edgefirst_cdr_pointcloud2_view_get_fields (
+    const EdgefirstCdrPointCloud2View *view,
+    EdgefirstPointFieldDesc *out_fields, guint max_fields);
+
+/**
+ * edgefirst_cdr_radar_cube_view_parse:
+ * @data: serialized edgefirst_msgs/RadarCube
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_radar_cube_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrRadarCubeView *view);
+
+/**
+ * edgefirst_cdr_radar_cube_view_parse_split:
+ * @head: the first @head_len bytes of the serialized message
+ * @head_len: length of @head, at least up to the cube length
+ * @tail: (nullable): the last @tail_len bytes of the message
+ * @tail_len: length of @tail
+ * @total_len: length of the whole message
+ * @view: (out caller-allocates): view to fill
+ *
+ * Like edgefirst_cdr_radar_cube_view_parse() for a message split across
+ * several buffers.  @tail must hold the trailing is_complex
+ * flag.
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_radar_cube_view_parse_split (const guint8 *head,
+    gsize head_len, const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrRadarCubeView *view);
+
+/**
+ * edgefirst_cdr_image_view_parse:
+ * @data: serialized sensor_msgs/Image
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_image_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrImageView *view);
+
+/**
+ * edgefirst_cdr_image_view_parse_split:
+ * @head: the first @head_len bytes of the serialized message
+ * @head_len: length of @head, at least up to the pixel data length
+ * @tail: (nullable): the last @tail_len bytes of the message
+ * @tail_len: length of @tail
+ * @total_len: length of the whole message
+ * @view: (out caller-allocates): view to fill
+ *
+ * Like edgefirst_cdr_image_view_parse() for a message split across
+ * several buffers.  The pixel data ends the message, so
+ * @tail may be empty.
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_image_view_parse_split (const guint8 *head,
+    gsize head_len, const guint8 *tail, gsize tail_len, gsize total_len,
+    EdgefirstCdrImageView *view);
+
+/**
+ * edgefirst_cdr_camera_info_view_parse:
+ * @data: serialized sensor_msgs/CameraInfo
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_camera_info_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrCameraInfoView *view);
+
+/**
+ * edgefirst_cdr_transform_view_parse:
+ * @data: serialized geometry_msgs/TransformStamped
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_transform_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrTransformView *view);
+
+/**
+ * edgefirst_cdr_dma_buffer_view_parse:
+ * @data: serialized edgefirst_msgs/DmaBuffer
+ * @len: length of @data
+ * @view: (out caller-allocates): view to fill
+ *
+ * Returns: TRUE on success
+ */
+gboolean edgefirst_cdr_dma_buffer_view_parse (const guint8 *data, gsize len,
+    EdgefirstCdrDmaBufferView *view);
+
+/**
+ * edgefirst_cdr_transform_view_to_data:
+ * @view: a parsed #EdgefirstCdrTransformView
+ * @transform: (out caller-allocates): transform to fill
+ *
+ * Copies the transform, frame ids and stamp into @transform.
+ */
+void edgefirst_cdr_transform_view_to_data (const EdgefirstCdrTransformView *view,
+    EdgefirstTransformData *transform);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_CDR_H__ */
@@ -43,7 +43,7 @@ static void
 edgefirst_detect_box_list_finalize (GObject *object)
 {
   EdgeFirstDetectBoxList *self = EDGEFIRST_DETECT_BOX_LIST (object);
-  hal_detect_box_list_free (self->list);
+  g_clear_pointer (&self->list, hal_detect_box_list_free);
   G_OBJECT_CLASS (edgefirst_detect_box_list_parent_class)->finalize (object);
 }
 
@@ -88,6 +88,9 @@ guint
 edgefirst_detect_box_list_get_length (EdgeFirstDetectBoxList *self)
 {
   g_return_val_if_fail (EDGEFIRST_IS_DETECT_BOX_LIST (self), 0);
+  /* A list made with g_object_new() wraps no HAL list and is empty */
+  if (!self->list)
+    return 0;
   return (guint) hal_detect_box_list_len (self->list);
 }
 
@@ -98,7 +101,8 @@ edgefirst_detect_box_list_get (EdgeFirstDetectBoxList *self, guint index)
 
   g_return_val_if_fail (EDGEFIRST_IS_DETECT_BOX_LIST (self), NULL);
 
-  if (hal_detect_box_list_get (self->list, (size_t) index, &hbox) != 0)
+  if (!self->list ||
+      hal_detect_box_list_get (self->list, (size_t) index, &hbox) != 0)
     return NULL;
 
   EdgeFirstDetectBox *box = g_slice_new (EdgeFirstDetectBox);
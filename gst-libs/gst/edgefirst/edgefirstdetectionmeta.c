@@ -0,0 +1,113 @@
+/*
+ * EdgeFirst Perception for GStreamer
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstdetectionmeta.h"
+#include <string.h>
+
+GType
+edgefirst_detection_meta_api_get_type (void)
+{
+  static GType type = 0;
+  static const gchar *tags[] = { NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type = gst_meta_api_type_register ("EdgefirstDetectionMetaAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+static gboolean
+edgefirst_detection_meta_init (GstMeta *meta, gpointer params, GstBuffer *buffer)
+{
+  EdgefirstDetectionMeta *det_meta = (EdgefirstDetectionMeta *) meta;
+
+  det_meta->boxes = NULL;
+  det_meta->input_timestamp = 0;
+  det_meta->model_time_ns = 0;
+  det_meta->frame_id[0] = '\0';
+
+  return TRUE;
+}
+
+static void
+edgefirst_detection_meta_free (GstMeta *meta, GstBuffer *buffer)
+{
+  EdgefirstDetectionMeta *det_meta = (EdgefirstDetectionMeta *) meta;
+
+  g_clear_object (&det_meta->boxes);
+}
+
+static gboolean
+edgefirst_detection_meta_transform (GstBuffer *dest, GstMeta *meta,
+    GstBuffer *buffer, GQuark type, gpointer data)
+{
+  EdgefirstDetectionMeta *src_meta = (EdgefirstDetectionMeta *) meta;
+  EdgefirstDetectionMeta *dest_meta;
+
+  if (GST_META_TRANSFORM_IS_COPY (type)) {
+    /* The box list is immutable, so copies share it */
+    dest_meta = edgefirst_buffer_add_detection_meta (dest, src_meta->boxes);
+    if (!dest_meta)
+      return FALSE;
+
+    dest_meta->input_timestamp = src_meta->input_timestamp;
+    dest_meta->model_time_ns = src_meta->model_time_ns;
+    memcpy (dest_meta->frame_id, src_meta->frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
+
+    return TRUE;
+  }
+
+  return FALSE;
+}
+
+const GstMetaInfo *
+edgefirst_detection_meta_get_info (void)
+{
+  static const GstMetaInfo *info = NULL;
+
+  if (g_once_init_enter (&info)) {
+    const GstMetaInfo *meta_info = gst_meta_register (
+        EDGEFIRST_DETECTION_META_API_TYPE,
+        "EdgefirstDetectionMeta",
+        sizeof (EdgefirstDetectionMeta),
+        edgefirst_detection_meta_init,
+        edgefirst_detection_meta_free,
+        edgefirst_detection_meta_transform);
+    g_once_init_leave (&info, meta_info);
+  }
+  return info;
+}
+
+EdgefirstDetectionMeta *
+edgefirst_buffer_add_detection_meta (GstBuffer *buffer,
+    EdgeFirstDetectBoxList *boxes)
+{
+  EdgefirstDetectionMeta *meta;
+
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (EDGEFIRST_IS_DETECT_BOX_LIST (boxes), NULL);
+
+  meta = (EdgefirstDetectionMeta *) gst_buffer_add_meta (buffer,
+      EDGEFIRST_DETECTION_META_INFO, NULL);
+  if (meta)
+    meta->boxes = g_object_ref (boxes);
+
+  return meta;
+}
+
+EdgefirstDetectionMeta *
+edgefirst_buffer_get_detection_meta (GstBuffer *buffer)
+{
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+
+  return (EdgefirstDetectionMeta *) gst_buffer_get_meta (buffer,
+      EDGEFIRST_DETECTION_META_API_TYPE);
+}
@@ -0,0 +1,69 @@
+/*
+ * EdgeFirst Perception for GStreamer
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_DETECTION_META_H__
+#define __EDGEFIRST_DETECTION_META_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirst-perception-types.h>
+#include <gst/edgefirst/edgefirstdetection.h>
+
+G_BEGIN_DECLS
+
+#define EDGEFIRST_DETECTION_META_API_TYPE (edgefirst_detection_meta_api_get_type())
+#define EDGEFIRST_DETECTION_META_INFO     (edgefirst_detection_meta_get_info())
+
+/**
+ * EdgefirstDetectionMeta:
+ * @meta: Parent GstMeta
+ * @boxes: (transfer full): Detections for this buffer, normalized [0,1]
+ * @input_timestamp: Timestamp of the frame the model ran on, in nanoseconds
+ *   since the Unix epoch, or 0 if unknown
+ * @model_time_ns: Model inference time in nanoseconds, or 0 if unknown
+ * @frame_id: Coordinate frame identifier
+ *
+ * Bounding box detections attached to a buffer.
+ * Compatible with edgefirst_msgs/Detect.
+ */
+typedef struct _EdgefirstDetectionMeta {
+  GstMeta meta;
+
+  EdgeFirstDetectBoxList *boxes;
+
+  guint64 input_timestamp;
+  guint64 model_time_ns;
+
+  gchar frame_id[EDGEFIRST_FRAME_ID_MAX_LEN];
+} EdgefirstDetectionMeta;
+
+GType edgefirst_detection_meta_api_get_type (void);
+const GstMetaInfo *edgefirst_detection_meta_get_info (void);
+
+/**
+ * edgefirst_buffer_add_detection_meta:
+ * @buffer: a #GstBuffer
+ * @boxes: (transfer none): the detections; a reference is taken
+ *
+ * Adds a #EdgefirstDetectionMeta to the buffer.
+ *
+ * Returns: (transfer none): the #EdgefirstDetectionMeta added to @buffer
+ */
+EdgefirstDetectionMeta *edgefirst_buffer_add_detection_meta (GstBuffer *buffer,
+    EdgeFirstDetectBoxList *boxes);
+
+/**
+ * edgefirst_buffer_get_detection_meta:
+ * @buffer: a #GstBuffer
+ *
+ * Gets the #EdgefirstDetectionMeta from the buffer.
+ *
+ * Returns: (transfer none) (nullable): the #EdgefirstDetectionMeta or %NULL
+ */
+EdgefirstDetectionMeta *edgefirst_buffer_get_detection_meta (GstBuffer *buffer);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_DETECTION_META_H__ */
@@ -0,0 +1,141 @@
+/*
+ * EdgeFirst Perception for GStreamer - Fusion Worker Pool
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstfusion-pool.h"
+
+struct _EdgefirstFusionPool {
+  GMutex lock;
+  GCond start_cond;       /* signalled when a job is posted or on free */
+  GCond done_cond;        /* signalled when the last worker leaves a job */
+  GThread **threads;
+  guint n_workers;
+
+  /* Current job, set under lock before generation is bumped */
+  EdgefirstFusionPoolFunc func;
+  gpointer data;
+  guint n_tasks;
+  gint next_task;         /* atomic, next task to claim */
+  guint generation;
+  guint busy;             /* workers that have not finished the job */
+  gboolean stopping;
+};
+
+static void
+pool_drain (EdgefirstFusionPool *pool)
+{
+  guint index;
+
+  while ((index = (guint) g_atomic_int_add (&pool->next_task, 1)) <
+      pool->n_tasks)
+    pool->func (pool->data, index);
+}
+
+static gpointer
+pool_worker_func (gpointer data)
+{
+  EdgefirstFusionPool *pool = data;
+  guint generation = 0;
+
+  g_mutex_lock (&pool->lock);
+  while (TRUE) {
+    while (!pool->stopping && pool->generation == generation)
+      g_cond_wait (&pool->start_cond, &pool->lock);
+    if (pool->stopping)
+      break;
+    generation = pool->generation;
+    g_mutex_unlock (&pool->lock);
+
+    pool_drain (pool);
+
+    g_mutex_lock (&pool->lock);
+    if (--pool->busy == 0)
+      g_cond_signal (&pool->done_cond);
+  }
+  g_mutex_unlock (&pool->lock);
+
+  return NULL;
+}
+
+EdgefirstFusionPool *
+edgefirst_fusion_pool_new (guint n_threads)
+{
+  EdgefirstFusionPool *pool = g_new0 (EdgefirstFusionPool, 1);
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  g_mutex_init (&pool->lock);
+  g_cond_init (&pool->start_cond);
+  g_cond_init (&pool->done_cond);
+
+  /* The caller of run() is the first thread */
+  pool->n_workers = MAX (n_threads, 1) - 1;
+  pool->threads = g_new0 (GThread *, pool->n_workers);
+  for (guint i = 0; i < pool->n_workers; i++)
+    pool->threads[i] = g_thread_new ("fusionpool", pool_worker_func, pool);
+
+  return pool;
+}
+
+void
+edgefirst_fusion_pool_free (EdgefirstFusionPool *pool)
+{
+  if (!pool)
+    return;
+
+  g_mutex_lock (&pool->lock);
+  pool->stopping = TRUE;
+  g_cond_broadcast (&pool->start_cond);
+  g_mutex_unlock (&pool->lock);
+
+  for (guint i = 0; i < pool->n_workers; i++)
+    g_thread_join (pool->threads[i]);
+  g_free (pool->threads);
+
+  g_cond_clear (&pool->done_cond);
+  g_cond_clear (&pool->start_cond);
+  g_mutex_clear (&pool->lock);
+  g_free (pool);
+}
+
+guint
+edgefirst_fusion_pool_get_n_threads (const EdgefirstFusionPool *pool)
+{
+  return pool->n_workers + 1;
+}
+
+void
+edgefirst_fusion_pool_run (EdgefirstFusionPool *pool, guint n_tasks,
+    EdgefirstFusionPoolFunc func, gpointer data)
+{
+  /* Not worth a wake-up */
+  if (pool->n_workers == 0 || n_tasks <= 1) {
+    for (guint i = 0; i < n_tasks; i++)
+      func (data, i);
+    return;
+  }
+
+  g_mutex_lock (&pool->lock);
+  pool->func = func;
+  pool->data = data;
+  pool->n_tasks = n_tasks;
+  g_atomic_int_set (&pool->next_task, 0);
+  pool->busy = pool->n_workers;
+  pool->generation++;
+  g_cond_broadcast (&pool->start_cond);
+  g_mutex_unlock (&pool->lock);
+
+  pool_drain (pool);
+
+  g_mutex_lock (&pool->lock);
+  while (pool->busy > 0)
+    g_cond_wait (&pool->done_cond, &pool->lock);
+  g_mutex_unlock (&pool->lock);
+}
@@ -0,0 +1,75 @@
+/*
+ * EdgeFirst Perception for GStreamer - Fusion Worker Pool
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_FUSION_POOL_H__
+#define __EDGEFIRST_FUSION_POOL_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstFusionPool:
+ *
+ * A fixed set of worker threads that run the tasks of one job at a time.
+ * The threads are started with the pool and sleep between jobs, so a job
+ * costs a wake-up rather than a thread creation.
+ */
+typedef struct _EdgefirstFusionPool EdgefirstFusionPool;
+
+/**
+ * EdgefirstFusionPoolFunc:
+ * @data: the job data given to edgefirst_fusion_pool_run()
+ * @index: task index, from 0 to the task count minus one
+ *
+ * Runs one task.  Tasks of a job run concurrently, so each must only write
+ * state that no other task of the job touches.
+ */
+typedef void (*EdgefirstFusionPoolFunc) (gpointer data, guint index);
+
+/**
+ * edgefirst_fusion_pool_new:
+ * @n_threads: threads working on a job, including the caller of
+ *   edgefirst_fusion_pool_run(); 0 means one per online CPU
+ *
+ * Returns: (transfer full): a new pool
+ */
+EdgefirstFusionPool *edgefirst_fusion_pool_new (guint n_threads);
+
+/**
+ * edgefirst_fusion_pool_free:
+ * @pool: (transfer full): an #EdgefirstFusionPool
+ *
+ * Stops and joins the workers.  No job may be running.
+ */
+void edgefirst_fusion_pool_free (EdgefirstFusionPool *pool);
+
+/**
+ * edgefirst_fusion_pool_get_n_threads:
+ * @pool: an #EdgefirstFusionPool
+ *
+ * Returns: threads working on a job, including the caller
+ */
+guint edgefirst_fusion_pool_get_n_threads (const EdgefirstFusionPool *pool);
+
+/**
+ * edgefirst_fusion_pool_run:
+ * @pool: an #EdgefirstFusionPool
+ * @n_tasks: number of tasks
+ * @func: task function
+ * @data: job data passed to @func
+ *
+ * Runs @func once for every index below @n_tasks and returns when all have
+ * finished.  The calling thread works on the job too.  Threads claim the
+ * next unstarted task as they finish one, so uneven tasks balance out.
+ * Only one thread may run jobs on a pool.
+ */
+void edgefirst_fusion_pool_run (EdgefirstFusionPool *pool, guint n_tasks,
+    EdgefirstFusionPoolFunc func, gpointer data);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_FUSION_POOL_H__ */
@@ -0,0 +1,353 @@
+/*
+ * EdgeFirst Perception for GStreamer - Batched Point Projection
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstfusion-project.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* Points gathered per block; the SoA block stays in L1 */
+#define BLOCK_POINTS 64
+
+/* The SSE2 kernel forms row * width with 16-bit multiplies */
+#define SSE2_MAX_DIMENSION 32767
+
+typedef void (*ProjectFunc) (const EdgefirstFusionProjection *proj,
+    const gfloat *x, const gfloat *y, const gfloat *z, guint n,
+    gint32 *pixels);
+
+void
+edgefirst_fusion_projection_init (EdgefirstFusionProjection *proj,
+    const EdgefirstCameraInfoMeta *camera,
+    const EdgefirstTransformData *transform)
+{
+  gdouble r[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, t[3] = { 0, 0, 0 };
+
+  if (transform) {
+    const gdouble x = transform->rotation[0], y = transform->rotation[1];
+    const gdouble z = transform->rotation[2], w = transform->rotation[3];
+
+    r[0] = 1.0 - 2.0 * (y * y + z * z);
+    r[1] = 2.0 * (x * y - z * w);
+    r[2] = 2.0 * (x * z + y * w);
+    r[3] = 2.0 * (x * y + z * w);
+    r[4] = 1.0 - 2.0 * (x * x + z * z);
+    r[5] = 2.0 * (y * z - x * w);
+    r[6] = 2.0 * (x * z - y * w);
+    r[7] = 2.0 * (y * z + x * w);
+    r[8] = 1.0 - 2.0 * (x * x + y * y);
+    memcpy (t, transform->translation, sizeof (t));
+  }
+
+  /* u·w = fx·x' + cx·z', v·w = fy·y' + cy·z', w = z' */
+  for (guint col = 0; col < 4; col++) {
+    gdouble xc = col < 3 ? r[col] : t[0];
+    gdouble yc = col < 3 ? r[3 + col] : t[1];
+    gdouble zc = col < 3 ? r[6 + col] : t[2];
+
+    proj->m[col] = (gfloat) (camera->K[0] * xc + camera->K[2] * zc);
+    proj->m[4 + col] = (gfloat) (camera->K[4] * yc + camera->K[5] * zc);
+    proj->m[8 + col] = (gfloat) zc;
+  }
+  proj->width = camera->width;
+  proj->height = camera->height;
+}
+
+/* ── Scalar kernel ─────────────────────────────────────────────────── */
+
+/* Rounds like the per-point path it replaces: (gint) (u + 0.5), which
+ * truncates toward zero, so u + 0.5 in (-1, width) is inside. */
+static void
+project_scalar (const EdgefirstFusionProjection *proj, const gfloat *x,
+    const gfloat *y, const gfloat *z, guint n, gint32 *pixels)
+{
+  const gfloat *m = proj->m;
+  const gfloat width = (gfloat) proj->width, height = (gfloat) proj->height;
+
+  for (guint i = 0; i < n; i++) {
+    gfloat w = m[8] * x[i] + m[9] * y[i] + m[10] * z[i] + m[11];
+    gfloat r, u, v;
+
+    if (!(w > 0.0f)) {
+      pixels[i] = -1;
+      continue;
+    }
+
+    r = 1.0f / w;
+    u = (m[0] * x[i] + m[1] * y[i] + m[2] * z[i] + m[3]) * r + 0.5f;
+    v = (m[4] * x[i] + m[5] * y[i] + m[6] * z[i] + m[7]) * r + 0.5f;
+    if (u > -1.0f && u < width && v > -1.0f && v < height)
+      pixels[i] = (gint32) v * (gint32) proj->width + (gint32) u;
+    else
+      pixels[i] = -1;
+  }
+}
+
+/* ── x86 kernels ───────────────────────────────────────────────────── */
+
+#ifdef HAVE_X86_DISPATCH
+__attribute__ ((target ("sse2")))
+static void
+project_sse2 (const EdgefirstFusionProjection *proj, const gfloat *x,
+    const gfloat *y, const gfloat *z, guint n, gint32 *pixels)
+{
+  const gfloat *m = proj->m;
+  const __m128 half = _mm_set1_ps (0.5f), minus_one = _mm_set1_ps (-1.0f);
+  const __m128 two = _mm_set1_ps (2.0f), zero = _mm_setzero_ps ();
+  const __m128 width = _mm_set1_ps ((gfloat) proj->width);
+  const __m128 height = _mm_set1_ps ((gfloat) proj->height);
+  const __m128i stride = _mm_set1_epi32 ((gint32) proj->width);
+  const __m128i none = _mm_set1_epi32 (-1);
+  guint i = 0;
+
+  if (proj->width > SSE2_MAX_DIMENSION || proj->height > SSE2_MAX_DIMENSION)
+    n = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m128 px = _mm_loadu_ps (x + i), py = _mm_loadu_ps (y + i);
+    __m128 pz = _mm_loadu_ps (z + i);
+    __m128 w, r, u, v, valid;
+    __m128i idx;
+
+    w = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[8]), px),
+            _mm_mul_ps (_mm_set1_ps (m[9]), py)),
+        _mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[10]), pz),
+            _mm_set1_ps (m[11])));
+    u = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[0]), px),
+            _mm_mul_ps (_mm_set1_ps (m[1]), py)),
+        _mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[2]), pz),
+            _mm_set1_ps (m[3])));
+    v = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[4]), px),
+            _mm_mul_ps (_mm_set1_ps (m[5]), py)),
+        _mm_add_ps (_mm_mul_ps (_mm_set1_ps (m[6]), pz),
+            _mm_set1_ps (m[7])));
+
+    /* Reciprocal estimate refined by one Newton-Raphson step */
+    r = _mm_rcp_ps (w);
+    r = _mm_mul_ps (r, _mm_sub_ps (two, _mm_mul_ps (w, r)));
+    u = _mm_add_ps (_mm_mul_ps (u, r), half);
+    v = _mm_add_ps (_mm_mul_ps (v, r), half);
+
+    valid = _mm_and_ps (_mm_cmpgt_ps (w, zero),
+        _mm_and_ps (_mm_and_ps (_mm_cmpgt_ps (u, minus_one),
+                _mm_cmplt_ps (u, width)),
+            _mm_and_ps (_mm_cmpgt_ps (v, minus_one),
+                _mm_cmplt_ps (v, height))));
+
+    /* row and width fit in 16 bits, so madd gives row * width */
+    idx = _mm_add_epi32 (_mm_madd_epi16 (_mm_cvttps_epi32 (v), stride),
+        _mm_cvttps_epi32 (u));
+    idx = _mm_or_si128 (_mm_and_si128 (_mm_castps_si128 (valid), idx),
+        _mm_andnot_si128 (_mm_castps_si128 (valid), none));
+    _mm_storeu_si128 ((__m128i *) (pixels + i), idx);
+  }
+
+  project_scalar (proj, x + i, y + i, z + i, n - i, pixels + i);
+}
+
+__attribute__ ((target ("avx2")))
+static void
+project_avx2 (const EdgefirstFusionProjection *proj, const gfloat *x,
+    const gfloat *y, const gfloat *z, guint n, gint32 *pixels)
+{
+  const gfloat *m = proj->m;
+  const __m256 half = _mm256_set1_ps (0.5f);
+  const __m256 minus_one = _mm256_set1_ps (-1.0f);
+  const __m256 two = _mm256_set1_ps (2.0f), zero = _mm256_setzero_ps ();
+  const __m256 width = _mm256_set1_ps ((gfloat) proj->width);
+  const __m256 height = _mm256_set1_ps ((gfloat) proj->height);
+  const __m256i stride = _mm256_set1_epi32 ((gint32) proj->width);
+  const __m256i none = _mm256_set1_epi32 (-1);
+  guint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256 px = _mm256_loadu_ps (x + i), py = _mm256_loadu_ps (y + i);
+    __m256 pz = _mm256_loadu_ps (z + i);
+    __m256 w, r, u, v, valid;
+    __m256i idx;
+
+    w = _mm256_add_ps (_mm256_add_ps (
+            _mm256_mul_ps (_mm256_set1_ps (m[8]), px),
+            _mm256_mul_ps (_mm256_set1_ps (m[9]), py)),
+        _mm256_add_ps (_mm256_mul_ps (_mm256_set1_ps (m[10]), pz),
+            _mm256_set1_ps (m[11])));
+    u = _mm256_add_ps (_mm256_add_ps (
+            _mm256_mul_ps (_mm256_set1_ps (m[0]), px),
+            _mm256_mul_ps (_mm256_set1_ps (m[1]), py)),
+        _mm256_add_ps (_mm256_mul_ps (_mm256_set1_ps (m[2]), pz),
+            _mm256_set1_ps (m[3])));
+    v = _mm256_add_ps (_mm256_add_ps (
+            _mm256_mul_ps (_mm256_set1_ps (m[4]), px),
+            _mm256_mul_ps (_mm256_set1_ps (m[5]), py)),
+        _mm256_add_ps (_mm256_mul_ps (_mm256_set1_ps (m[6]), pz),
+            _mm256_set1_ps (m[7])));
+
+    r = _mm256_rcp_ps (w);
+    r = _mm256_mul_ps (r, _mm256_sub_ps (two, _mm256_mul_ps (w, r)));
+    u = _mm256_add_ps (_mm256_mul_ps (u, r), half);
+    v = _mm256_add_ps (_mm256_mul_ps (v, r), half);
+
+    valid = _mm256_and_ps (_mm256_cmp_ps (w, zero, _CMP_GT_OQ),
+        _mm256_and_ps (_mm256_and_ps (
+                _mm256_cmp_ps (u, minus_one, _CMP_GT_OQ),
+                _mm256_cmp_ps (u, width, _CMP_LT_OQ)),
+            _mm256_and_ps (_mm256_cmp_ps (v, minus_one, _CMP_GT_OQ),
+                _mm256_cmp_ps (v, height, _CMP_LT_OQ))));
+
+    idx = _mm256_add_epi32 (_mm256_mullo_epi32 (_mm256_cvttps_epi32 (v),
+            stride), _mm256_cvttps_epi32 (u));
+    idx = _mm256_blendv_epi8 (none, idx, _mm256_castps_si256 (valid));
+    _mm256_storeu_si256 ((__m256i *) (pixels + i), idx);
+  }
+
+  project_scalar (proj, x + i, y + i, z + i, n - i, pixels + i);
+}
+#endif
+
+/* ── NEON kernel ───────────────────────────────────────────────────── */
+
+#if defined(__ARM_NEON)
+static void
+project_neon (const EdgefirstFusionProjection *proj, const gfloat *x,
+    const gfloat *y, const gfloat *z, guint n, gint32 *pixels)
+{
+  const gfloat *m = proj->m;
+  const float32x4_t half = vdupq_n_f32 (0.5f);
+  const float32x4_t minus_one = vdupq_n_f32 (-1.0f);
+  const float32x4_t width = vdupq_n_f32 ((gfloat) proj->width);
+  const float32x4_t height = vdupq_n_f32 ((gfloat) proj->height);
+  const int32x4_t none = vdupq_n_s32 (-1);
+  guint i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    float32x4_t px = vld1q_f32 (x + i), py = vld1q_f32 (y + i);
+    float32x4_t pz = vld1q_f32 (z + i);
+    float32x4_t w, r, u, v;
+    uint32x4_t valid;
+    int32x4_t idx;
+
+    w = vmlaq_n_f32 (vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m[11]), px, m[8]),
+            py, m[9]), pz, m[10]);
+    u = vmlaq_n_f32 (vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m[3]), px, m[0]),
+            py, m[1]), pz, m[2]);
+    v = vmlaq_n_f32 (vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m[7]), px, m[4]),
+            py, m[5]), pz, m[6]);
+
+    /* Reciprocal estimate refined by two Newton-Raphson steps */
+    r = vrecpeq_f32 (w);
+    r = vmulq_f32 (r, vrecpsq_f32 (w, r));
+    r = vmulq_f32 (r, vrecpsq_f32 (w, r));
+    u = vmlaq_f32 (half, u, r);
+    v = vmlaq_f32 (half, v, r);
+
+    valid = vandq_u32 (vcgtq_f32 (w, vdupq_n_f32 (0.0f)),
+        vandq_u32 (vandq_u32 (vcgtq_f32 (u, minus_one), vcltq_f32 (u, width)),
+            vandq_u32 (vcgtq_f32 (v, minus_one), vcltq_f32 (v, height))));
+
+    idx = vmlaq_n_s32 (vcvtq_s32_f32 (u), vcvtq_s32_f32 (v),
+        (gint32) proj->width);
+    vst1q_s32 (pixels + i, vbslq_s32 (valid, idx, none));
+  }
+
+  project_scalar (proj, x + i, y + i, z + i, n - i, pixels + i);
+}
+#endif
+
+/* ── Dispatch ──────────────────────────────────────────────────────── */
+
+typedef enum {
+  KERNEL_SCALAR = 1,
+  KERNEL_SSE2,
+  KERNEL_AVX2,
+  KERNEL_NEON,
+} Kernel;
+
+static Kernel
+detect_kernel (void)
+{
+  static gsize kernel = 0;
+
+  if (g_once_init_enter (&kernel)) {
+    Kernel best = KERNEL_SCALAR;
+
+#ifdef HAVE_X86_DISPATCH
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      best = KERNEL_AVX2;
+    else if (__builtin_cpu_supports ("sse2"))
+      best = KERNEL_SSE2;
+#elif defined(__ARM_NEON)
+    best = KERNEL_NEON;
+#endif
+    g_once_init_leave (&kernel, best);
+  }
+  return (Kernel) kernel;
+}
+
+static ProjectFunc
+select_kernel (void)
+{
+  switch (detect_kernel ()) {
+#ifdef HAVE_X86_DISPATCH
+    case KERNEL_AVX2:
+      return project_avx2;
+    case KERNEL_SSE2:
+      return project_sse2;
+#endif
+#if defined(__ARM_NEON)
+    case KERNEL_NEON:
+      return project_neon;
+#endif
+    default:
+      return project_scalar;
+  }
+}
+
+void
+edgefirst_fusion_project_points (const EdgefirstFusionProjection *proj,
+    const guint8 *points, gsize point_step, guint x_off, guint y_off,
+    guint z_off, gsize num_points, gint32 *pixels)
+{
+  const ProjectFunc project = select_kernel ();
+  const gboolean packed = y_off == x_off + 4 && z_off == x_off + 8;
+  gfloat x[BLOCK_POINTS], y[BLOCK_POINTS], z[BLOCK_POINTS];
+
+  for (gsize start = 0; start < num_points; start += BLOCK_POINTS) {
+    const guint n = (guint) MIN (num_points - start, BLOCK_POINTS);
+    const guint8 *p = points + start * point_step;
+
+    /* Gather to SoA; packed x, y, z come in with a single load */
+    if (packed) {
+      for (guint i = 0; i < n; i++, p += point_step) {
+        gfloat xyz[3];
+
+        memcpy (xyz, p + x_off, sizeof (xyz));
+        x[i] = xyz[0];
+        y[i] = xyz[1];
+        z[i] = xyz[2];
+      }
+    } else {
+      for (guint i = 0; i < n; i++, p += point_step) {
+        memcpy (&x[i], p + x_off, sizeof (gfloat));
+        memcpy (&y[i], p + y_off, sizeof (gfloat));
+        memcpy (&z[i], p + z_off, sizeof (gfloat));
+      }
+    }
+
+    project (proj, x, y, z, n, pixels + start);
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * EdgeFirst Perception for GStreamer - Batched Point Projection
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_FUSION_PROJECT_H__
+#define __EDGEFIRST_FUSION_PROJECT_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstFusionProjection:
+ * @m: row-major 3x4 matrix taking a cloud point to (u·w, v·w, w)
+ * @width: mask width in pixels
+ * @height: mask height in pixels
+ *
+ * The cloud-to-camera transform and the camera intrinsics folded into one
+ * matrix, so a point is projected with 9 multiply-adds and one reciprocal.
+ */
+typedef struct {
+  gfloat m[12];
+  guint width;
+  guint height;
+} EdgefirstFusionProjection;
+
+/**
+ * edgefirst_fusion_projection_init:
+ * @proj: (out): the projection
+ * @camera: camera intrinsics and mask size
+ * @transform: (nullable): cloud-to-camera transform, %NULL for identity
+ *
+ * Folds @transform and the focal lengths and principal point of @camera
+ * into @proj, as edgefirst_transform_data_apply() followed by
+ * edgefirst_camera_info_meta_project_point() would.
+ */
+void edgefirst_fusion_projection_init (EdgefirstFusionProjection *proj,
+    const EdgefirstCameraInfoMeta *camera,
+    const EdgefirstTransformData *transform);
+
+/**
+ * edgefirst_fusion_project_points:
+ * @proj: a projection from edgefirst_fusion_projection_init()
+ * @points: @num_points points of @point_step bytes
+ * @point_step: bytes per point
+ * @x_off: byte offset of the FLOAT32 x field
+ * @y_off: byte offset of the FLOAT32 y field
+ * @z_off: byte offset of the FLOAT32 z field
+ * @num_points: number of points
+ * @pixels: (out caller-allocates) (array length=num_points): mask offset
+ *   (row * width + column) of each point, or -1 when the point is behind
+ *   the camera or outside the mask
+ *
+ * Projects points to the nearest mask pixel.  Points are gathered into
+ * blocks and projected with the widest SIMD unit of the CPU, selected at
+ * runtime; x, y and z packed as 12 consecutive bytes take a faster gather.
+ */
+void edgefirst_fusion_project_points (const EdgefirstFusionProjection *proj,
+    const guint8 *points, gsize point_step, guint x_off, guint y_off,
+    guint z_off, gsize num_points, gint32 *pixels);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_FUSION_PROJECT_H__ */
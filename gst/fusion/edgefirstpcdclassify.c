@@ -12,6 +12,8 @@
 #endif
 
 #include "edgefirstpcdclassify.h"
+#include "edgefirstfusion-pool.h"
+#include "edgefirstfusion-project.h"
 #include <gst/edgefirst/edgefirst.h>
 #include <gst/video/video.h>
 #include <string.h>
@@ -19,9 +21,19 @@
 GST_DEBUG_CATEGORY_STATIC (edgefirst_pcd_classify_debug);
 #define GST_CAT_DEFAULT edgefirst_pcd_classify_debug
 
+/* Points projected per call into the stack pixel buffer */
+#define PROJECT_BLOCK 256
+
+/* Source bytes per worker chunk, so a chunk and its output stay in cache */
+#define CHUNK_BYTES (64 * 1024)
+
+#define DEFAULT_N_THREADS 1
+#define MAX_N_THREADS 64
+
 enum {
   PROP_0,
   PROP_OUTPUT_MODE,
+  PROP_N_THREADS,
 };
 
 struct _EdgefirstPcdClassify {
@@ -29,6 +41,11 @@ struct _EdgefirstPcdClassify {
 
   /* Properties */
   EdgefirstPcdClassifyOutputMode output_mode;
+  guint n_threads;        /* GST_OBJECT_LOCK */
+
+  /* Workers for n_threads, created on the first frame that needs them */
+  EdgefirstFusionPool *pool;
+  guint pool_threads;     /* n_threads the pool was created for */
 
   /* Pad references */
   GstAggregatorPad *cloud_pad;
@@ -64,6 +81,7 @@ static void edgefirst_pcd_classify_get_property (GObject *object, guint prop_id,
     GValue *value, GParamSpec *pspec);
 static void edgefirst_pcd_classify_finalize (GObject *object);
 
+static gboolean edgefirst_pcd_classify_stop (GstAggregator *agg);
 static GstFlowReturn edgefirst_pcd_classify_aggregate (GstAggregator *agg,
     gboolean timeout);
 
@@ -107,6 +125,12 @@ edgefirst_pcd_classify_class_init (EdgefirstPcdClassifyClass *klass)
           EDGEFIRST_PCD_CLASSIFY_OUTPUT_LABELS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Threads classifying a point cloud (0 = one per CPU)",
+          0, MAX_N_THREADS, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "EdgeFirst Point Cloud Classify",
       "Filter/Video",
@@ -117,6 +141,7 @@ edgefirst_pcd_classify_class_init (EdgefirstPcdClassifyClass *klass)
   gst_element_class_add_static_pad_template (element_class, &mask_sink_template);
   gst_element_class_add_static_pad_template (element_class, &src_template);
 
+  agg_class->stop = edgefirst_pcd_classify_stop;
   agg_class->aggregate = edgefirst_pcd_classify_aggregate;
 
   GST_DEBUG_CATEGORY_INIT (edgefirst_pcd_classify_debug, "edgefirstpcdclassify", 0,
@@ -127,6 +152,9 @@ static void
 edgefirst_pcd_classify_init (EdgefirstPcdClassify *self)
 {
   self->output_mode = EDGEFIRST_PCD_CLASSIFY_OUTPUT_LABELS;
+  self->n_threads = DEFAULT_N_THREADS;
+  self->pool = NULL;
+  self->pool_threads = 0;
   self->cloud_pad = NULL;
   self->mask_pad = NULL;
 }
@@ -138,6 +166,7 @@ edgefirst_pcd_classify_finalize (GObject *object)
 
   gst_clear_object (&self->cloud_pad);
   gst_clear_object (&self->mask_pad);
+  g_clear_pointer (&self->pool, edgefirst_fusion_pool_free);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -152,6 +181,11 @@ edgefirst_pcd_classify_set_property (GObject *object, guint prop_id,
     case PROP_OUTPUT_MODE:
       self->output_mode = g_value_get_enum (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      self->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -168,6 +202,11 @@ edgefirst_pcd_classify_get_property (GObject *object, guint prop_id,
     case PROP_OUTPUT_MODE:
       g_value_set_enum (value, self->output_mode);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint (value, self->n_threads);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -187,6 +226,85 @@ ensure_pad_refs (EdgefirstPcdClassify *self)
   }
 }
 
+static gboolean
+edgefirst_pcd_classify_stop (GstAggregator *agg)
+{
+  EdgefirstPcdClassify *self = EDGEFIRST_PCD_CLASSIFY (agg);
+
+  g_clear_pointer (&self->pool, edgefirst_fusion_pool_free);
+  self->pool_threads = 0;
+
+  if (GST_AGGREGATOR_CLASS (parent_class)->stop)
+    return GST_AGGREGATOR_CLASS (parent_class)->stop (agg);
+  return TRUE;
+}
+
+/* Returns the worker pool for the current n-threads, replacing the pool
+ * when the property changed.  Runs on the aggregator thread only. */
+static EdgefirstFusionPool *
+ensure_pool (EdgefirstPcdClassify *self)
+{
+  guint n_threads;
+
+  GST_OBJECT_LOCK (self);
+  n_threads = self->n_threads;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!self->pool || self->pool_threads != n_threads) {
+    g_clear_pointer (&self->pool, edgefirst_fusion_pool_free);
+    self->pool = edgefirst_fusion_pool_new (n_threads);
+    self->pool_threads = n_threads;
+    GST_INFO_OBJECT (self, "Classifying with %u threads",
+        edgefirst_fusion_pool_get_n_threads (self->pool));
+  }
+
+  return self->pool;
+}
+
+/* One frame of work, split into chunks of chunk_points points */
+typedef struct {
+  EdgefirstFusionProjection proj;
+  const guint8 *src;
+  guint8 *dst;
+  gsize point_step;
+  gsize new_point_step;
+  guint x_off, y_off, z_off;
+  const guint8 *mask;
+  gsize mask_size;
+  guint32 point_count;
+  guint32 chunk_points;
+} ClassifyJob;
+
+/* Classifies one chunk a block at a time: project the block to mask
+ * pixels, then copy each point followed by its label.  A chunk writes only
+ * its own range of the output, so chunks can run in parallel. */
+static void
+classify_chunk (gpointer data, guint index)
+{
+  const ClassifyJob *job = data;
+  const guint32 first = index * job->chunk_points;
+  const guint32 last = MIN (job->point_count - first, job->chunk_points) +
+      first;
+  gint32 pixels[PROJECT_BLOCK];
+
+  for (guint32 start = first; start < last; start += PROJECT_BLOCK) {
+    guint32 n = MIN (last - start, PROJECT_BLOCK);
+    const guint8 *src_point = job->src + (gsize) start * job->point_step;
+    guint8 *dst_point = job->dst + (gsize) start * job->new_point_step;
+
+    edgefirst_fusion_project_points (&job->proj, src_point, job->point_step,
+        job->x_off, job->y_off, job->z_off, n, pixels);
+
+    for (guint32 i = 0; i < n; i++) {
+      memcpy (dst_point, src_point, job->point_step);
+      dst_point[job->point_step] = pixels[i] >= 0 &&
+          (gsize) pixels[i] < job->mask_size ? job->mask[pixels[i]] : 0;
+      src_point += job->point_step;
+      dst_point += job->new_point_step;
+    }
+  }
+}
+
 static GstFlowReturn
 edgefirst_pcd_classify_aggregate (GstAggregator *agg, gboolean timeout)
 {
@@ -328,44 +446,30 @@ edgefirst_pcd_classify_aggregate (GstAggregator *agg, gboolean timeout)
     }
   }
 
-  /* Classify each point */
-  for (guint32 i = 0; i < point_count; i++) {
-    const guint8 *src_point = cloud_map.data + (gsize) i * point_step;
-    guint8 *dst_point = out_map.data + (gsize) i * new_point_step;
-    gfloat fx, fy, fz;
-    gdouble x, y, z, u, v;
-    guint8 label = 0;
-
-    /* Copy original point data */
-    memcpy (dst_point, src_point, point_step);
-
-    /* Read xyz as float */
-    memcpy (&fx, src_point + x_off, sizeof (gfloat));
-    memcpy (&fy, src_point + y_off, sizeof (gfloat));
-    memcpy (&fz, src_point + z_off, sizeof (gfloat));
-
-    x = (gdouble) fx;
-    y = (gdouble) fy;
-    z = (gdouble) fz;
-
-    /* Apply transform if available */
-    if (tf_meta)
-      edgefirst_transform_data_apply (&tf_meta->transform, &x, &y, &z);
-
-    /* Project to image plane */
-    if (edgefirst_camera_info_meta_project_point (cam_meta, x, y, z, &u, &v)) {
-      gint px = (gint) (u + 0.5);
-      gint py = (gint) (v + 0.5);
-
-      if (px >= 0 && px < (gint) cam_meta->width &&
-          py >= 0 && py < (gint) cam_meta->height) {
-        gsize mask_offset = (gsize) py * cam_meta->width + (gsize) px;
-        if (mask_offset < mask_map.size)
-          label = mask_map.data[mask_offset];
-      }
-    }
-
-    dst_point[point_step] = label;
+  /* Classify, spreading cache-sized chunks over the worker pool */
+  {
+    ClassifyJob job;
+    guint n_chunks;
+
+    edgefirst_fusion_projection_init (&job.proj, cam_meta,
+        tf_meta ? &tf_meta->transform : NULL);
+    job.src = cloud_map.data;
+    job.dst = out_map.data;
+    job.point_step = point_step;
+    job.new_point_step = new_point_step;
+    job.x_off = x_off;
+    job.y_off = y_off;
+    job.z_off = z_off;
+    job.mask = mask_map.data;
+    job.mask_size = mask_map.size;
+    job.point_count = point_count;
+    job.chunk_points = MAX (CHUNK_BYTES / MAX (point_step, 1) /
+        PROJECT_BLOCK, 1) * PROJECT_BLOCK;
+
+    n_chunks = point_count / job.chunk_points +
+        (point_count % job.chunk_points != 0);
+    edgefirst_fusion_pool_run (ensure_pool (self), n_chunks, classify_chunk,
+        &job);
   }
 
   gst_buffer_unmap (cloud_buf, &cloud_map);
@@ -12,6 +12,7 @@
 #endif
 
 #include "edgefirstoverlay.h"
+#include <gst/edgefirst/edgefirstdetectionmeta.h>
 
 #include <gst/video/video.h>
 #include <gst/allocators/gstdmabuf.h>
@@ -57,6 +58,7 @@ enum {
   PROP_CLASS_COLORS,
   PROP_COMPUTE,
   PROP_NORMALIZED,
+  PROP_FRAME_ID,
 };
 
 /* Tri-state for normalized box coordinates */
@@ -165,6 +167,10 @@ struct _EdgefirstOverlay {
    * pre-materialized segs_obj (low-res 160×160 upsampled). */
   struct hal_proto_data  *proto_snap;         /* owned, NULL if det-only */
   GstClockTime           decode_ts;
+  /* Timing of the frame boxes_obj was decoded from, for the detection meta:
+   * wall-clock ns since the Unix epoch, and capture to decoded, 0 = unknown */
+  guint64                boxes_input_ts;
+  guint64                boxes_model_time;
   gboolean               flushing;
   gboolean               normalized;         /* TRUE if decoder outputs [0,1] coords */
 
@@ -206,6 +212,10 @@ struct _EdgefirstOverlay {
   gchar     *class_colors;
   OverlayCompute compute;
   OverlayNormalized normalized_prop;  /* user-facing tri-state property */
+  gchar     *frame_id;
+
+  /* Tensors pad segment, tensors streaming thread only */
+  GstSegment tensor_segment;
 };
 
 /* ── Pad templates ───────────────────────────────────────────────── */
@@ -341,6 +351,12 @@ edgefirst_overlay_class_init (EdgefirstOverlayClass *klass)
           OVERLAY_NORMALIZED_AUTO,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (obj_class, PROP_FRAME_ID,
+      g_param_spec_string ("frame-id", "Frame ID",
+          "frame_id of the attached detection meta. Unset uses the frame_id "
+          "of the video frame's camera info meta, if any",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* new-detection signal */
   signals[SIGNAL_NEW_DETECTION] = g_signal_new ("new-detection",
       G_TYPE_FROM_CLASS (klass),
@@ -387,6 +403,7 @@ edgefirst_overlay_init (EdgefirstOverlay *self)
   self->color_mode            = EDGEFIRST_COLOR_MODE_CLASS;
   self->decode_ts             = GST_CLOCK_TIME_NONE;
   self->dmabuf_allocator      = gst_dmabuf_allocator_new ();
+  gst_segment_init (&self->tensor_segment, GST_FORMAT_TIME);
 }
 
 /* ── finalize, set_property, get_property ────────────────────────── */
@@ -400,6 +417,7 @@ edgefirst_overlay_finalize (GObject *object)
   g_free (self->decoder_version);
   g_free (self->letterbox_str);
   g_free (self->class_colors);
+  g_free (self->frame_id);
   gst_object_unref (self->dmabuf_allocator);
 
   /* HAL and GObjects freed in stop(); clear in case finalize is called early */
@@ -473,6 +491,10 @@ edgefirst_overlay_set_property (GObject *object, guint prop_id,
     case PROP_NORMALIZED:
       self->normalized_prop = (OverlayNormalized) g_value_get_enum (value);
       break;
+    case PROP_FRAME_ID:
+      g_free (self->frame_id);
+      self->frame_id = g_value_dup_string (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -499,6 +521,7 @@ edgefirst_overlay_get_property (GObject *object, guint prop_id,
     case PROP_CLASS_COLORS:       g_value_set_string  (value, self->class_colors);        break;
     case PROP_COMPUTE:            g_value_set_enum    (value, (gint) self->compute);      break;
     case PROP_NORMALIZED:         g_value_set_enum    (value, (gint) self->normalized_prop); break;
+    case PROP_FRAME_ID:           g_value_set_string  (value, self->frame_id);            break;
     default: G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec); break;
   }
 }
@@ -664,8 +687,11 @@ overlay_stop (EdgefirstOverlay *self)
   g_mutex_lock (&self->lock);
   g_clear_object (&self->boxes_obj);
   g_clear_object (&self->segs_obj);
+  self->boxes_input_ts   = 0;
+  self->boxes_model_time = 0;
   if (self->proto_snap) { hal_proto_data_free (self->proto_snap); self->proto_snap = NULL; }
   g_mutex_unlock (&self->lock);
+  gst_segment_init (&self->tensor_segment, GST_FORMAT_TIME);
 
   g_mutex_clear (&self->lock);
   g_cond_clear (&self->decode_cond);
@@ -1613,6 +1639,10 @@ edgefirst_overlay_tensors_event (GstPad *pad G_GNUC_UNUSED,
       gst_event_unref (event);
       return TRUE;
     }
+    case GST_EVENT_SEGMENT:
+      gst_event_copy_segment (event, &self->tensor_segment);
+      gst_event_unref (event);
+      return TRUE;
     case GST_EVENT_EOS:
       /* Tensors EOS: wake up any model-sync waits so they can timeout and
        * emit frames, but do NOT set flushing — the video chain must continue
@@ -1633,6 +1663,7 @@ edgefirst_overlay_tensors_event (GstPad *pad G_GNUC_UNUSED,
       g_mutex_lock (&self->lock);
       self->flushing = FALSE;
       g_mutex_unlock (&self->lock);
+      gst_segment_init (&self->tensor_segment, GST_FORMAT_TIME);
       gst_event_unref (event);
       return TRUE;
     default:
@@ -1700,9 +1731,12 @@ edgefirst_overlay_video_chain (GstPad *pad G_GNUC_UNUSED,
   EdgeFirstDetectBoxList    *boxes_snap = NULL;
   EdgeFirstSegmentationList *segs_snap  = NULL;
   struct hal_proto_data     *proto_draw = NULL;
+  guint64 boxes_input_ts, boxes_model_time;
   {
     if (!self->model_sync) g_mutex_lock (&self->lock);
     boxes_snap = self->boxes_obj ? g_object_ref (self->boxes_obj) : NULL;
+    boxes_input_ts   = self->boxes_input_ts;
+    boxes_model_time = self->boxes_model_time;
     segs_snap  = self->segs_obj  ? g_object_ref (self->segs_obj)  : NULL;
     /* Borrow proto_snap: take ownership temporarily, tensor chain will
      * allocate a new one on next decode. This avoids holding the lock
@@ -1787,11 +1821,11 @@ edgefirst_overlay_video_chain (GstPad *pad G_GNUC_UNUSED,
   if (src_owned)
     hal_tensor_free (src_img);
 
-  g_clear_object (&boxes_snap);
   g_clear_object (&segs_snap);
 
   if (draw_ret != 0) {
     GST_ERROR_OBJECT (self, "HAL draw masks failed (%d)", draw_ret);
+    g_clear_object (&boxes_snap);
     gst_buffer_unref (buf);
     return GST_FLOW_ERROR;
   }
@@ -1855,6 +1889,21 @@ edgefirst_overlay_video_chain (GstPad *pad G_GNUC_UNUSED,
         GST_VIDEO_FORMAT_RGBA, w, h);
   }
 
+  /* The boxes drawn into this frame, for edgefirstzenohpub message-type=detect */
+  if (boxes_snap) {
+    EdgefirstDetectionMeta *dmeta =
+        edgefirst_buffer_add_detection_meta (outbuf, boxes_snap);
+    EdgefirstCameraInfoMeta *cmeta = edgefirst_buffer_get_camera_info_meta (buf);
+
+    dmeta->input_timestamp = boxes_input_ts;
+    dmeta->model_time_ns   = boxes_model_time;
+    if (self->frame_id)
+      g_strlcpy (dmeta->frame_id, self->frame_id, sizeof (dmeta->frame_id));
+    else if (cmeta)
+      g_strlcpy (dmeta->frame_id, cmeta->frame_id, sizeof (dmeta->frame_id));
+    g_object_unref (boxes_snap);
+  }
+
   GST_BUFFER_PTS (outbuf)      = GST_BUFFER_PTS (buf);
   GST_BUFFER_DURATION (outbuf) = GST_BUFFER_DURATION (buf);
 
@@ -1898,6 +1947,46 @@ gst_memory_to_hal_tensor (GstMemory *mem,
 
 /* ── Tensors chain ────────────────────────────────────────────────── */
 
+/* Capture time of @buf in ns since the Unix epoch from its timestamp/x-unix
+ * reference meta, 0 if it has none */
+static guint64
+overlay_unix_timestamp (GstBuffer *buf)
+{
+  static GstStaticCaps unix_caps = GST_STATIC_CAPS ("timestamp/x-unix");
+  GstReferenceTimestampMeta *meta;
+  GstCaps *caps;
+
+  caps = gst_static_caps_get (&unix_caps);
+  meta = gst_buffer_get_reference_timestamp_meta (buf, caps);
+  gst_caps_unref (caps);
+
+  return meta && GST_CLOCK_TIME_IS_VALID (meta->timestamp) ?
+      meta->timestamp : 0;
+}
+
+/* Running time elapsed since the frame @buf was inferred from was captured,
+ * i.e. its preprocessing, inference and decode, or GST_CLOCK_TIME_NONE
+ * without a PTS or clock */
+static GstClockTime
+overlay_tensor_age (EdgefirstOverlay *self, GstBuffer *buf)
+{
+  GstClockTime running, now;
+  GstClock *clock;
+
+  running = gst_segment_to_running_time (&self->tensor_segment,
+      GST_FORMAT_TIME, GST_BUFFER_PTS (buf));
+  if (!GST_CLOCK_TIME_IS_VALID (running))
+    return GST_CLOCK_TIME_NONE;
+
+  clock = gst_element_get_clock (GST_ELEMENT (self));
+  if (!clock)
+    return GST_CLOCK_TIME_NONE;
+  now = gst_clock_get_time (clock) - gst_element_get_base_time (GST_ELEMENT (self));
+  gst_object_unref (clock);
+
+  return now > running ? now - running : 0;
+}
+
 static GstFlowReturn
 edgefirst_overlay_tensors_chain (GstPad *pad G_GNUC_UNUSED,
     GstObject *parent, GstBuffer *buf)
@@ -2018,12 +2107,20 @@ edgefirst_overlay_tensors_chain (GstPad *pad G_GNUC_UNUSED,
   EdgeFirstSegmentationList *segs_obj  = new_segs
       ? edgefirst_segmentation_list_new (new_segs) : NULL;
 
+  /* ── Timing of the frame the model ran on ─────────────────────── */
+  GstClockTime age = overlay_tensor_age (self, buf);
+  guint64 input_ts = overlay_unix_timestamp (buf);
+  if (input_ts == 0 && GST_CLOCK_TIME_IS_VALID (age))
+    input_ts = (guint64) g_get_real_time () * GST_USECOND - age;
+
   /* ── Update stored state under lock ─────────────────────────────── */
   g_mutex_lock (&self->lock);
   g_clear_object (&self->boxes_obj);
   g_clear_object (&self->segs_obj);
   self->boxes_obj = g_object_ref (boxes_obj);
   self->segs_obj  = segs_obj ? g_object_ref (segs_obj) : NULL;
+  self->boxes_input_ts   = input_ts;
+  self->boxes_model_time = GST_CLOCK_TIME_IS_VALID (age) ? age : 0;
 
   /* Proto was consumed above by materialize_masks; proto_snap stays NULL
    * so the video chain always takes the draw_decoded_masks path. */
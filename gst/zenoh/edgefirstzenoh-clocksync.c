@@ -0,0 +1,129 @@
+/*
+ * EdgeFirst Perception for GStreamer - Sensor Clock Synchronization
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-clocksync.h"
+#include <string.h>
+
+/* Samples per envelope window */
+#define WINDOW_SAMPLES 32
+
+/* Shortest stamp span between window minima used for a drift estimate */
+#define DRIFT_MIN_SPAN (2 * GST_SECOND)
+
+/* Weight of a new drift estimate, as 1/N */
+#define DRIFT_SMOOTHING 4
+
+/* Crystal oscillators stay well within this */
+#define DRIFT_MAX 1e-3
+
+/* A stamp this far off the envelope restarts the estimate */
+#define RESYNC_THRESHOLD GST_SECOND
+
+/* Latency peak decay per sample, as 1/N of the excess */
+#define LATENCY_DECAY 64
+
+static void
+clock_sync_start (EdgefirstZenohClockSync *sync, GstClockTime stamp,
+    gint64 delay)
+{
+  memset (sync, 0, sizeof (*sync));
+  sync->valid = TRUE;
+  sync->ref_stamp = stamp;
+  sync->offset = delay;
+  sync->last_stamp = stamp;
+}
+
+void
+edgefirst_zenoh_clock_sync_reset (EdgefirstZenohClockSync *sync)
+{
+  memset (sync, 0, sizeof (*sync));
+}
+
+static void
+clock_sync_close_window (EdgefirstZenohClockSync *sync)
+{
+  if (sync->have_prev &&
+      sync->window_stamp < sync->prev_stamp + DRIFT_MIN_SPAN) {
+    /* Too close to measure a slope; keep the older minimum */
+  } else {
+    if (sync->have_prev) {
+      gdouble slope = (gdouble) (sync->window_min - sync->prev_min) /
+          (gdouble) (sync->window_stamp - sync->prev_stamp);
+
+      sync->drift += (slope - sync->drift) / DRIFT_SMOOTHING;
+      sync->drift = CLAMP (sync->drift, -DRIFT_MAX, DRIFT_MAX);
+    }
+    sync->prev_min = sync->window_min;
+    sync->prev_stamp = sync->window_stamp;
+    sync->have_prev = TRUE;
+  }
+
+  /* Re-anchor on the window minimum, so the envelope can also rise */
+  sync->ref_stamp = sync->window_stamp;
+  sync->offset = sync->window_min;
+  sync->window_count = 0;
+}
+
+GstClockTime
+edgefirst_zenoh_clock_sync_update (EdgefirstZenohClockSync *sync,
+    GstClockTime stamp, GstClockTime arrival)
+{
+  gint64 delay = (gint64) arrival - (gint64) stamp;
+  gint64 envelope, excess;
+
+  if (!sync->valid || stamp + RESYNC_THRESHOLD < sync->last_stamp) {
+    clock_sync_start (sync, stamp, delay);
+    return arrival;
+  }
+
+  envelope = sync->offset +
+      (gint64) (sync->drift * (gdouble) ((gint64) stamp -
+          (gint64) sync->ref_stamp));
+  excess = delay - envelope;
+  if (excess > (gint64) RESYNC_THRESHOLD ||
+      excess < -(gint64) RESYNC_THRESHOLD) {
+    clock_sync_start (sync, stamp, delay);
+    return arrival;
+  }
+  sync->last_stamp = stamp;
+
+  /* Nothing arrives early: a delay below the envelope moves it down */
+  if (excess < 0) {
+    sync->offset += excess;
+    envelope = delay;
+    excess = 0;
+  }
+
+  if (excess > (gint64) sync->latency)
+    sync->latency = excess;
+  else
+    sync->latency -= (sync->latency - excess) / LATENCY_DECAY;
+
+  if (sync->window_count == 0 || delay < sync->window_min) {
+    sync->window_min = delay;
+    sync->window_stamp = stamp;
+  }
+  if (++sync->window_count >= WINDOW_SAMPLES)
+    clock_sync_close_window (sync);
+
+  return (GstClockTime) MAX ((gint64) stamp + envelope, 0);
+}
+
+GstClockTime
+edgefirst_zenoh_clock_sync_get_latency (const EdgefirstZenohClockSync *sync)
+{
+  return sync->latency;
+}
+
+gdouble
+edgefirst_zenoh_clock_sync_get_drift (const EdgefirstZenohClockSync *sync)
+{
+  return sync->drift;
+}
@@ -0,0 +1,89 @@
+/*
+ * EdgeFirst Perception for GStreamer - Sensor Clock Synchronization
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_CLOCKSYNC_H__
+#define __EDGEFIRST_ZENOH_CLOCKSYNC_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstZenohClockSync:
+ *
+ * Maps the header stamps of one sensor onto the pipeline clock.
+ *
+ * The delay between a stamp and its arrival is the clock offset plus a
+ * transport delay that only ever adds.  The estimator follows the lower
+ * envelope of that delay, a line whose slope is the drift between the two
+ * clocks.  A sample arriving below the line moves it down at once.  Every
+ * window of samples, the line is re-anchored on the window minimum, and
+ * the slope between successive minima updates the drift.  Jitter thus
+ * never enters the mapping.
+ *
+ * How far arrivals lag the envelope is tracked as a slowly decaying peak,
+ * which is the latency the subscriber reports.
+ */
+typedef struct {
+  /*< private >*/
+  gboolean valid;
+  GstClockTime ref_stamp;
+  gint64 offset;          /* envelope of arrival - stamp at ref_stamp */
+  gdouble drift;          /* envelope slope, ns per ns */
+  GstClockTime last_stamp;
+  guint window_count;
+  gint64 window_min;
+  GstClockTime window_stamp;
+  gboolean have_prev;
+  gint64 prev_min;
+  GstClockTime prev_stamp;
+  GstClockTime latency;
+} EdgefirstZenohClockSync;
+
+/**
+ * edgefirst_zenoh_clock_sync_reset:
+ * @sync: an #EdgefirstZenohClockSync
+ *
+ * Forgets all samples.  The next one starts a new estimate.
+ */
+void edgefirst_zenoh_clock_sync_reset (EdgefirstZenohClockSync *sync);
+
+/**
+ * edgefirst_zenoh_clock_sync_update:
+ * @sync: an #EdgefirstZenohClockSync
+ * @stamp: sensor header stamp in nanoseconds
+ * @arrival: clock time at which the sample arrived
+ *
+ * Adds a sample to the estimate.  A stamp that jumps by more than a second
+ * against the estimate (sensor restart, replay) restarts it.
+ *
+ * Returns: @stamp on the clock of @arrival
+ */
+GstClockTime edgefirst_zenoh_clock_sync_update (EdgefirstZenohClockSync *sync,
+    GstClockTime stamp, GstClockTime arrival);
+
+/**
+ * edgefirst_zenoh_clock_sync_get_latency:
+ * @sync: an #EdgefirstZenohClockSync
+ *
+ * Returns: how far arrivals recently lagged their mapped stamp
+ */
+GstClockTime edgefirst_zenoh_clock_sync_get_latency (
+    const EdgefirstZenohClockSync *sync);
+
+/**
+ * edgefirst_zenoh_clock_sync_get_drift:
+ * @sync: an #EdgefirstZenohClockSync
+ *
+ * Returns: estimated rate of the pipeline clock against the sensor clock,
+ *   minus one (e.g. 1e-4 when the pipeline clock runs 100 ppm fast)
+ */
+gdouble edgefirst_zenoh_clock_sync_get_drift (
+    const EdgefirstZenohClockSync *sync);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_CLOCKSYNC_H__ */
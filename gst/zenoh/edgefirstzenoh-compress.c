@@ -0,0 +1,399 @@
+/*
+ * EdgeFirst Perception for GStreamer - Point Cloud Compression
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-compress.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef HAVE_LZ4
+#define HAVE_LZ4 0
+#endif
+#ifndef HAVE_ZSTD
+#define HAVE_ZSTD 0
+#endif
+
+#if HAVE_LZ4
+#include <lz4frame.h>
+#endif
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#define ATTACHMENT_KEY "edgefirst-compression"
+
+/* zstd level; higher levels cost more CPU than the links we target save */
+#define ZSTD_LEVEL 3
+
+/* Quantized value standing for a non-finite coordinate */
+#define QUANT_NAN G_MININT32
+
+struct _EdgefirstZenohCodec {
+  /* Decompression in progress */
+  EdgefirstZenohPubCompression compression;
+  guint8 *dst;
+  gsize dst_len;
+  gsize written;
+  gboolean complete;
+  gboolean failed;
+
+#if HAVE_LZ4
+  LZ4F_dctx *lz4_dctx;
+#endif
+#if HAVE_ZSTD
+  ZSTD_CCtx *zstd_cctx;
+  ZSTD_DCtx *zstd_dctx;
+#endif
+};
+
+static const struct {
+  EdgefirstZenohPubCompression compression;
+  const gchar *name;
+} codec_names[] = {
+  { EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4, "lz4" },
+  { EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD, "zstd" },
+  { EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD, "quantized-zstd" },
+};
+
+gboolean
+edgefirst_zenoh_compression_available (EdgefirstZenohPubCompression codec)
+{
+  switch (codec) {
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE:
+      return TRUE;
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4:
+      return HAVE_LZ4;
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD:
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD:
+      return HAVE_ZSTD;
+  }
+  return FALSE;
+}
+
+/* ── Attachment ────────────────────────────────────────────────────── */
+
+gchar *
+edgefirst_zenoh_compression_to_attachment (
+    const EdgefirstZenohCompressionInfo *info)
+{
+  gchar precision[G_ASCII_DTOSTR_BUF_SIZE];
+  const gchar *name = NULL;
+
+  for (guint i = 0; i < G_N_ELEMENTS (codec_names); i++)
+    if (codec_names[i].compression == info->codec)
+      name = codec_names[i].name;
+  g_return_val_if_fail (name != NULL, NULL);
+
+  if (info->codec != EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD)
+    return g_strdup_printf (ATTACHMENT_KEY "=%s;size=%" G_GSIZE_FORMAT,
+        name, info->size);
+
+  g_ascii_dtostr (precision, sizeof (precision), info->precision);
+  return g_strdup_printf (ATTACHMENT_KEY "=%s;size=%" G_GSIZE_FORMAT
+      ";precision=%s", name, info->size, precision);
+}
+
+gboolean
+edgefirst_zenoh_compression_from_attachment (const gchar *str, gsize len,
+    EdgefirstZenohCompressionInfo *info)
+{
+  gchar buf[128];
+  gchar **pairs;
+  gboolean have_codec = FALSE, have_size = FALSE;
+
+  if (!str || len == 0 || len >= sizeof (buf) ||
+      !g_str_has_prefix (str, ATTACHMENT_KEY "="))
+    return FALSE;
+
+  memcpy (buf, str, len);
+  buf[len] = '\0';
+
+  info->codec = EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE;
+  info->size = 0;
+  info->precision = 1.0f;
+
+  pairs = g_strsplit (buf, ";", -1);
+  for (guint i = 0; pairs[i]; i++) {
+    gchar *value = strchr (pairs[i], '=');
+
+    if (!value)
+      continue;
+    *value++ = '\0';
+
+    if (strcmp (pairs[i], ATTACHMENT_KEY) == 0) {
+      for (guint j = 0; j < G_N_ELEMENTS (codec_names); j++) {
+        if (strcmp (value, codec_names[j].name) == 0) {
+          info->codec = codec_names[j].compression;
+          have_codec = TRUE;
+        }
+      }
+    } else if (strcmp (pairs[i], "size") == 0) {
+      info->size = (gsize) g_ascii_strtoull (value, NULL, 10);
+      have_size = TRUE;
+    } else if (strcmp (pairs[i], "precision") == 0) {
+      info->precision = (gfloat) g_ascii_strtod (value, NULL);
+    }
+  }
+  g_strfreev (pairs);
+
+  return have_codec && have_size && info->precision > 0.0f;
+}
+
+/* ── XYZ quantization ──────────────────────────────────────────────── */
+
+gboolean
+edgefirst_zenoh_find_xyz (const EdgefirstPointFieldDesc *fields,
+    guint num_fields, guint offsets[3])
+{
+  static const gchar *const names[3] = { "x", "y", "z" };
+  guint found = 0;
+
+  for (guint axis = 0; axis < 3; axis++) {
+    for (guint i = 0; i < num_fields; i++) {
+      if (strcmp (fields[i].name, names[axis]) == 0 &&
+          fields[i].datatype == EDGEFIRST_POINT_FIELD_FLOAT32 &&
+          fields[i].count == 1) {
+        offsets[axis] = fields[i].offset;
+        found++;
+        break;
+      }
+    }
+  }
+
+  return found == 3;
+}
+
+void
+edgefirst_zenoh_quantize_xyz (guint8 *dst, const guint8 *src,
+    gsize num_points, guint point_step, const guint offsets[3],
+    gfloat precision)
+{
+  const gfloat scale = 1000.0f / precision;
+
+  memcpy (dst, src, num_points * point_step);
+
+  for (gsize i = 0; i < num_points; i++) {
+    guint8 *point = dst + i * point_step;
+
+    for (guint axis = 0; axis < 3; axis++) {
+      gfloat v;
+      gint32 q;
+
+      memcpy (&v, point + offsets[axis], sizeof (v));
+      v *= scale;
+      if (!isfinite (v))
+        q = QUANT_NAN;
+      else if (v >= (gfloat) G_MAXINT32)
+        q = G_MAXINT32;
+      else if (v <= (gfloat) (G_MININT32 + 1))
+        q = G_MININT32 + 1;
+      else
+        q = (gint32) lrintf (v);
+      memcpy (point + offsets[axis], &q, sizeof (q));
+    }
+  }
+}
+
+void
+edgefirst_zenoh_dequantize_xyz (guint8 *data, gsize num_points,
+    guint point_step, const guint offsets[3], gfloat precision)
+{
+  const gfloat scale = precision / 1000.0f;
+
+  for (gsize i = 0; i < num_points; i++) {
+    guint8 *point = data + i * point_step;
+
+    for (guint axis = 0; axis < 3; axis++) {
+      gint32 q;
+      gfloat v;
+
+      memcpy (&q, point + offsets[axis], sizeof (q));
+      v = q == QUANT_NAN ? NAN : (gfloat) q * scale;
+      memcpy (point + offsets[axis], &v, sizeof (v));
+    }
+  }
+}
+
+/* ── Codec ─────────────────────────────────────────────────────────── */
+
+EdgefirstZenohCodec *
+edgefirst_zenoh_codec_new (void)
+{
+  return g_new0 (EdgefirstZenohCodec, 1);
+}
+
+void
+edgefirst_zenoh_codec_free (EdgefirstZenohCodec *codec)
+{
+  if (!codec)
+    return;
+
+#if HAVE_LZ4
+  if (codec->lz4_dctx)
+    LZ4F_freeDecompressionContext (codec->lz4_dctx);
+#endif
+#if HAVE_ZSTD
+  ZSTD_freeCCtx (codec->zstd_cctx);
+  ZSTD_freeDCtx (codec->zstd_dctx);
+#endif
+  g_free (codec);
+}
+
+guint8 *
+edgefirst_zenoh_codec_compress (EdgefirstZenohCodec *codec,
+    EdgefirstZenohPubCompression compression, const guint8 *src, gsize len,
+    gsize *out_len)
+{
+  guint8 *dst = NULL;
+  gsize n = 0;
+
+  switch (compression) {
+#if HAVE_LZ4
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4:{
+      LZ4F_preferences_t prefs;
+
+      memset (&prefs, 0, sizeof (prefs));
+      prefs.frameInfo.contentSize = len;
+      dst = g_malloc (LZ4F_compressFrameBound (len, &prefs));
+      n = LZ4F_compressFrame (dst, LZ4F_compressFrameBound (len, &prefs),
+          src, len, &prefs);
+      if (LZ4F_isError (n))
+        g_clear_pointer (&dst, g_free);
+      break;
+    }
+#endif
+#if HAVE_ZSTD
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD:
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD:
+      if (!codec->zstd_cctx)
+        codec->zstd_cctx = ZSTD_createCCtx ();
+      dst = g_malloc (ZSTD_compressBound (len));
+      n = ZSTD_compressCCtx (codec->zstd_cctx, dst, ZSTD_compressBound (len),
+          src, len, ZSTD_LEVEL);
+      if (ZSTD_isError (n))
+        g_clear_pointer (&dst, g_free);
+      break;
+#endif
+    default:
+      break;
+  }
+
+  *out_len = dst ? n : 0;
+  return dst;
+}
+
+gboolean
+edgefirst_zenoh_codec_decompress_begin (EdgefirstZenohCodec *codec,
+    EdgefirstZenohPubCompression compression, guint8 *dst, gsize dst_len)
+{
+  codec->compression = compression;
+  codec->dst = dst;
+  codec->dst_len = dst_len;
+  codec->written = 0;
+  codec->complete = FALSE;
+  codec->failed = FALSE;
+
+  switch (compression) {
+#if HAVE_LZ4
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4:
+      if (!codec->lz4_dctx &&
+          LZ4F_isError (LZ4F_createDecompressionContext (&codec->lz4_dctx,
+                  LZ4F_VERSION))) {
+        codec->lz4_dctx = NULL;
+        return FALSE;
+      }
+      LZ4F_resetDecompressionContext (codec->lz4_dctx);
+      return TRUE;
+#endif
+#if HAVE_ZSTD
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD:
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD:
+      if (!codec->zstd_dctx)
+        codec->zstd_dctx = ZSTD_createDCtx ();
+      if (!codec->zstd_dctx)
+        return FALSE;
+      ZSTD_DCtx_reset (codec->zstd_dctx, ZSTD_reset_session_only);
+      return TRUE;
+#endif
+    default:
+      return FALSE;
+  }
+}
+
+gboolean
+edgefirst_zenoh_codec_decompress_feed (EdgefirstZenohCodec *codec,
+    const guint8 *src, gsize len)
+{
+  if (codec->failed)
+    return FALSE;
+
+  /* Trailing bytes after the end of the frame are an error */
+  if (codec->complete) {
+    codec->failed = len > 0;
+    return !codec->failed;
+  }
+
+  switch (codec->compression) {
+#if HAVE_LZ4
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4:
+      while (len > 0 && !codec->complete) {
+        size_t out = codec->dst_len - codec->written;
+        size_t in = len;
+        size_t ret = LZ4F_decompress (codec->lz4_dctx,
+            codec->dst + codec->written, &out, src, &in, NULL);
+
+        if (LZ4F_isError (ret) || (in == 0 && out == 0)) {
+          codec->failed = TRUE;
+          break;
+        }
+        codec->written += out;
+        src += in;
+        len -= in;
+        codec->complete = ret == 0;
+      }
+      if (codec->complete && len > 0)
+        codec->failed = TRUE;
+      break;
+#endif
+#if HAVE_ZSTD
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD:
+    case EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD:{
+      ZSTD_inBuffer in = { src, len, 0 };
+
+      while (in.pos < in.size && !codec->complete) {
+        ZSTD_outBuffer out = { codec->dst, codec->dst_len, codec->written };
+        size_t ret = ZSTD_decompressStream (codec->zstd_dctx, &out, &in);
+
+        if (ZSTD_isError (ret) || (out.pos == codec->written &&
+                out.pos == out.size && ret != 0)) {
+          codec->failed = TRUE;
+          break;
+        }
+        codec->written = out.pos;
+        codec->complete = ret == 0;
+      }
+      if (codec->complete && in.pos < in.size)
+        codec->failed = TRUE;
+      break;
+    }
+#endif
+    default:
+      codec->failed = TRUE;
+      break;
+  }
+
+  return !codec->failed;
+}
+
+gboolean
+edgefirst_zenoh_codec_decompress_end (EdgefirstZenohCodec *codec)
+{
+  return !codec->failed && codec->complete &&
+      codec->written == codec->dst_len;
+}
@@ -0,0 +1,160 @@
+/*
+ * EdgeFirst Perception for GStreamer - Point Cloud Compression
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_COMPRESS_H__
+#define __EDGEFIRST_ZENOH_COMPRESS_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirstpointcloud2meta.h>
+#include "edgefirstzenohpub.h"
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstZenohCompressionInfo:
+ * @codec: codec of the PointCloud2 data sequence
+ * @size: uncompressed length of the data sequence in bytes
+ * @precision: quantization step of x/y/z in millimetres, for
+ *   %EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD
+ *
+ * Describes a compressed PointCloud2.  Only the bytes of the data sequence
+ * are compressed; the rest of the CDR message is unchanged.  The description
+ * travels as the Zenoh attachment of the sample, as text such as
+ * "edgefirst-compression=zstd;size=1966080".
+ */
+typedef struct {
+  EdgefirstZenohPubCompression codec;
+  gsize size;
+  gfloat precision;
+} EdgefirstZenohCompressionInfo;
+
+/**
+ * edgefirst_zenoh_compression_available:
+ * @codec: a compression codec
+ *
+ * Returns: %TRUE if the plugin was built with the library @codec needs
+ */
+gboolean edgefirst_zenoh_compression_available (
+    EdgefirstZenohPubCompression codec);
+
+/**
+ * edgefirst_zenoh_compression_to_attachment:
+ * @info: the compression of a sample
+ *
+ * Returns: (transfer full): the Zenoh attachment text for @info
+ */
+gchar *edgefirst_zenoh_compression_to_attachment (
+    const EdgefirstZenohCompressionInfo *info);
+
+/**
+ * edgefirst_zenoh_compression_from_attachment:
+ * @str: attachment text, not necessarily nul-terminated
+ * @len: length of @str
+ * @info: (out): the compression of the sample
+ *
+ * Returns: %TRUE if @str describes a compressed sample
+ */
+gboolean edgefirst_zenoh_compression_from_attachment (const gchar *str,
+    gsize len, EdgefirstZenohCompressionInfo *info);
+
+/**
+ * edgefirst_zenoh_find_xyz:
+ * @fields: point fields
+ * @num_fields: number of @fields
+ * @offsets: (out caller-allocates) (array fixed-size=3): byte offsets of
+ *   x, y and z within a point
+ *
+ * Returns: %TRUE if @fields has scalar FLOAT32 x, y and z fields
+ */
+gboolean edgefirst_zenoh_find_xyz (const EdgefirstPointFieldDesc *fields,
+    guint num_fields, guint offsets[3]);
+
+/**
+ * edgefirst_zenoh_quantize_xyz:
+ * @dst: output points, same layout as @src
+ * @src: little-endian points
+ * @num_points: number of points
+ * @point_step: bytes per point
+ * @offsets: byte offsets of x, y and z, see edgefirst_zenoh_find_xyz()
+ * @precision: quantization step in millimetres
+ *
+ * Copies @src to @dst with x, y and z (metres) replaced by int32 multiples
+ * of @precision.  Non-finite coordinates are kept as NaN.
+ */
+void edgefirst_zenoh_quantize_xyz (guint8 *dst, const guint8 *src,
+    gsize num_points, guint point_step, const guint offsets[3],
+    gfloat precision);
+
+/**
+ * edgefirst_zenoh_dequantize_xyz:
+ * @data: points written by edgefirst_zenoh_quantize_xyz()
+ * @num_points: number of points
+ * @point_step: bytes per point
+ * @offsets: byte offsets of x, y and z
+ * @precision: quantization step in millimetres
+ *
+ * Converts x, y and z of @data back to FLOAT32 metres, in place.
+ */
+void edgefirst_zenoh_dequantize_xyz (guint8 *data, gsize num_points,
+    guint point_step, const guint offsets[3], gfloat precision);
+
+/**
+ * EdgefirstZenohCodec:
+ *
+ * Compression and decompression contexts, reused across samples.  A codec
+ * is used by one thread at a time.
+ */
+typedef struct _EdgefirstZenohCodec EdgefirstZenohCodec;
+
+EdgefirstZenohCodec *edgefirst_zenoh_codec_new (void);
+void edgefirst_zenoh_codec_free (EdgefirstZenohCodec *codec);
+
+/**
+ * edgefirst_zenoh_codec_compress:
+ * @codec: an #EdgefirstZenohCodec
+ * @compression: lz4 or zstd; quantized-zstd compresses with zstd
+ * @src: bytes to compress
+ * @len: length of @src
+ * @out_len: (out): length of the returned block
+ *
+ * Returns: (transfer full) (nullable): the compressed block, free with
+ *   g_free(), or %NULL on error
+ */
+guint8 *edgefirst_zenoh_codec_compress (EdgefirstZenohCodec *codec,
+    EdgefirstZenohPubCompression compression, const guint8 *src, gsize len,
+    gsize *out_len);
+
+/**
+ * edgefirst_zenoh_codec_decompress_begin:
+ * @codec: an #EdgefirstZenohCodec
+ * @compression: codec of the block
+ * @dst: output, at least @dst_len bytes
+ * @dst_len: uncompressed length
+ *
+ * Starts decompressing a block that is then passed in pieces to
+ * edgefirst_zenoh_codec_decompress_feed(), so a payload received in
+ * several slices needs no linear copy.
+ *
+ * Returns: %FALSE if @compression is not available
+ */
+gboolean edgefirst_zenoh_codec_decompress_begin (EdgefirstZenohCodec *codec,
+    EdgefirstZenohPubCompression compression, guint8 *dst, gsize dst_len);
+
+gboolean edgefirst_zenoh_codec_decompress_feed (EdgefirstZenohCodec *codec,
+    const guint8 *src, gsize len);
+
+/**
+ * edgefirst_zenoh_codec_decompress_end:
+ * @codec: an #EdgefirstZenohCodec
+ *
+ * Returns: %TRUE if the block was complete and filled exactly the
+ *   @dst_len bytes given to edgefirst_zenoh_codec_decompress_begin()
+ */
+gboolean edgefirst_zenoh_codec_decompress_end (EdgefirstZenohCodec *codec);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_COMPRESS_H__ */
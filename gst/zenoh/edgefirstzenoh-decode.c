@@ -0,0 +1,1199 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Sample Decoder
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-decode.h"
+#include <gst/allocators/gstdmabuf.h>
+#include <unistd.h>
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC (edgefirst_zenoh_decode_debug);
+#define GST_CAT_DEFAULT edgefirst_zenoh_decode_debug
+
+/* Output pool buffers are allocated in size classes so that small payload
+ * size changes (e.g. varying point counts) do not replace the pool. */
+#define POOL_SIZE_CLASS_MAX (1024 * 1024)
+#define POOL_MIN_BUFFERS 2
+
+/* Multi-slice payloads are parsed from a linearized head and tail only.
+ * The head covers the CDR header up to the bulk sequence length of every
+ * supported message; the tail covers the flags after the bulk data. */
+#define PAYLOAD_HEAD_MAX 4096
+#define PAYLOAD_TAIL_MAX 16
+
+/* Largest decompressed point cloud accepted, far above any sensor's */
+#define DECOMPRESSED_MAX (256 * 1024 * 1024)
+
+/* One contiguous slice of a received payload */
+typedef struct {
+  const uint8_t *data;
+  size_t len;
+} EdgefirstPayloadSlice;
+
+/* A received payload as a list of slices plus the linearized head and tail
+ * used for parsing.  Message offsets are relative to the whole payload. */
+typedef struct {
+  const z_loaned_sample_t *sample;
+  const EdgefirstPayloadSlice *slices;
+  guint n_slices;
+  size_t len;
+  const uint8_t *head;
+  size_t head_len;
+  const uint8_t *tail;
+  size_t tail_len;
+  uint8_t head_buf[PAYLOAD_HEAD_MAX];
+  uint8_t tail_buf[PAYLOAD_TAIL_MAX];
+} EdgefirstPayload;
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+void
+edgefirst_zenoh_decoder_init (EdgefirstZenohDecoder *dec, GstElement *owner)
+{
+  static gsize debug_init = 0;
+
+  if (g_once_init_enter (&debug_init)) {
+    GST_DEBUG_CATEGORY_INIT (edgefirst_zenoh_decode_debug,
+        "edgefirstzenohdecode", 0, "EdgeFirst Zenoh sample decoder");
+    g_once_init_leave (&debug_init, 1);
+  }
+
+  memset (dec, 0, sizeof (*dec));
+  dec->owner = owner;
+  dec->message_type = EDGEFIRST_ZENOH_MSG_POINTCLOUD2;
+  dec->caps_sig_extra = g_byte_array_new ();
+  dec->slices = g_array_new (FALSE, FALSE, sizeof (EdgefirstPayloadSlice));
+  gst_allocation_params_init (&dec->params);
+}
+
+void
+edgefirst_zenoh_decoder_clear (EdgefirstZenohDecoder *dec)
+{
+  edgefirst_zenoh_decoder_stop (dec);
+  g_clear_pointer (&dec->caps_sig_extra, g_byte_array_unref);
+  g_clear_pointer (&dec->slices, g_array_unref);
+}
+
+void
+edgefirst_zenoh_decoder_start (EdgefirstZenohDecoder *dec,
+    EdgefirstTransformCache *transform_cache, const gchar *target_frame)
+{
+  dec->caps_sig_valid = FALSE;
+  dec->layout_valid = FALSE;
+
+  dec->transform_cache = transform_cache;
+  dec->has_target = transform_cache && target_frame;
+  dec->tf_frame_id[0] = '\0';
+  dec->tf_frame = 0;
+  dec->tf_target = dec->has_target ?
+      edgefirst_transform_cache_intern (transform_cache, target_frame) : 0;
+}
+
+void
+edgefirst_zenoh_decoder_stop (EdgefirstZenohDecoder *dec)
+{
+  dec->caps_sig_valid = FALSE;
+  dec->transform_cache = NULL;
+  dec->has_target = FALSE;
+
+  if (dec->pool) {
+    gst_buffer_pool_set_active (dec->pool, FALSE);
+    gst_clear_object (&dec->pool);
+  }
+  dec->pool_size = 0;
+  gst_clear_object (&dec->allocator);
+  gst_clear_object (&dec->dmabuf_allocator);
+  gst_clear_object (&dec->fd_allocator);
+  g_clear_pointer (&dec->codec, edgefirst_zenoh_codec_free);
+}
+
+/* ── Multi-slice payloads ──────────────────────────────────────────── */
+
+/* Copy [offset, offset + size) of @slices, across slice boundaries */
+static void
+slices_copy (const EdgefirstPayloadSlice *slices, guint n_slices,
+    size_t offset, uint8_t *dst, size_t size)
+{
+  size_t start = 0;
+
+  for (guint i = 0; i < n_slices && size > 0; i++) {
+    const EdgefirstPayloadSlice *slice = &slices[i];
+
+    if (offset < start + slice->len) {
+      size_t skip = offset - start;
+      size_t n = MIN (size, slice->len - skip);
+
+      memcpy (dst, slice->data + skip, n);
+      dst += n;
+      offset += n;
+      size -= n;
+    }
+    start += slice->len;
+  }
+}
+
+static inline void
+payload_copy (const EdgefirstPayload *p, size_t offset, uint8_t *dst,
+    size_t size)
+{
+  slices_copy (p->slices, p->n_slices, offset, dst, size);
+}
+
+/* Collect the slices of @sample's payload and linearize its head and tail.
+ * A single-slice payload is used in place.  With @slices NULL only the
+ * head is gathered, so the message must fit in PAYLOAD_HEAD_MAX. */
+static gboolean
+payload_gather (const z_loaned_sample_t *sample, GArray *slices,
+    EdgefirstPayload *p)
+{
+  z_bytes_slice_iterator_t iter;
+  z_view_slice_t view;
+  EdgefirstPayloadSlice slice, first = { NULL, 0 };
+
+  p->sample = sample;
+  p->len = 0;
+  p->n_slices = 0;
+  p->head_len = 0;
+  p->tail = NULL;
+  p->tail_len = 0;
+  if (slices)
+    g_array_set_size (slices, 0);
+
+  iter = z_bytes_get_slice_iterator (z_sample_payload (sample));
+  while (z_bytes_slice_iterator_next (&iter, &view)) {
+    slice.data = z_slice_data (z_view_slice_loan (&view));
+    slice.len = z_slice_len (z_view_slice_loan (&view));
+    if (!slice.data || slice.len == 0)
+      continue;
+
+    if (p->n_slices == 0)
+      first = slice;
+    else if (p->n_slices == 1 && first.len < PAYLOAD_HEAD_MAX)
+      memcpy (p->head_buf, first.data, first.len);
+
+    /* Everything past the first slice is copied into the head buffer
+     * until it is full */
+    if (p->n_slices > 0 && p->len < PAYLOAD_HEAD_MAX)
+      memcpy (p->head_buf + p->len, slice.data,
+          MIN (slice.len, PAYLOAD_HEAD_MAX - p->len));
+
+    if (slices)
+      g_array_append_val (slices, slice);
+    p->n_slices++;
+    p->len += slice.len;
+  }
+
+  if (p->n_slices == 0)
+    return FALSE;
+
+  p->head_len = MIN (p->len, PAYLOAD_HEAD_MAX);
+  if (p->n_slices == 1) {
+    p->head = first.data;
+    p->head_len = p->len;
+  } else if (first.len >= p->head_len) {
+    p->head = first.data;
+  } else {
+    p->head = p->head_buf;
+  }
+
+  if (slices) {
+    p->slices = (const EdgefirstPayloadSlice *) slices->data;
+  } else {
+    p->slices = NULL;
+    p->n_slices = 0;
+    return p->head_len == p->len;
+  }
+
+  /* The tail is whatever follows the head, up to PAYLOAD_TAIL_MAX bytes */
+  p->tail_len = MIN (p->len - p->head_len, PAYLOAD_TAIL_MAX);
+  if (p->tail_len > 0) {
+    const EdgefirstPayloadSlice *last = &p->slices[p->n_slices - 1];
+
+    if (last->len >= p->tail_len) {
+      p->tail = last->data + last->len - p->tail_len;
+    } else {
+      payload_copy (p, p->len - p->tail_len, p->tail_buf, p->tail_len);
+      p->tail = p->tail_buf;
+    }
+  }
+
+  return TRUE;
+}
+
+/* ── Header filters ────────────────────────────────────────────────── */
+
+gboolean
+edgefirst_zenoh_header_filter_sample (EdgefirstZenohHeaderFilter *filter,
+    gboolean per_key, const z_loaned_sample_t *sample)
+{
+  EdgefirstPayload p;
+  EdgefirstCdrHeader header;
+  z_view_string_t key;
+  const gchar *stream = NULL;
+  gsize stream_len = 0;
+
+  if (!filter->frame_ids && filter->max_age == 0 && filter->min_interval == 0)
+    return TRUE;
+
+  /* The header is at the start of the payload, well within the head even
+   * when the message is longer */
+  if (!payload_gather (sample, NULL, &p) && p.head_len == 0)
+    return TRUE;
+  if (!edgefirst_cdr_header_parse (p.head, p.head_len, &header))
+    return TRUE;
+
+  if (per_key) {
+    z_keyexpr_as_view_string (z_sample_keyexpr (sample), &key);
+    stream = z_string_data (z_loan (key));
+    stream_len = z_string_len (z_loan (key));
+  }
+
+  return edgefirst_zenoh_header_filter_accept (filter, stream, stream_len,
+      &header, (guint64) g_get_real_time () * GST_USECOND);
+}
+
+/* ── Zero-copy payload wrapping ────────────────────────────────────── */
+
+static void
+zenoh_sample_free (gpointer data)
+{
+  z_owned_sample_t *sample = data;
+
+  z_drop (z_move (*sample));
+  g_free (sample);
+}
+
+/* Wrap [offset, offset + size) of the received payload slice in a read-only
+ * GstMemory.  The memory holds its own clone of the sample, so the Zenoh RX
+ * buffer stays alive until the last downstream reference is released. */
+static GstMemory *
+wrap_sample_memory (const z_loaned_sample_t *sample, const uint8_t *data,
+    size_t len, size_t offset, size_t size)
+{
+  z_owned_sample_t *owned = g_new (z_owned_sample_t, 1);
+
+  z_sample_clone (owned, sample);
+
+  return gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) data,
+      len, offset, size, owned, zenoh_sample_free);
+}
+
+/* ── Output buffer pool ────────────────────────────────────────────── */
+
+static gsize
+pool_size_class (gsize size)
+{
+  /* Powers of two up to 1 MiB, then whole MiB */
+  if (size <= POOL_SIZE_CLASS_MAX)
+    return (gsize) 1 << g_bit_storage (MAX (size, 1) - 1);
+
+  return (size + POOL_SIZE_CLASS_MAX - 1) & ~((gsize) POOL_SIZE_CLASS_MAX - 1);
+}
+
+static gboolean
+configure_pool (EdgefirstZenohDecoder *dec, GstBufferPool *pool, gsize size)
+{
+  GstStructure *config = gst_buffer_pool_get_config (pool);
+
+  gst_buffer_pool_config_set_params (config, NULL, (guint) size,
+      POOL_MIN_BUFFERS, 0);
+  gst_buffer_pool_config_set_allocator (config, dec->allocator,
+      &dec->params);
+
+  return gst_buffer_pool_set_config (pool, config);
+}
+
+/* Make sure the pool can hold @size bytes.  A pool that is outgrown is
+ * replaced by a new one in the next size class rather than reconfigured, so
+ * buffers still held downstream are simply freed when they come back. */
+static gboolean
+ensure_pool (EdgefirstZenohDecoder *dec, gsize size)
+{
+  GstBufferPool *pool;
+  gsize pool_size;
+
+  if (dec->pool && size <= dec->pool_size)
+    return TRUE;
+
+  pool_size = pool_size_class (size);
+  pool = gst_buffer_pool_new ();
+  if (!configure_pool (dec, pool, pool_size) ||
+      !gst_buffer_pool_set_active (pool, TRUE)) {
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (dec->owner, "Output pool grown to %" G_GSIZE_FORMAT
+      " bytes", pool_size);
+
+  if (dec->pool) {
+    gst_buffer_pool_set_active (dec->pool, FALSE);
+    gst_object_unref (dec->pool);
+  }
+  dec->pool = pool;
+  dec->pool_size = pool_size;
+  return TRUE;
+}
+
+static GstBuffer *
+acquire_output_buffer (EdgefirstZenohDecoder *dec, gsize size)
+{
+  GstBuffer *buffer = NULL;
+
+  if (ensure_pool (dec, size) &&
+      gst_buffer_pool_acquire_buffer (dec->pool, &buffer, NULL) ==
+      GST_FLOW_OK) {
+    gst_buffer_resize (buffer, 0, size);
+    return buffer;
+  }
+
+  GST_LOG_OBJECT (dec->owner, "Pool unavailable, allocating %" G_GSIZE_FORMAT
+      " bytes", size);
+  return gst_buffer_new_allocate (dec->allocator, size, &dec->params);
+}
+
+/* ── Allocation ────────────────────────────────────────────────────── */
+
+void
+edgefirst_zenoh_decoder_decide_allocation (EdgefirstZenohDecoder *dec,
+    GstQuery *query)
+{
+  GstBufferPool *pool = NULL;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  guint size = 0, min = 0, max = 0;
+
+  if (gst_query_get_n_allocation_params (query) > 0)
+    gst_query_parse_nth_allocation_param (query, 0, &allocator, &params);
+  else
+    gst_allocation_params_init (&params);
+
+  gst_clear_object (&dec->allocator);
+  dec->allocator = allocator;
+  dec->params = params;
+
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
+  if (pool) {
+    gsize pool_size = MAX ((gsize) size, dec->pool_size);
+
+    if (configure_pool (dec, pool, pool_size)) {
+      GST_DEBUG_OBJECT (dec->owner, "Using downstream pool %" GST_PTR_FORMAT,
+          pool);
+      gst_query_set_nth_allocation_pool (query, 0, pool, (guint) pool_size,
+          POOL_MIN_BUFFERS, 0);
+      if (dec->pool)
+        gst_buffer_pool_set_active (dec->pool, FALSE);
+      gst_object_replace ((GstObject **) &dec->pool, GST_OBJECT (pool));
+      dec->pool_size = pool_size;
+    } else {
+      /* Basesrc only manages pools it finds in the query */
+      while (gst_query_get_n_allocation_pools (query) > 0)
+        gst_query_remove_nth_allocation_pool (query, 0);
+    }
+    gst_object_unref (pool);
+  }
+}
+
+/* Build the output buffer for the payload at [offset, offset + size) of the
+ * CDR blob.  In zero-copy mode each received slice overlapping the range is
+ * wrapped in place as one GstMemory; otherwise the bytes are copied into a
+ * pooled buffer. */
+static GstBuffer *
+new_payload_buffer (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    size_t offset, size_t size)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  if (dec->wrap_payload) {
+    size_t start = 0, end = offset + size;
+
+    buffer = gst_buffer_new ();
+    for (guint i = 0; i < p->n_slices && start < end; i++) {
+      const EdgefirstPayloadSlice *slice = &p->slices[i];
+
+      if (offset < start + slice->len) {
+        size_t skip = offset - start;
+        size_t n = MIN (end - offset, slice->len - skip);
+
+        gst_buffer_append_memory (buffer, wrap_sample_memory (p->sample,
+                slice->data, slice->len, skip, n));
+        offset += n;
+      }
+      start += slice->len;
+    }
+    return buffer;
+  }
+
+  buffer = acquire_output_buffer (dec, size);
+  if (!gst_buffer_map (buffer, &map, GST_MAP_WRITE)) {
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+  payload_copy (p, offset, map.data, size);
+  gst_buffer_unmap (buffer, &map);
+  return buffer;
+}
+
+/* Read the compression edgefirstzenohpub describes in the attachment of
+ * @sample.  Returns FALSE for uncompressed samples. */
+static gboolean
+sample_compression (const z_loaned_sample_t *sample,
+    EdgefirstZenohCompressionInfo *info)
+{
+  const z_loaned_bytes_t *attachment = z_sample_attachment (sample);
+  z_owned_string_t str;
+  gboolean ret;
+
+  if (!attachment || z_bytes_len (attachment) == 0)
+    return FALSE;
+  if (z_bytes_to_string (attachment, &str) != Z_OK)
+    return FALSE;
+
+  ret = edgefirst_zenoh_compression_from_attachment (z_string_data (z_loan
+          (str)), z_string_len (z_loan (str)), info);
+  z_drop (z_move (str));
+  return ret;
+}
+
+/* Decompress the point data at [offset, offset + size) of the CDR blob
+ * straight from the received slices into a pooled output buffer.  The
+ * uncompressed size in the attachment is only trusted when it is the size
+ * the PointCloud2 header describes. */
+static GstBuffer *
+decompress_points (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    size_t offset, size_t size, const EdgefirstZenohCompressionInfo *info,
+    const EdgefirstCdrPointCloud2View *pcd)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  size_t start = 0, end = offset + size;
+  gboolean ok;
+
+  if (info->size != (gsize) pcd->row_step * pcd->height ||
+      info->size > DECOMPRESSED_MAX) {
+    GST_WARNING_OBJECT (dec->owner, "Compressed points claim %" G_GSIZE_FORMAT
+        " bytes, the %ux%u cloud has %" G_GSIZE_FORMAT, info->size,
+        pcd->width, pcd->height, (gsize) pcd->row_step * pcd->height);
+    return NULL;
+  }
+
+  if (!dec->codec)
+    dec->codec = edgefirst_zenoh_codec_new ();
+
+  buffer = acquire_output_buffer (dec, info->size);
+  if (!gst_buffer_map (buffer, &map, GST_MAP_WRITE)) {
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+
+  ok = edgefirst_zenoh_codec_decompress_begin (dec->codec, info->codec,
+      map.data, info->size);
+  for (guint i = 0; ok && i < p->n_slices && start < end; i++) {
+    const EdgefirstPayloadSlice *slice = &p->slices[i];
+
+    if (offset < start + slice->len) {
+      size_t skip = offset - start;
+      size_t n = MIN (end - offset, slice->len - skip);
+
+      ok = edgefirst_zenoh_codec_decompress_feed (dec->codec,
+          slice->data + skip, n);
+      offset += n;
+    }
+    start += slice->len;
+  }
+  ok = ok && edgefirst_zenoh_codec_decompress_end (dec->codec);
+
+  if (ok && info->codec == EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD) {
+    EdgefirstPointFieldDesc fields[32];
+    guint num_fields, offsets[3];
+    gsize num_points = (gsize) pcd->width * pcd->height;
+
+    num_fields = edgefirst_cdr_pointcloud2_view_get_fields (pcd, fields,
+        G_N_ELEMENTS (fields));
+    ok = edgefirst_zenoh_find_xyz (fields, num_fields, offsets) &&
+        num_points * pcd->point_step == info->size;
+    if (ok)
+      edgefirst_zenoh_dequantize_xyz (map.data, num_points, pcd->point_step,
+          offsets, info->precision);
+  }
+  gst_buffer_unmap (buffer, &map);
+
+  if (!ok) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to decompress %" G_GSIZE_FORMAT
+        " bytes of points", size);
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+  return buffer;
+}
+
+/* ── Layout normalization ──────────────────────────────────────────── */
+
+/* Normalize @num_points points starting at @offset of @slices.  Points
+ * that straddle two slices go through a stack copy. */
+static void
+normalize_run (const EdgefirstZenohPointLayout *layout,
+    const EdgefirstPayloadSlice *slices, guint n_slices, size_t offset,
+    gsize num_points, guint8 *dst)
+{
+  const guint step = layout->point_step;
+  guint8 scratch[EDGEFIRST_ZENOH_POINT_STEP_MAX];
+  size_t start = 0;
+
+  for (guint i = 0; i < n_slices && num_points > 0; i++) {
+    const EdgefirstPayloadSlice *slice = &slices[i];
+
+    if (offset < start + slice->len) {
+      size_t skip = offset - start;
+      gsize n = MIN (num_points, (slice->len - skip) / step);
+
+      edgefirst_zenoh_normalize_points (layout, dst, slice->data + skip, n);
+      dst += n * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP;
+      offset += n * step;
+      num_points -= n;
+
+      if (num_points > 0 && offset < start + slice->len) {
+        slices_copy (slices + i, n_slices - i, offset - start, scratch, step);
+        edgefirst_zenoh_normalize_points (layout, dst, scratch, 1);
+        dst += EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP;
+        offset += step;
+        num_points--;
+      }
+    }
+    start += slice->len;
+  }
+}
+
+/* Convert the @size bytes of points at @offset of @slices into a pooled
+ * buffer in the normalized layout, dropping any row padding. */
+static GstBuffer *
+normalize_points (EdgefirstZenohDecoder *dec,
+    const EdgefirstPayloadSlice *slices, guint n_slices, size_t offset,
+    size_t size, const EdgefirstCdrPointCloud2View *pcd)
+{
+  gsize row_len = (gsize) pcd->width * pcd->point_step;
+  gsize out_row = (gsize) pcd->width * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP;
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  if (pcd->height == 0 || pcd->row_step < row_len ||
+      (gsize) (pcd->height - 1) * pcd->row_step + row_len > size) {
+    GST_WARNING_OBJECT (dec->owner, "Point data does not match width %u, "
+        "height %u and row step %u", pcd->width, pcd->height, pcd->row_step);
+    return NULL;
+  }
+
+  buffer = acquire_output_buffer (dec, out_row * pcd->height);
+  if (!gst_buffer_map (buffer, &map, GST_MAP_WRITE)) {
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+  for (guint32 row = 0; row < pcd->height; row++)
+    normalize_run (&dec->layout, slices, n_slices,
+        offset + (gsize) row * pcd->row_step, pcd->width,
+        map.data + row * out_row);
+  gst_buffer_unmap (buffer, &map);
+  return buffer;
+}
+
+/* Normalize a decompressed cloud; takes @buffer */
+static GstBuffer *
+normalize_buffer (EdgefirstZenohDecoder *dec, GstBuffer *buffer,
+    const EdgefirstCdrPointCloud2View *pcd)
+{
+  EdgefirstPayloadSlice slice;
+  GstBuffer *out;
+  GstMapInfo map;
+
+  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+  slice.data = map.data;
+  slice.len = map.size;
+  out = normalize_points (dec, &slice, 1, 0, map.size, pcd);
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+  return out;
+}
+
+/* ── Caps signature ────────────────────────────────────────────────── */
+
+/* Returns TRUE if @sig and @extra equal the signature of the current caps */
+static gboolean
+caps_signature_matches (EdgefirstZenohDecoder *dec,
+    const EdgefirstZenohCapsSignature *sig, const guint8 *extra,
+    gsize extra_len)
+{
+  return dec->caps_sig_valid &&
+      memcmp (&dec->caps_sig, sig, sizeof (*sig)) == 0 &&
+      dec->caps_sig_extra->len == extra_len &&
+      (extra_len == 0 ||
+          memcmp (dec->caps_sig_extra->data, extra, extra_len) == 0);
+}
+
+/* Returns TRUE (and records the new signature) if @sig and @extra differ
+ * from the signature of the current caps. */
+static gboolean
+caps_signature_update (EdgefirstZenohDecoder *dec,
+    const EdgefirstZenohCapsSignature *sig, const guint8 *extra,
+    gsize extra_len)
+{
+  if (caps_signature_matches (dec, sig, extra, extra_len))
+    return FALSE;
+
+  dec->caps_sig = *sig;
+  g_byte_array_set_size (dec->caps_sig_extra, 0);
+  if (extra_len > 0)
+    g_byte_array_append (dec->caps_sig_extra, extra, (guint) extra_len);
+  dec->caps_sig_valid = TRUE;
+  return TRUE;
+}
+
+/* ── Data deserialization handlers ─────────────────────────────────── */
+
+static GstBuffer *
+handle_pointcloud2 (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    GstCaps **out_caps)
+{
+  EdgefirstCdrPointCloud2View pcd;
+  EdgefirstPointFieldDesc fields[32];
+  EdgefirstZenohCapsSignature sig;
+  EdgefirstZenohCompressionInfo compression;
+  GstBuffer *buffer;
+  EdgefirstPointCloud2Meta *meta;
+  gchar *fields_str;
+  guint num_fields;
+  gboolean normalize = FALSE;
+
+  if (!edgefirst_cdr_pointcloud2_view_parse_split (p->head, p->head_len,
+          p->tail, p->tail_len, p->len, &pcd)) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to deserialize PointCloud2");
+    return NULL;
+  }
+
+  if (pcd.data_len == 0)
+    return NULL;
+
+  sig.width = pcd.width;
+  sig.height = pcd.height;
+  sig.step = pcd.point_step;
+  sig.flags = (pcd.is_bigendian ? 1 : 0) | (pcd.is_dense ? 2 : 0);
+
+  /* The source layout only changes with the caps signature */
+  if (dec->normalize_layout) {
+    if (!caps_signature_matches (dec, &sig, pcd.fields, pcd.fields_len)) {
+      num_fields = edgefirst_cdr_pointcloud2_view_get_fields (&pcd, fields,
+          G_N_ELEMENTS (fields));
+      dec->layout_valid = edgefirst_zenoh_point_layout_init (&dec->layout,
+          fields, num_fields, pcd.point_step, pcd.is_bigendian);
+      if (!dec->layout_valid)
+        GST_WARNING_OBJECT (dec->owner, "Point cloud without FLOAT32 or "
+            "FLOAT64 x, y and z is not normalized");
+    }
+    normalize = dec->layout_valid &&
+        !edgefirst_zenoh_point_layout_is_normalized (&dec->layout);
+  }
+
+  if (sample_compression (p->sample, &compression)) {
+    buffer = decompress_points (dec, p, pcd.data_offset, pcd.data_len,
+        &compression, &pcd);
+    if (buffer && normalize)
+      buffer = normalize_buffer (dec, buffer, &pcd);
+  } else if (normalize) {
+    buffer = normalize_points (dec, p->slices, p->n_slices,
+        pcd.data_offset, pcd.data_len, &pcd);
+  } else {
+    buffer = new_payload_buffer (dec, p, pcd.data_offset, pcd.data_len);
+  }
+  if (!buffer)
+    return NULL;
+
+  /* Attach metadata */
+  meta = edgefirst_buffer_add_pointcloud2_meta (buffer);
+  if (meta) {
+    meta->point_count = pcd.width * pcd.height;
+    g_strlcpy (meta->frame_id, pcd.header.frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
+    meta->ros_timestamp_ns =
+        edgefirst_cdr_header_get_timestamp_ns (&pcd.header);
+
+    /* Transform at the acquisition time of the cloud.  The frame handle
+     * is interned again only when the frame changes. */
+    if (meta->frame_id[0] != '\0' &&
+        strcmp (meta->frame_id, dec->tf_frame_id) != 0) {
+      g_strlcpy (dec->tf_frame_id, meta->frame_id,
+          EDGEFIRST_FRAME_ID_MAX_LEN);
+      dec->tf_frame = edgefirst_transform_cache_intern (
+          dec->transform_cache, meta->frame_id);
+    }
+    if (meta->frame_id[0] != '\0' && dec->has_target) {
+      meta->has_transform = edgefirst_transform_cache_resolve_frames (
+          dec->transform_cache, dec->tf_frame, dec->tf_target,
+          meta->ros_timestamp_ns, NULL, &meta->transform);
+    } else if (meta->frame_id[0] != '\0') {
+      meta->has_transform = edgefirst_transform_cache_lookup_frame (
+          dec->transform_cache, dec->tf_frame, meta->ros_timestamp_ns,
+          &meta->transform);
+    }
+  }
+
+  if (!caps_signature_update (dec, &sig, pcd.fields, pcd.fields_len))
+    return buffer;
+
+  if (normalize) {
+    *out_caps = gst_caps_new_simple ("application/x-pointcloud2",
+        "width", G_TYPE_INT, (gint) pcd.width,
+        "height", G_TYPE_INT, (gint) pcd.height,
+        "point-step", G_TYPE_INT, EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP,
+        "fields", G_TYPE_STRING, EDGEFIRST_ZENOH_NORMALIZED_FIELDS,
+        "is-bigendian", G_TYPE_BOOLEAN, G_BYTE_ORDER == G_BIG_ENDIAN,
+        "is-dense", G_TYPE_BOOLEAN, pcd.is_dense,
+        NULL);
+    return buffer;
+  }
+
+  num_fields = edgefirst_cdr_pointcloud2_view_get_fields (&pcd, fields,
+      G_N_ELEMENTS (fields));
+  fields_str = edgefirst_format_point_fields (fields, num_fields);
+
+  *out_caps = gst_caps_new_simple ("application/x-pointcloud2",
+      "width", G_TYPE_INT, (gint) pcd.width,
+      "height", G_TYPE_INT, (gint) pcd.height,
+      "point-step", G_TYPE_INT, (gint) pcd.point_step,
+      "fields", G_TYPE_STRING, fields_str,
+      "is-bigendian", G_TYPE_BOOLEAN, pcd.is_bigendian,
+      "is-dense", G_TYPE_BOOLEAN, pcd.is_dense,
+      NULL);
+
+  g_free (fields_str);
+  return buffer;
+}
+
+/* NNStreamer "dimensions" string for a radar cube: innermost dimension first,
+ * with an extra innermost 2 when the cube holds (real, imaginary) pairs. */
+static gchar *
+radar_cube_dimensions (const EdgefirstCdrRadarCubeView *cube)
+{
+  GString *dims = g_string_new (NULL);
+  guint n = MIN (cube->shape_len, EDGEFIRST_RADAR_MAX_DIMS);
+  guint64 elems = 1;
+
+  for (guint i = 0; i < n; i++)
+    elems *= cube->shape[i];
+
+  if (cube->is_complex && elems * 2 == cube->cube_len)
+    g_string_append (dims, "2");
+
+  for (guint i = n; i > 0; i--)
+    g_string_append_printf (dims, "%s%u", dims->len ? ":" : "",
+        cube->shape[i - 1]);
+
+  return g_string_free (dims, FALSE);
+}
+
+static GstBuffer *
+handle_radarcube (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    GstCaps **out_caps)
+{
+  EdgefirstCdrRadarCubeView cube;
+  EdgefirstZenohCapsSignature sig;
+  GstBuffer *buffer;
+  EdgefirstRadarCubeMeta *meta;
+  gchar *dims;
+
+  if (!edgefirst_cdr_radar_cube_view_parse_split (p->head, p->head_len,
+          p->tail, p->tail_len, p->len, &cube)) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to deserialize RadarCube");
+    return NULL;
+  }
+
+  if (cube.cube_len == 0)
+    return NULL;
+
+  /* cube_len is the number of int16 elements */
+  buffer = new_payload_buffer (dec, p, cube.cube_offset,
+      (size_t) cube.cube_len * sizeof (gint16));
+  if (!buffer)
+    return NULL;
+
+  /* Attach metadata */
+  meta = edgefirst_buffer_add_radar_cube_meta (buffer);
+  if (meta) {
+    meta->num_dims = (guint8) MIN (cube.layout_len, EDGEFIRST_RADAR_MAX_DIMS);
+    for (guint8 i = 0; i < meta->num_dims; i++)
+      meta->layout[i] = (EdgefirstRadarDimension) cube.layout[i];
+
+    memset (meta->scales, 0, sizeof (meta->scales));
+    memcpy (meta->scales, cube.scales,
+        MIN (cube.scales_len, EDGEFIRST_RADAR_MAX_DIMS) * sizeof (gfloat));
+
+    meta->is_complex = cube.is_complex;
+    meta->radar_timestamp = cube.timestamp;
+    g_strlcpy (meta->frame_id, cube.header.frame_id,
+        EDGEFIRST_FRAME_ID_MAX_LEN);
+  }
+
+  /* The dimensions string depends on the shape and, through the complex
+   * pair check, on the element count */
+  sig.width = MIN (cube.shape_len, EDGEFIRST_RADAR_MAX_DIMS);
+  sig.height = cube.cube_len;
+  sig.step = 0;
+  sig.flags = cube.is_complex ? 1 : 0;
+  if (!caps_signature_update (dec, &sig, (const guint8 *) cube.shape,
+          sig.width * sizeof (guint16)))
+    return buffer;
+
+  dims = radar_cube_dimensions (&cube);
+  *out_caps = gst_caps_new_simple ("other/tensors",
+      "num-tensors", G_TYPE_INT, 1,
+      "dimensions", G_TYPE_STRING, dims,
+      "types", G_TYPE_STRING, "int16",
+      "format", G_TYPE_STRING, "static",
+      NULL);
+  g_free (dims);
+
+  return buffer;
+}
+
+static GstVideoFormat
+ros_encoding_to_gst_format (const char *encoding, gboolean is_bigendian)
+{
+  if (!encoding)
+    return GST_VIDEO_FORMAT_UNKNOWN;
+
+  if (g_strcmp0 (encoding, "rgb8") == 0)
+    return GST_VIDEO_FORMAT_RGB;
+  if (g_strcmp0 (encoding, "bgr8") == 0)
+    return GST_VIDEO_FORMAT_BGR;
+  if (g_strcmp0 (encoding, "rgba8") == 0)
+    return GST_VIDEO_FORMAT_RGBA;
+  if (g_strcmp0 (encoding, "bgra8") == 0)
+    return GST_VIDEO_FORMAT_BGRA;
+  if (g_strcmp0 (encoding, "mono8") == 0)
+    return GST_VIDEO_FORMAT_GRAY8;
+  if (g_strcmp0 (encoding, "mono16") == 0)
+    return is_bigendian ? GST_VIDEO_FORMAT_GRAY16_BE : GST_VIDEO_FORMAT_GRAY16_LE;
+  if (g_strcmp0 (encoding, "yuv422") == 0)
+    return GST_VIDEO_FORMAT_UYVY;
+
+  return GST_VIDEO_FORMAT_UNKNOWN;
+}
+
+static GstBuffer *
+handle_image (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    GstCaps **out_caps)
+{
+  EdgefirstCdrImageView img;
+  EdgefirstZenohCapsSignature sig;
+  GstVideoInfo info;
+  GstBuffer *buffer;
+  GstVideoFormat format;
+  gboolean changed;
+
+  if (!edgefirst_cdr_image_view_parse_split (p->head, p->head_len, p->tail,
+          p->tail_len, p->len, &img)) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to deserialize Image");
+    return NULL;
+  }
+
+  if (img.data_len == 0)
+    return NULL;
+
+  format = ros_encoding_to_gst_format (img.encoding, img.is_bigendian);
+  if (format == GST_VIDEO_FORMAT_UNKNOWN) {
+    GST_WARNING_OBJECT (dec->owner, "Unsupported image encoding: %s",
+        img.encoding);
+    return NULL;
+  }
+
+  /* The signature and video info are only committed once the buffer
+   * exists, or a failed frame would leave the new caps unpushed */
+  sig.width = img.width;
+  sig.height = img.height;
+  sig.step = 0;
+  sig.flags = format;
+  changed = !caps_signature_matches (dec, &sig, NULL, 0);
+  if (changed)
+    gst_video_info_set_format (&info, format, img.width, img.height);
+  else
+    info = dec->video_info;
+
+  /* As the DmaBuffer stride: a row must hold width pixels */
+  if ((gsize) img.step <
+      (gsize) GST_VIDEO_INFO_COMP_PSTRIDE (&info, 0) * img.width) {
+    GST_WARNING_OBJECT (dec->owner, "Image step %u too small for %ux%u %s",
+        img.step, img.width, img.height, img.encoding);
+    return NULL;
+  }
+
+  if ((gsize) img.step * img.height > img.data_len) {
+    GST_WARNING_OBJECT (dec->owner, "Image data too short: %u < %u x %u",
+        img.data_len, img.step, img.height);
+    return NULL;
+  }
+
+  buffer = new_payload_buffer (dec, p, img.data_offset, img.data_len);
+  if (!buffer)
+    return NULL;
+
+  /* All supported encodings are single-plane; describe padded rows */
+  if (img.step != (guint32) GST_VIDEO_INFO_PLANE_STRIDE (&info, 0)) {
+    gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+    gint stride[GST_VIDEO_MAX_PLANES] = { (gint) img.step, };
+
+    gst_buffer_add_video_meta_full (buffer, GST_VIDEO_FRAME_FLAG_NONE,
+        format, img.width, img.height, 1, offset, stride);
+  }
+
+  if (changed) {
+    caps_signature_update (dec, &sig, NULL, 0);
+    dec->video_info = info;
+    *out_caps = gst_video_info_to_caps (&dec->video_info);
+  }
+  return buffer;
+}
+
+static GstBuffer *
+handle_camera_info (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p)
+{
+  EdgefirstCdrCameraInfoView ci;
+  GstBuffer *buffer;
+  EdgefirstCameraInfoMeta *meta;
+
+  /* CameraInfo has no bulk data and is parsed from the head alone */
+  if (p->head_len != p->len) {
+    GST_WARNING_OBJECT (dec->owner, "CameraInfo too large: %" G_GSIZE_FORMAT
+        " bytes", p->len);
+    return NULL;
+  }
+
+  if (!edgefirst_cdr_camera_info_view_parse (p->head, p->head_len, &ci)) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to deserialize CameraInfo");
+    return NULL;
+  }
+
+  /* CameraInfo doesn't carry pixel data, create a minimal buffer */
+  buffer = gst_buffer_new ();
+  meta = edgefirst_buffer_add_camera_info_meta (buffer);
+  if (meta) {
+    meta->width  = ci.width;
+    meta->height = ci.height;
+
+    memcpy (meta->K, ci.K, sizeof (meta->K));
+    memcpy (meta->R, ci.R, sizeof (meta->R));
+    memcpy (meta->P, ci.P, sizeof (meta->P));
+    meta->num_distortion_coeffs =
+        (guint8) MIN (ci.D_len, EDGEFIRST_MAX_DISTORTION_COEFFS);
+    memcpy (meta->D, ci.D, meta->num_distortion_coeffs * sizeof (gdouble));
+
+    if (g_strcmp0 (ci.distortion_model, "plumb_bob") == 0)
+      meta->distortion_model = EDGEFIRST_DISTORTION_PLUMB_BOB;
+    else if (g_strcmp0 (ci.distortion_model, "equidistant") == 0)
+      meta->distortion_model = EDGEFIRST_DISTORTION_EQUIDISTANT;
+    else if (g_strcmp0 (ci.distortion_model, "rational_polynomial") == 0)
+      meta->distortion_model = EDGEFIRST_DISTORTION_RATIONAL;
+
+    g_strlcpy (meta->frame_id, ci.header.frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
+  }
+
+  return buffer;
+}
+
+gint
+edgefirst_zenoh_import_dmabuffer (GstElement *element,
+    EdgefirstZenohFdImporter *importer, const z_loaned_sample_t *sample)
+{
+  const z_loaned_bytes_t *attachment = z_sample_attachment (sample);
+  z_owned_string_t str;
+  EdgefirstPayload p;
+  EdgefirstCdrDmaBufferView dma;
+  GError *error = NULL;
+  gboolean local = FALSE;
+  gint fd;
+
+  if (attachment && z_bytes_to_string (attachment, &str) == Z_OK) {
+    local = edgefirst_zenoh_dmabuf_attachment_is_local (
+        z_string_data (z_loan (str)), z_string_len (z_loan (str)));
+    z_drop (z_move (str));
+  }
+  if (!local) {
+    GST_WARNING_OBJECT (element, "Ignoring DmaBuffer from another host");
+    return -1;
+  }
+
+  if (!payload_gather (sample, NULL, &p) ||
+      !edgefirst_cdr_dma_buffer_view_parse (p.head, p.head_len, &dma)) {
+    GST_WARNING_OBJECT (element, "Failed to deserialize DmaBuffer");
+    return -1;
+  }
+  if (dma.pid == 0 || dma.pid > G_MAXINT || dma.fd < 0) {
+    GST_WARNING_OBJECT (element, "Invalid DmaBuffer pid %u fd %d", dma.pid,
+        dma.fd);
+    return -1;
+  }
+
+  fd = edgefirst_zenoh_fd_importer_import (importer, (gint) dma.pid, dma.fd,
+      &error);
+
+  if (fd >= 0 && !edgefirst_zenoh_dmabuf_check (fd, dma.length, &error)) {
+    close (fd);
+    fd = -1;
+  }
+  if (fd < 0) {
+    GST_ELEMENT_WARNING (element, RESOURCE, OPEN_READ, (NULL),
+        ("Cannot import DmaBuffer fd: %s", error->message));
+    g_clear_error (&error);
+  }
+
+  return fd;
+}
+
+/* The message only names an fd in the publisher process; the frame is
+ * mapped without copying from the duplicate imported on arrival by
+ * edgefirst_zenoh_import_dmabuffer(), which is taken from *@fd. */
+static GstBuffer *
+handle_dmabuffer (EdgefirstZenohDecoder *dec, const EdgefirstPayload *p,
+    gint *fd, GstCaps **out_caps)
+{
+  EdgefirstCdrDmaBufferView dma;
+  EdgefirstZenohCapsSignature sig;
+  GstVideoInfo info;
+  GstBuffer *buffer;
+  GstVideoFormat format;
+  gsize needed;
+  gboolean changed, is_dmabuf;
+
+  if (p->head_len != p->len || *fd < 0 ||
+      !edgefirst_cdr_dma_buffer_view_parse (p->head, p->head_len, &dma)) {
+    GST_WARNING_OBJECT (dec->owner, "Failed to deserialize DmaBuffer");
+    return NULL;
+  }
+
+  format = edgefirst_zenoh_video_format_from_fourcc (dma.fourcc);
+  if (format == GST_VIDEO_FORMAT_UNKNOWN ||
+      !gst_video_info_set_format (&info, format, dma.width, dma.height)) {
+    GST_WARNING_OBJECT (dec->owner, "Unsupported DmaBuffer fourcc %"
+        GST_FOURCC_FORMAT " at %ux%u", GST_FOURCC_ARGS (dma.fourcc),
+        dma.width, dma.height);
+    return NULL;
+  }
+
+  /* The fd was checked to hold dma.length bytes; the frame must fit in
+   * them.  Padded rows, as handle_image, for single-plane layouts only. */
+  if (GST_VIDEO_INFO_N_PLANES (&info) == 1) {
+    if (dma.stride < (guint32) GST_VIDEO_INFO_PLANE_STRIDE (&info, 0)) {
+      GST_WARNING_OBJECT (dec->owner, "DmaBuffer stride %u too small for %ux%u",
+          dma.stride, dma.width, dma.height);
+      return NULL;
+    }
+    needed = (gsize) dma.stride * dma.height;
+  } else {
+    needed = GST_VIDEO_INFO_SIZE (&info);
+  }
+  if (needed > dma.length) {
+    GST_WARNING_OBJECT (dec->owner, "DmaBuffer of %u bytes cannot hold a %ux%u "
+        "frame of %" G_GSIZE_FORMAT " bytes", dma.length, dma.width,
+        dma.height, needed);
+    return NULL;
+  }
+
+  /* A sealed memfd is plain memory to downstream, which must not try to
+   * import it as a DMA-BUF; the step slot tells the two caps apart */
+  is_dmabuf = edgefirst_zenoh_fd_is_dmabuf (*fd);
+  sig.width = dma.width;
+  sig.height = dma.height;
+  sig.step = is_dmabuf ? 0 : 1;
+  sig.flags = format;
+  changed = !caps_signature_matches (dec, &sig, NULL, 0);
+
+  buffer = gst_buffer_new ();
+  if (is_dmabuf) {
+    if (!dec->dmabuf_allocator)
+      dec->dmabuf_allocator = gst_dmabuf_allocator_new ();
+    gst_buffer_append_memory (buffer,
+        gst_dmabuf_allocator_alloc (dec->dmabuf_allocator, *fd, dma.length));
+  } else {
+    if (!dec->fd_allocator)
+      dec->fd_allocator = gst_fd_allocator_new ();
+    gst_buffer_append_memory (buffer,
+        gst_fd_allocator_alloc (dec->fd_allocator, *fd, dma.length,
+            GST_FD_MEMORY_FLAG_NONE));
+  }
+  *fd = -1;
+
+  if (GST_VIDEO_INFO_N_PLANES (&info) == 1 &&
+      dma.stride != (guint32) GST_VIDEO_INFO_PLANE_STRIDE (&info, 0)) {
+    gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+    gint stride[GST_VIDEO_MAX_PLANES] = { (gint) dma.stride, };
+
+    gst_buffer_add_video_meta_full (buffer, GST_VIDEO_FRAME_FLAG_NONE,
+        format, dma.width, dma.height, 1, offset, stride);
+  }
+
+  if (changed) {
+    caps_signature_update (dec, &sig, NULL, 0);
+    dec->video_info = info;
+    *out_caps = gst_video_info_to_caps (&info);
+    if (is_dmabuf)
+      gst_caps_set_features (*out_caps, 0,
+          gst_caps_features_new (GST_CAPS_FEATURE_MEMORY_DMABUF, NULL));
+  }
+
+  return buffer;
+}
+
+/* ── Decoding ──────────────────────────────────────────────────────── */
+
+GstBuffer *
+edgefirst_zenoh_decoder_decode (EdgefirstZenohDecoder *dec,
+    const z_loaned_sample_t *sample, gint *fd, GstCaps **out_caps,
+    guint64 *stamp)
+{
+  EdgefirstPayload payload;
+  EdgefirstCdrHeader header;
+  GstBuffer *buffer = NULL;
+
+  *stamp = 0;
+  if (!payload_gather (sample, dec->slices, &payload))
+    return NULL;
+
+  /* Header filters already ran on arrival */
+  if (edgefirst_cdr_header_parse (payload.head, payload.head_len, &header))
+    *stamp = edgefirst_cdr_header_get_timestamp_ns (&header);
+
+  if (payload.n_slices > 1)
+    GST_LOG_OBJECT (dec->owner, "Payload of %" G_GSIZE_FORMAT " bytes in %u "
+        "slices", payload.len, payload.n_slices);
+
+  switch (dec->message_type) {
+    case EDGEFIRST_ZENOH_MSG_POINTCLOUD2:
+      buffer = handle_pointcloud2 (dec, &payload, out_caps);
+      break;
+    case EDGEFIRST_ZENOH_MSG_RADARCUBE:
+      buffer = handle_radarcube (dec, &payload, out_caps);
+      break;
+    case EDGEFIRST_ZENOH_MSG_IMAGE:
+      buffer = handle_image (dec, &payload, out_caps);
+      break;
+    case EDGEFIRST_ZENOH_MSG_CAMERA_INFO:
+      buffer = handle_camera_info (dec, &payload);
+      break;
+    case EDGEFIRST_ZENOH_MSG_DMABUFFER:
+      buffer = handle_dmabuffer (dec, &payload, fd, out_caps);
+      break;
+    case EDGEFIRST_ZENOH_MSG_TRANSFORM:
+      /* Transform messages handled via TF subscriber */
+      break;
+  }
+
+  return buffer;
+}
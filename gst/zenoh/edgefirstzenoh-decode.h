@@ -0,0 +1,168 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Sample Decoder
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_DECODE_H__
+#define __EDGEFIRST_ZENOH_DECODE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <gst/edgefirst/edgefirst.h>
+#include <zenoh.h>
+#include "edgefirstzenohsub.h"
+#include "edgefirstzenoh-compress.h"
+#include "edgefirstzenoh-dmabuf.h"
+#include "edgefirstzenoh-filter.h"
+#include "edgefirstzenoh-normalize.h"
+#include "transform-cache.h"
+
+G_BEGIN_DECLS
+
+/* Everything the output caps depend on.  Handlers compare this against the
+ * previous message and only build caps when it changes. */
+typedef struct {
+  guint32 width;
+  guint32 height;
+  guint32 step;
+  guint32 flags;
+} EdgefirstZenohCapsSignature;
+
+/**
+ * EdgefirstZenohDecoder:
+ *
+ * Turns the samples of one stream into output buffers and caps.  The
+ * settings are set by the owning element before
+ * edgefirst_zenoh_decoder_start() and left alone while streaming; the rest
+ * is private state of the streaming thread.
+ */
+typedef struct {
+  /* Settings */
+  GstElement *owner;            /* for logging and warnings, not owned */
+  EdgefirstZenohSubMessageType message_type;
+  gboolean wrap_payload;        /* zero-copy, or shm on an SHM session */
+  gboolean normalize_layout;
+
+  /* Caps signature of the last pushed caps */
+  EdgefirstZenohCapsSignature caps_sig;
+  GByteArray *caps_sig_extra;   /* variable part: point fields, cube shape */
+  gboolean caps_sig_valid;
+  GstVideoInfo video_info;      /* image mode: info for caps_sig */
+  EdgefirstZenohPointLayout layout;   /* normalize-layout: for caps_sig */
+  gboolean layout_valid;
+
+  /* Slices of the payload being decoded */
+  GArray *slices;               /* EdgefirstPayloadSlice */
+
+  /* Output buffer pool for copied payloads */
+  GstBufferPool *pool;
+  gsize pool_size;
+  GstAllocator *allocator;
+  GstAllocationParams params;
+
+  /* dmabuffer mode: wrap the DMA-BUF and memfd fds imported on arrival */
+  GstAllocator *dmabuf_allocator;
+  GstAllocator *fd_allocator;
+
+  /* Decompression contexts for compressed point clouds, created on the
+   * first one */
+  EdgefirstZenohCodec *codec;
+
+  /* Transforms shared by the session, NULL when stopped, and the interned
+   * handles of the last cloud frame and the target frame */
+  EdgefirstTransformCache *transform_cache;
+  gboolean has_target;
+  gchar tf_frame_id[EDGEFIRST_FRAME_ID_MAX_LEN];
+  guint tf_frame;
+  guint tf_target;
+} EdgefirstZenohDecoder;
+
+void edgefirst_zenoh_decoder_init (EdgefirstZenohDecoder *dec,
+    GstElement *owner);
+void edgefirst_zenoh_decoder_clear (EdgefirstZenohDecoder *dec);
+
+/**
+ * edgefirst_zenoh_decoder_start:
+ * @dec: an #EdgefirstZenohDecoder
+ * @transform_cache: (nullable): transforms to attach to point clouds
+ * @target_frame: (nullable): frame the attached transform maps into, or
+ *   %NULL for the parent of the cloud frame
+ *
+ * Prepares @dec for a new stream with the current settings.
+ */
+void edgefirst_zenoh_decoder_start (EdgefirstZenohDecoder *dec,
+    EdgefirstTransformCache *transform_cache, const gchar *target_frame);
+
+/**
+ * edgefirst_zenoh_decoder_stop:
+ * @dec: an #EdgefirstZenohDecoder
+ *
+ * Forgets the caps and releases the pool, allocators and codecs.
+ */
+void edgefirst_zenoh_decoder_stop (EdgefirstZenohDecoder *dec);
+
+/**
+ * edgefirst_zenoh_decoder_decide_allocation:
+ * @dec: an #EdgefirstZenohDecoder
+ * @query: the answered allocation query of the output pad
+ *
+ * Adopts the downstream pool when it can be configured for the payloads,
+ * otherwise keeps the internal pool with downstream's allocator.  Pools
+ * that cannot be used are removed from @query.
+ */
+void edgefirst_zenoh_decoder_decide_allocation (EdgefirstZenohDecoder *dec,
+    GstQuery *query);
+
+/**
+ * edgefirst_zenoh_decoder_decode:
+ * @dec: an #EdgefirstZenohDecoder
+ * @sample: a received sample
+ * @fd: dmabuffer mode: the fd imported for @sample, taken on success
+ * @out_caps: (out) (transfer full): set to new caps when the stream
+ *   changes, otherwise left alone
+ * @stamp: (out): header stamp in ns, or 0 if there is none
+ *
+ * Returns: (transfer full) (nullable): the output buffer, or %NULL if the
+ *   sample cannot be decoded
+ */
+GstBuffer *edgefirst_zenoh_decoder_decode (EdgefirstZenohDecoder *dec,
+    const z_loaned_sample_t *sample, gint *fd, GstCaps **out_caps,
+    guint64 *stamp);
+
+/**
+ * edgefirst_zenoh_header_filter_sample:
+ * @filter: the element's header filters
+ * @per_key: keep min-interval per key expression of the samples as well as
+ *   per frame_id, for wildcard subscriptions with one stream per key
+ * @sample: a received sample
+ *
+ * Applies @filter on the Zenoh thread, parsing only the header at the start
+ * of the payload.  Samples whose header cannot be parsed pass, and are
+ * reported by the decoder.
+ *
+ * Returns: %TRUE if @sample should be queued
+ */
+gboolean edgefirst_zenoh_header_filter_sample (
+    EdgefirstZenohHeaderFilter *filter, gboolean per_key,
+    const z_loaned_sample_t *sample);
+
+/**
+ * edgefirst_zenoh_import_dmabuffer:
+ * @element: element to post warnings on
+ * @importer: importer for the publisher process
+ * @sample: a received edgefirst_msgs/DmaBuffer sample
+ *
+ * Duplicates the fd @sample names, on the Zenoh thread.  The pid is only
+ * trusted from samples published on this host, and the duplicate must be
+ * a DMA-BUF that holds the whole frame, or mapping it could fault.  The
+ * caller serializes access to @importer.
+ *
+ * Returns: the imported fd, or -1 after posting a warning
+ */
+gint edgefirst_zenoh_import_dmabuffer (GstElement *element,
+    EdgefirstZenohFdImporter *importer, const z_loaned_sample_t *sample);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_DECODE_H__ */
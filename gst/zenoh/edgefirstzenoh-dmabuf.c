@@ -0,0 +1,233 @@
+/*
+ * EdgeFirst Perception for GStreamer - DMA-BUF Handle Exchange
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-dmabuf.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+
+/* Same numbers on every architecture since the syscall table unification */
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_getfd
+#define SYS_pidfd_getfd 438
+#endif
+
+/* linux/magic.h */
+#ifndef DMA_BUF_MAGIC
+#define DMA_BUF_MAGIC 0x444d4142
+#endif
+
+/* linux/fcntl.h; glibc only defines them for _GNU_SOURCE */
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#endif
+#ifndef F_SEAL_SHRINK
+#define F_SEAL_SHRINK 0x0002
+#endif
+
+#define HOST_ATTACHMENT_KEY "edgefirst-host"
+
+/* ── Pixel formats ─────────────────────────────────────────────────── */
+
+static const struct {
+  GstVideoFormat format;
+  guint32 fourcc;
+} fourcc_map[] = {
+  { GST_VIDEO_FORMAT_YUY2, GST_MAKE_FOURCC ('Y', 'U', 'Y', 'V') },
+  { GST_VIDEO_FORMAT_UYVY, GST_MAKE_FOURCC ('U', 'Y', 'V', 'Y') },
+  { GST_VIDEO_FORMAT_NV12, GST_MAKE_FOURCC ('N', 'V', '1', '2') },
+  { GST_VIDEO_FORMAT_NV16, GST_MAKE_FOURCC ('N', 'V', '1', '6') },
+  { GST_VIDEO_FORMAT_I420, GST_MAKE_FOURCC ('Y', 'U', '1', '2') },
+  { GST_VIDEO_FORMAT_RGB, GST_MAKE_FOURCC ('R', 'G', 'B', '3') },
+  { GST_VIDEO_FORMAT_BGR, GST_MAKE_FOURCC ('B', 'G', 'R', '3') },
+  { GST_VIDEO_FORMAT_RGBA, GST_MAKE_FOURCC ('A', 'B', '2', '4') },
+  { GST_VIDEO_FORMAT_BGRA, GST_MAKE_FOURCC ('A', 'R', '2', '4') },
+  { GST_VIDEO_FORMAT_GRAY8, GST_MAKE_FOURCC ('G', 'R', 'E', 'Y') },
+};
+
+guint32
+edgefirst_zenoh_fourcc_from_video_format (GstVideoFormat format)
+{
+  for (guint i = 0; i < G_N_ELEMENTS (fourcc_map); i++)
+    if (fourcc_map[i].format == format)
+      return fourcc_map[i].fourcc;
+  return 0;
+}
+
+GstVideoFormat
+edgefirst_zenoh_video_format_from_fourcc (guint32 fourcc)
+{
+  for (guint i = 0; i < G_N_ELEMENTS (fourcc_map); i++)
+    if (fourcc_map[i].fourcc == fourcc)
+      return fourcc_map[i].format;
+  return GST_VIDEO_FORMAT_UNKNOWN;
+}
+
+/* ── Cross-process fd import ───────────────────────────────────────── */
+
+void
+edgefirst_zenoh_fd_importer_init (EdgefirstZenohFdImporter *importer)
+{
+  importer->pid = 0;
+  importer->pidfd = -1;
+}
+
+void
+edgefirst_zenoh_fd_importer_clear (EdgefirstZenohFdImporter *importer)
+{
+  if (importer->pidfd >= 0)
+    close (importer->pidfd);
+  edgefirst_zenoh_fd_importer_init (importer);
+}
+
+gint
+edgefirst_zenoh_fd_importer_import (EdgefirstZenohFdImporter *importer,
+    gint pid, gint fd, GError **error)
+{
+  gint newfd;
+
+  /* Publisher in this process: nothing to cross */
+  if (pid == getpid ()) {
+    newfd = dup (fd);
+    if (newfd < 0)
+      g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+          "dup(%d): %s", fd, g_strerror (errno));
+    return newfd;
+  }
+
+  if (importer->pid != pid) {
+    edgefirst_zenoh_fd_importer_clear (importer);
+    importer->pidfd = (gint) syscall (SYS_pidfd_open, (pid_t) pid, 0);
+    if (importer->pidfd < 0) {
+      g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+          "pidfd_open(%d): %s", pid, g_strerror (errno));
+      return -1;
+    }
+    importer->pid = pid;
+  }
+
+  newfd = (gint) syscall (SYS_pidfd_getfd, importer->pidfd, fd, 0);
+  if (newfd < 0) {
+    g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+        "pidfd_getfd(%d, %d): %s", pid, fd, g_strerror (errno));
+    /* The publisher may have restarted under a recycled pid */
+    edgefirst_zenoh_fd_importer_clear (importer);
+  }
+  return newfd;
+}
+
+gboolean
+edgefirst_zenoh_fd_is_dmabuf (gint fd)
+{
+  struct statfs fs;
+
+  return fstatfs (fd, &fs) == 0 && fs.f_type == DMA_BUF_MAGIC;
+}
+
+gboolean
+edgefirst_zenoh_dmabuf_check (gint fd, gsize length, GError **error)
+{
+  struct statfs fs;
+  struct stat st;
+  off_t size;
+  gint seals;
+
+  if (fstatfs (fd, &fs) != 0) {
+    g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+        "fstatfs(%d): %s", fd, g_strerror (errno));
+    return FALSE;
+  }
+
+  if (fs.f_type == DMA_BUF_MAGIC) {
+    /* A DMA-BUF reports its size through lseek() and cannot be resized */
+    size = lseek (fd, 0, SEEK_END);
+    lseek (fd, 0, SEEK_SET);
+  } else {
+    /* A memfd can be truncated under the mapping unless it is sealed;
+     * F_GET_SEALS fails for files that cannot be sealed at all */
+    seals = fcntl (fd, F_GET_SEALS);
+    if (seals < 0 || !(seals & F_SEAL_SHRINK)) {
+      g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+          "fd %d is neither a DMA-BUF nor a memfd sealed against shrinking",
+          fd);
+      return FALSE;
+    }
+    size = fstat (fd, &st) == 0 ? st.st_size : -1;
+  }
+
+  if (size < 0 || length == 0 || (guint64) size < length) {
+    g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+        "fd %d of %" G_GINT64_FORMAT " bytes cannot hold %" G_GSIZE_FORMAT
+        " bytes", fd, (gint64) size, length);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+gboolean
+edgefirst_zenoh_dmabuf_seal (gint fd, GError **error)
+{
+  gint seals;
+
+  if (edgefirst_zenoh_fd_is_dmabuf (fd))
+    return TRUE;
+
+  seals = fcntl (fd, F_GET_SEALS);
+  if (seals >= 0 && (seals & F_SEAL_SHRINK))
+    return TRUE;
+
+  if (seals < 0 || fcntl (fd, F_ADD_SEALS, F_SEAL_SHRINK) != 0) {
+    g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+        "fd %d is not a DMA-BUF and cannot be sealed against shrinking "
+        "(a memfd needs MFD_ALLOW_SEALING): %s", fd, g_strerror (errno));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* ── Host identity ─────────────────────────────────────────────────── */
+
+const gchar *
+edgefirst_zenoh_dmabuf_attachment (void)
+{
+  static gchar *attachment = NULL;
+
+  if (g_once_init_enter (&attachment)) {
+    gchar *boot_id = NULL, *value = NULL;
+
+    if (g_file_get_contents ("/proc/sys/kernel/random/boot_id", &boot_id,
+            NULL, NULL)) {
+      g_strstrip (boot_id);
+      value = g_strconcat (HOST_ATTACHMENT_KEY "=", boot_id, NULL);
+      g_free (boot_id);
+    }
+    /* An empty string records that there is no boot id */
+    g_once_init_leave (&attachment, value ? value : g_strdup (""));
+  }
+
+  return attachment[0] ? attachment : NULL;
+}
+
+gboolean
+edgefirst_zenoh_dmabuf_attachment_is_local (const gchar *str, gsize len)
+{
+  const gchar *local = edgefirst_zenoh_dmabuf_attachment ();
+
+  return str && local && len == strlen (local) && memcmp (str, local, len) == 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * EdgeFirst Perception for GStreamer - DMA-BUF Handle Exchange
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_DMABUF_H__
+#define __EDGEFIRST_ZENOH_DMABUF_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+/**
+ * edgefirst_zenoh_fourcc_from_video_format:
+ * @format: a #GstVideoFormat
+ *
+ * Returns: the V4L2 fourcc carried by edgefirst_msgs/DmaBuffer for @format,
+ *   or 0 if there is none
+ */
+guint32 edgefirst_zenoh_fourcc_from_video_format (GstVideoFormat format);
+
+/**
+ * edgefirst_zenoh_video_format_from_fourcc:
+ * @fourcc: a V4L2 fourcc
+ *
+ * Returns: the #GstVideoFormat for @fourcc, or %GST_VIDEO_FORMAT_UNKNOWN
+ */
+GstVideoFormat edgefirst_zenoh_video_format_from_fourcc (guint32 fourcc);
+
+/**
+ * EdgefirstZenohFdImporter:
+ *
+ * Duplicates file descriptors out of another process with pidfd_getfd().
+ * The pidfd of the last process is kept open, since a stream comes from
+ * one publisher.
+ */
+typedef struct {
+  gint pid;
+  gint pidfd;
+} EdgefirstZenohFdImporter;
+
+void edgefirst_zenoh_fd_importer_init (EdgefirstZenohFdImporter *importer);
+void edgefirst_zenoh_fd_importer_clear (EdgefirstZenohFdImporter *importer);
+
+/**
+ * edgefirst_zenoh_fd_importer_import:
+ * @importer: an #EdgefirstZenohFdImporter
+ * @pid: process owning @fd
+ * @fd: file descriptor number in @pid
+ * @error: return location for an error
+ *
+ * Needs ptrace access to @pid (same user and a permissive
+ * kernel.yama.ptrace_scope, or CAP_SYS_PTRACE).
+ *
+ * Returns: a new file descriptor in this process, or -1 on error
+ */
+gint edgefirst_zenoh_fd_importer_import (EdgefirstZenohFdImporter *importer,
+    gint pid, gint fd, GError **error);
+
+/**
+ * edgefirst_zenoh_fd_is_dmabuf:
+ * @fd: a file descriptor
+ *
+ * Returns: %TRUE if @fd is a DMA-BUF
+ */
+gboolean edgefirst_zenoh_fd_is_dmabuf (gint fd);
+
+/**
+ * edgefirst_zenoh_dmabuf_check:
+ * @fd: an imported file descriptor
+ * @length: bytes the message says the frame occupies
+ * @error: return location for an error
+ *
+ * Checks that @fd is a DMA-BUF, or a memfd sealed with F_SEAL_SHRINK, at
+ * least @length bytes long, so mapping @length bytes cannot fault past the
+ * end of the buffer.  An unsealed memfd could be truncated by its owner
+ * while mapped.
+ *
+ * Returns: %TRUE if @fd can back a frame of @length bytes
+ */
+gboolean edgefirst_zenoh_dmabuf_check (gint fd, gsize length,
+    GError **error);
+
+/**
+ * edgefirst_zenoh_dmabuf_seal:
+ * @fd: a file descriptor about to be published
+ * @error: return location for an error
+ *
+ * Makes @fd pass edgefirst_zenoh_dmabuf_check() on the subscriber: a
+ * DMA-BUF or an already sealed memfd is left alone, another memfd is
+ * sealed with F_SEAL_SHRINK.  Fails for memfds created without
+ * MFD_ALLOW_SEALING and for other files.
+ *
+ * Returns: %TRUE if @fd can be published
+ */
+gboolean edgefirst_zenoh_dmabuf_seal (gint fd, GError **error);
+
+/**
+ * edgefirst_zenoh_dmabuf_attachment:
+ *
+ * A pid is only meaningful on the host that sent it, so DmaBuffer samples
+ * carry the boot id of the publisher's kernel as the Zenoh attachment
+ * "edgefirst-host=<boot id>".
+ *
+ * Returns: (transfer none) (nullable): the attachment for samples published
+ *   from this host, or %NULL if the boot id cannot be read
+ */
+const gchar *edgefirst_zenoh_dmabuf_attachment (void);
+
+/**
+ * edgefirst_zenoh_dmabuf_attachment_is_local:
+ * @str: (nullable): attachment text, not necessarily nul-terminated
+ * @len: length of @str
+ *
+ * Returns: %TRUE if @str is edgefirst_zenoh_dmabuf_attachment() of this host
+ */
+gboolean edgefirst_zenoh_dmabuf_attachment_is_local (const gchar *str,
+    gsize len);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_DMABUF_H__ */
@@ -0,0 +1,313 @@
+/*
+ * EdgeFirst Perception for GStreamer - CDR Message Encoders
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-encode.h"
+#include <string.h>
+
+static const guint8 cdr_le_header[4] = { 0x00, 0x01, 0x00, 0x00 };
+
+void
+edgefirst_zenoh_cdr_writer_init (EdgefirstZenohCdrWriter *w, guint8 *data,
+    gboolean defer_payload)
+{
+  w->data = data;
+  w->len = 0;
+  w->defer_payload = defer_payload;
+  w->payload = NULL;
+  w->payload_off = 0;
+  w->payload_len = 0;
+}
+
+static inline void
+cdr_write_bytes (EdgefirstZenohCdrWriter *w, const void *v, size_t n)
+{
+  if (w->data && n)
+    memcpy (w->data + w->len - w->payload_len, v, n);
+  w->len += n;
+}
+
+/* Alignment is relative to the end of the encapsulation header */
+static inline void
+cdr_pad_to (EdgefirstZenohCdrWriter *w, size_t align)
+{
+  static const guint8 zeros[8] = { 0 };
+  size_t pad = (align - ((w->len - sizeof (cdr_le_header)) % align)) % align;
+
+  cdr_write_bytes (w, zeros, pad);
+}
+
+/* Bulk sequence contents (points, cube, pixels); at most one per message */
+static inline void
+cdr_write_payload (EdgefirstZenohCdrWriter *w, const guint8 *v, size_t n)
+{
+  if (!w->defer_payload) {
+    cdr_write_bytes (w, v, n);
+    return;
+  }
+
+  w->payload = v;
+  w->payload_off = w->len;
+  w->payload_len = n;
+  w->len += n;
+}
+
+static inline void
+cdr_write_u8 (EdgefirstZenohCdrWriter *w, guint8 v)
+{
+  cdr_write_bytes (w, &v, 1);
+}
+
+static inline void
+cdr_write_u16 (EdgefirstZenohCdrWriter *w, guint16 v)
+{
+  cdr_pad_to (w, 2);
+  cdr_write_bytes (w, &v, 2);
+}
+
+static inline void
+cdr_write_i32 (EdgefirstZenohCdrWriter *w, gint32 v)
+{
+  cdr_pad_to (w, 4);
+  cdr_write_bytes (w, &v, 4);
+}
+
+static inline void
+cdr_write_u32 (EdgefirstZenohCdrWriter *w, guint32 v)
+{
+  cdr_pad_to (w, 4);
+  cdr_write_bytes (w, &v, 4);
+}
+
+static inline void
+cdr_write_f32 (EdgefirstZenohCdrWriter *w, gfloat v)
+{
+  cdr_pad_to (w, 4);
+  cdr_write_bytes (w, &v, 4);
+}
+
+static inline void
+cdr_write_u64 (EdgefirstZenohCdrWriter *w, guint64 v)
+{
+  cdr_pad_to (w, 8);
+  cdr_write_bytes (w, &v, 8);
+}
+
+static inline void
+cdr_write_string (EdgefirstZenohCdrWriter *w, const char *s)
+{
+  guint32 len = (guint32) strlen (s ? s : "") + 1;   /* includes null */
+  cdr_write_u32 (w, len);
+  cdr_write_bytes (w, s ? s : "", len);
+}
+
+static inline void
+cdr_write_header (EdgefirstZenohCdrWriter *w, int32_t stamp_sec,
+    uint32_t stamp_nanosec, const char *frame_id)
+{
+  cdr_write_bytes (w, cdr_le_header, sizeof (cdr_le_header));
+  cdr_write_i32 (w, stamp_sec);
+  cdr_write_u32 (w, stamp_nanosec);
+  cdr_write_string (w, frame_id);
+}
+
+/* ── Message encoders ──────────────────────────────────────────────── */
+
+/* sensor_msgs/PointCloud2 */
+void
+edgefirst_zenoh_encode_pointcloud2 (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg)
+{
+  const EdgefirstZenohPointCloud2Msg *m = msg;
+
+  cdr_write_header (w, m->stamp_sec, m->stamp_nanosec, m->frame_id);
+
+  cdr_write_u32 (w, m->height);
+  cdr_write_u32 (w, m->width);
+
+  /* fields: sequence<PointField> */
+  cdr_write_u32 (w, m->num_fields);
+  for (guint i = 0; i < m->num_fields; i++) {
+    cdr_write_string (w, m->fields[i].name);
+    cdr_write_u32 (w, m->fields[i].offset);
+    cdr_write_u8 (w, (guint8) m->fields[i].datatype);
+    cdr_write_u32 (w, m->fields[i].count);
+  }
+
+  cdr_write_u8 (w, m->is_bigendian ? 1 : 0);
+  cdr_write_u32 (w, m->point_step);
+  cdr_write_u32 (w, m->row_step);
+
+  /* data: sequence<uint8> */
+  cdr_write_u32 (w, (guint32) m->data_len);
+  cdr_write_payload (w, m->data, m->data_len);
+
+  cdr_write_u8 (w, m->is_dense ? 1 : 0);
+}
+
+/* edgefirst_msgs/RadarCube.
+ * Field order: Header (stamp, frame_id), timestamp, layout[], shape[],
+ * scales[], cube[], is_complex. */
+void
+edgefirst_zenoh_encode_radarcube (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg)
+{
+  const EdgefirstZenohRadarCubeMsg *m = msg;
+
+  cdr_write_header (w, m->stamp_sec, m->stamp_nanosec, m->frame_id);
+
+  /* timestamp (uint64, 8-byte aligned) */
+  cdr_write_u64 (w, m->timestamp);
+
+  /* layout: sequence<uint8> */
+  cdr_write_u32 (w, m->layout_len);
+  cdr_write_bytes (w, m->layout, m->layout_len);
+
+  /* shape: sequence<uint16> */
+  cdr_write_u32 (w, m->shape_len);
+  for (guint i = 0; i < m->shape_len; i++)
+    cdr_write_u16 (w, m->shape[i]);
+
+  /* scales: sequence<float32> */
+  cdr_write_u32 (w, m->scales_len);
+  for (guint i = 0; i < m->scales_len; i++)
+    cdr_write_f32 (w, m->scales[i]);
+
+  /* cube: sequence<int16> (element count + int16 bytes) */
+  cdr_write_u32 (w, m->cube_len);
+  cdr_write_payload (w, (const guint8 *) m->cube,
+      m->cube_len * sizeof (gint16));
+
+  /* is_complex */
+  cdr_write_u8 (w, m->is_complex ? 1 : 0);
+}
+
+/* sensor_msgs/Image */
+void
+edgefirst_zenoh_encode_image (EdgefirstZenohCdrWriter *w, gconstpointer msg)
+{
+  const EdgefirstZenohImageMsg *m = msg;
+
+  cdr_write_header (w, m->stamp_sec, m->stamp_nanosec, m->frame_id);
+
+  cdr_write_u32 (w, m->height);
+  cdr_write_u32 (w, m->width);
+  cdr_write_string (w, m->encoding);
+  cdr_write_u8 (w, m->is_bigendian ? 1 : 0);
+  cdr_write_u32 (w, m->step);
+
+  /* data: sequence<uint8> */
+  cdr_write_u32 (w, (guint32) m->data_len);
+  cdr_write_payload (w, m->data, m->data_len);
+}
+
+/* builtin_interfaces/Time from nanoseconds */
+static inline void
+cdr_write_time (EdgefirstZenohCdrWriter *w, guint64 ns)
+{
+  cdr_write_i32 (w, (gint32) (ns / G_GUINT64_CONSTANT (1000000000)));
+  cdr_write_u32 (w, (guint32) (ns % G_GUINT64_CONSTANT (1000000000)));
+}
+
+/* edgefirst_msgs/Detect.
+ * Field order: Header, input_timestamp, model_time, output_time, boxes[].
+ * Each Box is center_x, center_y, width, height, label, score, distance,
+ * speed and a DetectTrack (id, lifetime, created). */
+void
+edgefirst_zenoh_encode_detect (EdgefirstZenohCdrWriter *w, gconstpointer msg)
+{
+  const EdgefirstZenohDetectMsg *m = msg;
+
+  cdr_write_header (w, m->stamp_sec, m->stamp_nanosec, m->frame_id);
+  cdr_write_time (w, m->input_timestamp);
+  cdr_write_time (w, m->model_time);
+  cdr_write_time (w, m->output_time);
+
+  cdr_write_u32 (w, m->num_boxes);
+  for (guint i = 0; i < m->num_boxes; i++) {
+    const EdgeFirstDetectBox *b = &m->boxes[i].box;
+
+    cdr_write_f32 (w, (b->x1 + b->x2) * 0.5f);
+    cdr_write_f32 (w, (b->y1 + b->y2) * 0.5f);
+    cdr_write_f32 (w, b->x2 - b->x1);
+    cdr_write_f32 (w, b->y2 - b->y1);
+    cdr_write_string (w, m->boxes[i].label);
+    cdr_write_f32 (w, b->score);
+    cdr_write_f32 (w, 0.0f);    /* distance */
+    cdr_write_f32 (w, 0.0f);    /* speed */
+    cdr_write_string (w, m->boxes[i].track_id);
+    cdr_write_i32 (w, 0);       /* lifetime */
+    cdr_write_time (w, 0);      /* created */
+  }
+}
+
+gboolean
+edgefirst_zenoh_detect_msg_init (EdgefirstZenohDetectMsg *msg, GArray *boxes,
+    GstBuffer *buffer, guint64 output_time)
+{
+  EdgefirstDetectionMeta *meta;
+  guint n;
+
+  meta = edgefirst_buffer_get_detection_meta (buffer);
+  if (!meta)
+    return FALSE;
+
+  n = edgefirst_detect_box_list_get_length (meta->boxes);
+  g_array_set_size (boxes, n);
+  for (guint i = 0; i < n; i++) {
+    EdgefirstZenohDetectBoxMsg *entry =
+        &g_array_index (boxes, EdgefirstZenohDetectBoxMsg, i);
+    EdgeFirstDetectBox *box = edgefirst_detect_box_list_get (meta->boxes, i);
+
+    if (!box) {
+      n = i;
+      break;
+    }
+    entry->box = *box;
+    g_snprintf (entry->label, sizeof (entry->label), "%d", box->class_id);
+    if (box->track_id >= 0)
+      g_snprintf (entry->track_id, sizeof (entry->track_id),
+          "%" G_GINT64_FORMAT, box->track_id);
+    else
+      entry->track_id[0] = '\0';
+    edgefirst_detect_box_free (box);
+  }
+
+  memset (msg, 0, sizeof (*msg));
+  msg->output_time = output_time;
+  msg->input_timestamp = meta->input_timestamp ?
+      meta->input_timestamp : output_time;
+  msg->model_time = meta->model_time_ns;
+  msg->stamp_sec =
+      (int32_t) (msg->input_timestamp / G_GUINT64_CONSTANT (1000000000));
+  msg->stamp_nanosec =
+      (uint32_t) (msg->input_timestamp % G_GUINT64_CONSTANT (1000000000));
+  msg->frame_id = meta->frame_id;
+  msg->boxes = (const EdgefirstZenohDetectBoxMsg *) boxes->data;
+  msg->num_boxes = n;
+
+  return TRUE;
+}
+
+/* edgefirst_msgs/DmaBuffer */
+void
+edgefirst_zenoh_encode_dmabuffer (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg)
+{
+  const EdgefirstZenohDmaBufferMsg *m = msg;
+
+  cdr_write_header (w, m->stamp_sec, m->stamp_nanosec, m->frame_id);
+  cdr_write_u32 (w, m->pid);
+  cdr_write_i32 (w, m->fd);
+  cdr_write_u32 (w, m->width);
+  cdr_write_u32 (w, m->height);
+  cdr_write_u32 (w, m->stride);
+  cdr_write_u32 (w, m->fourcc);
+  cdr_write_u32 (w, m->length);
+}
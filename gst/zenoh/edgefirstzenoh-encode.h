@@ -0,0 +1,172 @@
+/*
+ * EdgeFirst Perception for GStreamer - CDR Message Encoders
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_ENCODE_H__
+#define __EDGEFIRST_ZENOH_ENCODE_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirstdetection.h>
+#include <gst/edgefirst/edgefirstdetectionmeta.h>
+#include <gst/edgefirst/edgefirstpointcloud2meta.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstZenohCdrWriter:
+ *
+ * Writes CDR into a caller-provided buffer.  With data == NULL nothing is
+ * written and only len advances, so the same encoder first sizes a message
+ * and then fills a buffer of exactly that size.
+ *
+ * With defer_payload the bulk sequence of a message (points, cube, pixels)
+ * is not stored: data then only receives the header before it and the
+ * trailer after it, and the payload is attached to the Zenoh message by
+ * reference.
+ */
+typedef struct {
+  guint8 *data;
+  size_t len;               /* message length so far, including payload */
+  gboolean defer_payload;
+  const guint8 *payload;    /* deferred payload */
+  size_t payload_off;       /* message offset of the deferred payload */
+  size_t payload_len;       /* bytes of len not stored in data */
+} EdgefirstZenohCdrWriter;
+
+/**
+ * edgefirst_zenoh_cdr_writer_init:
+ * @w: the writer
+ * @data: (nullable): output, or %NULL to only size the message
+ * @defer_payload: whether to leave the bulk payload out of @data
+ */
+void edgefirst_zenoh_cdr_writer_init (EdgefirstZenohCdrWriter *w,
+    guint8 *data, gboolean defer_payload);
+
+/* One edgefirst_msgs/Box with its strings rendered */
+typedef struct {
+  EdgeFirstDetectBox box;
+  gchar label[12];          /* class index as decimal */
+  gchar track_id[24];       /* empty when not tracked */
+} EdgefirstZenohDetectBoxMsg;
+
+typedef struct {
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+  const char *frame_id;
+  uint32_t height;
+  uint32_t width;
+  uint32_t point_step;
+  uint32_t row_step;
+  const EdgefirstPointFieldDesc *fields;
+  guint num_fields;
+  gboolean is_bigendian;
+  gboolean is_dense;
+  const uint8_t *data;
+  size_t data_len;
+} EdgefirstZenohPointCloud2Msg;
+
+typedef struct {
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+  const char *frame_id;
+  guint64 timestamp;
+  const guint8 *layout;
+  guint layout_len;
+  const guint16 *shape;
+  guint shape_len;
+  const gfloat *scales;
+  guint scales_len;
+  const gint16 *cube;
+  guint cube_len;
+  gboolean is_complex;
+} EdgefirstZenohRadarCubeMsg;
+
+typedef struct {
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+  const char *frame_id;
+  uint32_t height;
+  uint32_t width;
+  const char *encoding;
+  gboolean is_bigendian;
+  uint32_t step;
+  const uint8_t *data;
+  size_t data_len;
+} EdgefirstZenohImageMsg;
+
+typedef struct {
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+  const char *frame_id;
+  guint64 input_timestamp;
+  guint64 model_time;
+  guint64 output_time;
+  const EdgefirstZenohDetectBoxMsg *boxes;
+  guint num_boxes;
+} EdgefirstZenohDetectMsg;
+
+typedef struct {
+  int32_t stamp_sec;
+  uint32_t stamp_nanosec;
+  const char *frame_id;
+  uint32_t pid;
+  int32_t fd;
+  uint32_t width;
+  uint32_t height;
+  uint32_t stride;
+  uint32_t fourcc;
+  uint32_t length;
+} EdgefirstZenohDmaBufferMsg;
+
+/**
+ * EdgefirstZenohEncodeFunc:
+ * @w: the writer
+ * @msg: the message, of the type the function encodes
+ *
+ * Encodes @msg into @w.  Encoders are pure: run twice on the same message,
+ * first with a sizing writer, they produce the same length.
+ */
+typedef void (*EdgefirstZenohEncodeFunc) (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+/**
+ * edgefirst_zenoh_detect_msg_init:
+ * @msg: (out): the message
+ * @boxes: #GArray of #EdgefirstZenohDetectBoxMsg, reused across messages
+ * @buffer: a buffer
+ * @output_time: output_time of the message, in nanoseconds since the epoch
+ *
+ * Fills @msg from the #EdgefirstDetectionMeta of @buffer.  @msg points into
+ * @boxes and the meta, so it is valid while both are unchanged.
+ *
+ * Returns: %FALSE if @buffer has no #EdgefirstDetectionMeta, in which case
+ *   there is nothing to publish
+ */
+gboolean edgefirst_zenoh_detect_msg_init (EdgefirstZenohDetectMsg *msg,
+    GArray *boxes, GstBuffer *buffer, guint64 output_time);
+
+/* sensor_msgs/PointCloud2, msg is an #EdgefirstZenohPointCloud2Msg */
+void edgefirst_zenoh_encode_pointcloud2 (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+/* edgefirst_msgs/RadarCube, msg is an #EdgefirstZenohRadarCubeMsg */
+void edgefirst_zenoh_encode_radarcube (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+/* sensor_msgs/Image, msg is an #EdgefirstZenohImageMsg */
+void edgefirst_zenoh_encode_image (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+/* edgefirst_msgs/Detect, msg is an #EdgefirstZenohDetectMsg */
+void edgefirst_zenoh_encode_detect (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+/* edgefirst_msgs/DmaBuffer, msg is an #EdgefirstZenohDmaBufferMsg */
+void edgefirst_zenoh_encode_dmabuffer (EdgefirstZenohCdrWriter *w,
+    gconstpointer msg);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_ENCODE_H__ */
@@ -20,6 +20,7 @@ edgefirst_zenoh_sub_message_type_get_type (void)
       { EDGEFIRST_ZENOH_MSG_IMAGE, "EDGEFIRST_ZENOH_MSG_IMAGE", "image" },
       { EDGEFIRST_ZENOH_MSG_CAMERA_INFO, "EDGEFIRST_ZENOH_MSG_CAMERA_INFO", "camera-info" },
       { EDGEFIRST_ZENOH_MSG_TRANSFORM, "EDGEFIRST_ZENOH_MSG_TRANSFORM", "transform" },
+      { EDGEFIRST_ZENOH_MSG_DMABUFFER, "EDGEFIRST_ZENOH_MSG_DMABUFFER", "dmabuffer" },
       { 0, NULL, NULL },
     };
     GType _type = g_enum_register_static ("EdgefirstZenohSubMessageType", values);
@@ -28,6 +29,42 @@ edgefirst_zenoh_sub_message_type_get_type (void)
   return type;
 }
 
+GType
+edgefirst_zenoh_sub_leaky_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_SUB_LEAKY_NONE, "EDGEFIRST_ZENOH_SUB_LEAKY_NONE", "none" },
+      { EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM, "EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM", "upstream" },
+      { EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM, "EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM", "downstream" },
+      { EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY, "EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY", "latest-only" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohSubLeaky", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+GType
+edgefirst_zenoh_sub_timestamp_mode_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL, "EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL", "arrival" },
+      { EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR, "EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR", "sensor" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohSubTimestampMode", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
 GType
 edgefirst_zenoh_pub_message_type_get_type (void)
 {
@@ -39,6 +76,7 @@ edgefirst_zenoh_pub_message_type_get_type (void)
       { EDGEFIRST_ZENOH_PUB_RADARCUBE, "EDGEFIRST_ZENOH_PUB_RADARCUBE", "radarcube" },
       { EDGEFIRST_ZENOH_PUB_IMAGE, "EDGEFIRST_ZENOH_PUB_IMAGE", "image" },
       { EDGEFIRST_ZENOH_PUB_DMABUFFER, "EDGEFIRST_ZENOH_PUB_DMABUFFER", "dmabuffer" },
+      { EDGEFIRST_ZENOH_PUB_DETECT, "EDGEFIRST_ZENOH_PUB_DETECT", "detect" },
       { 0, NULL, NULL },
     };
     GType _type = g_enum_register_static ("EdgefirstZenohPubMessageType", values);
@@ -46,3 +84,78 @@ edgefirst_zenoh_pub_message_type_get_type (void)
   }
   return type;
 }
+
+GType
+edgefirst_zenoh_pub_congestion_control_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_PUB_CONGESTION_DROP, "EDGEFIRST_ZENOH_PUB_CONGESTION_DROP", "drop" },
+      { EDGEFIRST_ZENOH_PUB_CONGESTION_BLOCK, "EDGEFIRST_ZENOH_PUB_CONGESTION_BLOCK", "block" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohPubCongestionControl", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+GType
+edgefirst_zenoh_pub_priority_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_REAL_TIME, "EDGEFIRST_ZENOH_PUB_PRIORITY_REAL_TIME", "real-time" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_HIGH, "EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_HIGH", "interactive-high" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_LOW, "EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_LOW", "interactive-low" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_HIGH, "EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_HIGH", "data-high" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_DATA, "EDGEFIRST_ZENOH_PUB_PRIORITY_DATA", "data" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_LOW, "EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_LOW", "data-low" },
+      { EDGEFIRST_ZENOH_PUB_PRIORITY_BACKGROUND, "EDGEFIRST_ZENOH_PUB_PRIORITY_BACKGROUND", "background" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohPubPriority", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+GType
+edgefirst_zenoh_pub_publish_when_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_PUB_PUBLISH_ALWAYS, "EDGEFIRST_ZENOH_PUB_PUBLISH_ALWAYS", "always" },
+      { EDGEFIRST_ZENOH_PUB_PUBLISH_MATCHED, "EDGEFIRST_ZENOH_PUB_PUBLISH_MATCHED", "matched" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohPubPublishWhen", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+GType
+edgefirst_zenoh_pub_compression_get_type (void)
+{
+  static GType type = 0;
+
+  if (g_once_init_enter (&type)) {
+    static const GEnumValue values[] = {
+      { EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE, "EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE", "none" },
+      { EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4, "EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4", "lz4" },
+      { EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD, "EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD", "zstd" },
+      { EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD, "EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD", "quantized-zstd" },
+      { 0, NULL, NULL },
+    };
+    GType _type = g_enum_register_static ("EdgefirstZenohPubCompression", values);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
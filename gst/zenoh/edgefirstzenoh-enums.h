@@ -14,9 +14,27 @@ G_BEGIN_DECLS
 GType edgefirst_zenoh_sub_message_type_get_type (void);
 #define EDGEFIRST_TYPE_ZENOH_SUB_MESSAGE_TYPE (edgefirst_zenoh_sub_message_type_get_type())
 
+GType edgefirst_zenoh_sub_leaky_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_SUB_LEAKY (edgefirst_zenoh_sub_leaky_get_type())
+
+GType edgefirst_zenoh_sub_timestamp_mode_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_SUB_TIMESTAMP_MODE (edgefirst_zenoh_sub_timestamp_mode_get_type())
+
 GType edgefirst_zenoh_pub_message_type_get_type (void);
 #define EDGEFIRST_TYPE_ZENOH_PUB_MESSAGE_TYPE (edgefirst_zenoh_pub_message_type_get_type())
 
+GType edgefirst_zenoh_pub_congestion_control_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_PUB_CONGESTION_CONTROL (edgefirst_zenoh_pub_congestion_control_get_type())
+
+GType edgefirst_zenoh_pub_priority_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_PUB_PRIORITY (edgefirst_zenoh_pub_priority_get_type())
+
+GType edgefirst_zenoh_pub_publish_when_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_PUB_PUBLISH_WHEN (edgefirst_zenoh_pub_publish_when_get_type())
+
+GType edgefirst_zenoh_pub_compression_get_type (void);
+#define EDGEFIRST_TYPE_ZENOH_PUB_COMPRESSION (edgefirst_zenoh_pub_compression_get_type())
+
 G_END_DECLS
 
 #endif /* __EDGEFIRST_ZENOH_ENUMS_H__ */
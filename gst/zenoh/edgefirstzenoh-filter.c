@@ -0,0 +1,93 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Header Filters
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-filter.h"
+
+void
+edgefirst_zenoh_header_filter_init (EdgefirstZenohHeaderFilter *filter)
+{
+  filter->max_age = 0;
+  filter->min_interval = 0;
+  filter->frame_ids = NULL;
+  filter->last_stamps = g_hash_table_new_full (g_str_hash, g_str_equal,
+      g_free, g_free);
+  filter->key = g_string_new (NULL);
+}
+
+void
+edgefirst_zenoh_header_filter_clear (EdgefirstZenohHeaderFilter *filter)
+{
+  g_clear_pointer (&filter->frame_ids, g_strfreev);
+  g_clear_pointer (&filter->last_stamps, g_hash_table_unref);
+  if (filter->key) {
+    g_string_free (filter->key, TRUE);
+    filter->key = NULL;
+  }
+}
+
+void
+edgefirst_zenoh_header_filter_set_frame_ids (EdgefirstZenohHeaderFilter *filter,
+    const gchar *frame_ids)
+{
+  g_strfreev (filter->frame_ids);
+  filter->frame_ids = frame_ids && frame_ids[0] ?
+      g_strsplit (frame_ids, ",", -1) : NULL;
+  for (guint i = 0; filter->frame_ids && filter->frame_ids[i]; i++)
+    g_strstrip (filter->frame_ids[i]);
+}
+
+void
+edgefirst_zenoh_header_filter_reset (EdgefirstZenohHeaderFilter *filter)
+{
+  g_hash_table_remove_all (filter->last_stamps);
+}
+
+gboolean
+edgefirst_zenoh_header_filter_accept (EdgefirstZenohHeaderFilter *filter,
+    const gchar *stream, gsize stream_len, const EdgefirstCdrHeader *header,
+    guint64 now)
+{
+  guint64 stamp, *last;
+
+  if (filter->frame_ids && !g_strv_contains (
+          (const gchar * const *) filter->frame_ids, header->frame_id))
+    return FALSE;
+
+  stamp = edgefirst_cdr_header_get_timestamp_ns (header);
+  if (stamp == 0)
+    return TRUE;
+
+  if (filter->max_age > 0 && now > stamp &&
+      now - stamp > (guint64) filter->max_age * GST_MSECOND)
+    return FALSE;
+
+  if (filter->min_interval > 0) {
+    /* Key expressions cannot contain '#', so it separates the two */
+    g_string_truncate (filter->key, 0);
+    if (stream)
+      g_string_append_len (filter->key, stream, (gssize) stream_len);
+    g_string_append_c (filter->key, '#');
+    g_string_append (filter->key, header->frame_id);
+
+    last = g_hash_table_lookup (filter->last_stamps, filter->key->str);
+    if (!last) {
+      last = g_new (guint64, 1);
+      g_hash_table_insert (filter->last_stamps,
+          g_strdup (filter->key->str), last);
+    } else if (stamp >= *last &&
+        stamp - *last < (guint64) filter->min_interval * GST_MSECOND) {
+      return FALSE;
+    }
+    /* A stamp going backwards restarts the interval */
+    *last = stamp;
+  }
+
+  return TRUE;
+}
@@ -0,0 +1,78 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Header Filters
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_FILTER_H__
+#define __EDGEFIRST_ZENOH_FILTER_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstZenohHeaderFilter:
+ * @max_age: drop samples stamped more than this many ms ago, 0 = off
+ * @min_interval: drop samples stamped less than this many ms after the
+ *   last accepted one of their stream and frame_id, 0 = off
+ * @frame_ids: frame_id values to accept, %NULL = any
+ *
+ * Filters applied to the CDR header of a sample on arrival, before it is
+ * queued, so rejected samples neither take a queue slot nor evict wanted
+ * ones.  The settings may be changed between calls; the min-interval
+ * state is private.  The owner serializes all access.
+ */
+typedef struct {
+  guint max_age;
+  guint min_interval;
+  gchar **frame_ids;
+
+  /*< private >*/
+  GHashTable *last_stamps;  /* stream and frame_id → guint64 stamp */
+  GString *key;
+} EdgefirstZenohHeaderFilter;
+
+void edgefirst_zenoh_header_filter_init (EdgefirstZenohHeaderFilter *filter);
+void edgefirst_zenoh_header_filter_clear (EdgefirstZenohHeaderFilter *filter);
+
+/**
+ * edgefirst_zenoh_header_filter_set_frame_ids:
+ * @filter: an #EdgefirstZenohHeaderFilter
+ * @frame_ids: (nullable): comma-separated frame_id values, %NULL or empty
+ *   for any
+ */
+void edgefirst_zenoh_header_filter_set_frame_ids (
+    EdgefirstZenohHeaderFilter *filter, const gchar *frame_ids);
+
+/**
+ * edgefirst_zenoh_header_filter_reset:
+ * @filter: an #EdgefirstZenohHeaderFilter
+ *
+ * Forgets the last accepted stamps, so min-interval starts over.
+ */
+void edgefirst_zenoh_header_filter_reset (EdgefirstZenohHeaderFilter *filter);
+
+/**
+ * edgefirst_zenoh_header_filter_accept:
+ * @filter: an #EdgefirstZenohHeaderFilter
+ * @stream: (nullable): stream the sample belongs to, for elements with
+ *   several; min-interval is kept per stream and frame_id
+ * @stream_len: length of @stream
+ * @header: the sample's header
+ * @now: current wall-clock time in ns, which ROS stamps are in
+ *
+ * Decides from the header alone whether a sample is wanted.  A stamp going
+ * backwards (publisher restart, replay) restarts the min-interval.
+ * Samples without a stamp are only subject to the frame_id filter.
+ *
+ * Returns: %TRUE if the sample passes every filter
+ */
+gboolean edgefirst_zenoh_header_filter_accept (
+    EdgefirstZenohHeaderFilter *filter, const gchar *stream,
+    gsize stream_len, const EdgefirstCdrHeader *header, guint64 now);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_FILTER_H__ */
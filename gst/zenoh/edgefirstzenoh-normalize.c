@@ -0,0 +1,521 @@
+/*
+ * EdgeFirst Perception for GStreamer - Point Layout Normalization
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-normalize.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static const EdgefirstPointFieldDesc *
+find_field (const EdgefirstPointFieldDesc *fields, guint num_fields,
+    const gchar *name)
+{
+  for (guint i = 0; i < num_fields; i++) {
+    if (fields[i].count == 1 && strcmp (fields[i].name, name) == 0)
+      return &fields[i];
+  }
+  return NULL;
+}
+
+gboolean
+edgefirst_zenoh_point_layout_init (EdgefirstZenohPointLayout *layout,
+    const EdgefirstPointFieldDesc *fields, guint num_fields, guint point_step,
+    gboolean is_bigendian)
+{
+  static const gchar *const names[3] = { "x", "y", "z" };
+  const EdgefirstPointFieldDesc *field;
+  guint size;
+
+  memset (layout, 0, sizeof (*layout));
+  if (point_step == 0 || point_step > EDGEFIRST_ZENOH_POINT_STEP_MAX)
+    return FALSE;
+
+  layout->point_step = point_step;
+  layout->swap = is_bigendian != (G_BYTE_ORDER == G_BIG_ENDIAN);
+
+  for (guint axis = 0; axis < 3; axis++) {
+    field = find_field (fields, num_fields, names[axis]);
+    if (!field || (field->datatype != EDGEFIRST_POINT_FIELD_FLOAT32 &&
+            field->datatype != EDGEFIRST_POINT_FIELD_FLOAT64))
+      return FALSE;
+    if (axis > 0 && field->datatype != layout->xyz_type)
+      return FALSE;
+    layout->xyz_type = field->datatype;
+    layout->xyz[axis] = field->offset;
+  }
+
+  size = edgefirst_point_field_datatype_size (layout->xyz_type);
+  for (guint axis = 0; axis < 3; axis++) {
+    if (layout->xyz[axis] + size > point_step)
+      return FALSE;
+  }
+  layout->packed_xyz = layout->xyz[1] == layout->xyz[0] + size &&
+      layout->xyz[2] == layout->xyz[1] + size;
+
+  field = find_field (fields, num_fields, "intensity");
+  if (field && field->datatype != 0 && field->offset +
+      edgefirst_point_field_datatype_size (field->datatype) <= point_step) {
+    layout->intensity_type = field->datatype;
+    layout->intensity = field->offset;
+  }
+
+  return TRUE;
+}
+
+gboolean
+edgefirst_zenoh_point_layout_is_normalized (
+    const EdgefirstZenohPointLayout *layout)
+{
+  return layout->point_step == EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP &&
+      !layout->swap &&
+      layout->xyz_type == EDGEFIRST_POINT_FIELD_FLOAT32 &&
+      layout->xyz[0] == 0 && layout->packed_xyz &&
+      layout->intensity_type == EDGEFIRST_POINT_FIELD_FLOAT32 &&
+      layout->intensity == 12;
+}
+
+/* ── Scalar kernel ─────────────────────────────────────────────────── */
+
+static inline gfloat
+read_f32 (const guint8 *p, gboolean swap)
+{
+  guint32 u;
+  gfloat v;
+
+  memcpy (&u, p, sizeof (u));
+  if (swap)
+    u = GUINT32_SWAP_LE_BE (u);
+  memcpy (&v, &u, sizeof (v));
+  return v;
+}
+
+static inline gfloat
+read_f64 (const guint8 *p, gboolean swap)
+{
+  guint64 u;
+  gdouble v;
+
+  memcpy (&u, p, sizeof (u));
+  if (swap)
+    u = GUINT64_SWAP_LE_BE (u);
+  memcpy (&v, &u, sizeof (v));
+  return (gfloat) v;
+}
+
+static inline gfloat
+read_intensity (const EdgefirstZenohPointLayout *layout, const guint8 *point)
+{
+  const guint8 *p = point + layout->intensity;
+  gboolean swap = layout->swap;
+  guint16 u16;
+  guint32 u32;
+
+  switch (layout->intensity_type) {
+    case EDGEFIRST_POINT_FIELD_FLOAT32:
+      return read_f32 (p, swap);
+    case EDGEFIRST_POINT_FIELD_FLOAT64:
+      return read_f64 (p, swap);
+    case EDGEFIRST_POINT_FIELD_INT8:
+      return (gint8) p[0];
+    case EDGEFIRST_POINT_FIELD_UINT8:
+      return p[0];
+    case EDGEFIRST_POINT_FIELD_INT16:
+    case EDGEFIRST_POINT_FIELD_UINT16:
+      memcpy (&u16, p, sizeof (u16));
+      if (swap)
+        u16 = GUINT16_SWAP_LE_BE (u16);
+      return layout->intensity_type == EDGEFIRST_POINT_FIELD_INT16 ?
+          (gfloat) (gint16) u16 : (gfloat) u16;
+    case EDGEFIRST_POINT_FIELD_INT32:
+    case EDGEFIRST_POINT_FIELD_UINT32:
+      memcpy (&u32, p, sizeof (u32));
+      if (swap)
+        u32 = GUINT32_SWAP_LE_BE (u32);
+      return layout->intensity_type == EDGEFIRST_POINT_FIELD_INT32 ?
+          (gfloat) (gint32) u32 : (gfloat) u32;
+    default:
+      return 0.0f;
+  }
+}
+
+static void
+normalize_scalar (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const gboolean f64 = layout->xyz_type == EDGEFIRST_POINT_FIELD_FLOAT64;
+
+  for (gsize i = 0; i < num_points; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    gfloat out[4];
+
+    for (guint axis = 0; axis < 3; axis++)
+      out[axis] = f64 ? read_f64 (s + layout->xyz[axis], layout->swap) :
+          read_f32 (s + layout->xyz[axis], layout->swap);
+    out[3] = read_intensity (layout, s);
+    memcpy (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP, out,
+        sizeof (out));
+  }
+}
+
+/* ── Vector kernels ────────────────────────────────────────────────── */
+
+/* Packed x/y/z are moved with one 128-bit load and store per point, with
+ * the byte swap and FLOAT64 narrowing done in vector registers.  The load
+ * runs past z into the rest of the point or the next one, so the last
+ * point is left to the scalar kernel.  Intensity of the x/y/z type right
+ * after z comes in with that load; FLOAT32 intensity elsewhere is loaded
+ * into lane 3.  Only integer and mixed-width intensities are converted
+ * one point at a time. */
+
+#if defined(HAVE_X86_DISPATCH) || defined(__ARM_NEON)
+typedef gsize (*NormalizeFunc) (const EdgefirstZenohPointLayout *layout,
+    guint8 *dst, const guint8 *src, gsize num_points);
+
+typedef enum {
+  INTENSITY_IN_LOAD,            /* lane 3 of the x/y/z load */
+  INTENSITY_LANE,               /* FLOAT32 loaded into lane 3 */
+  INTENSITY_NONE,               /* lane 3 cleared */
+  INTENSITY_CONVERT,            /* read_intensity () into lane 3 */
+} IntensityMode;
+
+static IntensityMode
+intensity_mode (const EdgefirstZenohPointLayout *layout)
+{
+  guint size = edgefirst_point_field_datatype_size (layout->xyz_type);
+
+  if (layout->intensity_type == 0)
+    return INTENSITY_NONE;
+  if (layout->intensity_type == layout->xyz_type &&
+      layout->intensity == layout->xyz[0] + 3 * size)
+    return INTENSITY_IN_LOAD;
+  if (layout->intensity_type == EDGEFIRST_POINT_FIELD_FLOAT32)
+    return INTENSITY_LANE;
+  return INTENSITY_CONVERT;
+}
+
+static inline guint32
+read_u32 (const guint8 *p, gboolean swap)
+{
+  guint32 u;
+
+  memcpy (&u, p, sizeof (u));
+  return swap ? GUINT32_SWAP_LE_BE (u) : u;
+}
+#endif
+
+/* ── x86 kernels ───────────────────────────────────────────────────── */
+
+#ifdef HAVE_X86_DISPATCH
+/* SSE2 has no byte shuffle: swap the bytes of each 16-bit word, then the
+ * words of each element */
+__attribute__ ((target ("sse2")))
+static inline __m128i
+bswap32_sse2 (__m128i v)
+{
+  v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+  v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+  return _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+}
+
+__attribute__ ((target ("sse2")))
+static inline __m128i
+bswap64_sse2 (__m128i v)
+{
+  v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+  v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+  return _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+}
+
+/* Lane 0 of @i into lane 3 of @v */
+__attribute__ ((target ("sse2")))
+static inline __m128
+set_lane3_sse2 (__m128 v, __m128 i)
+{
+  __m128 t = _mm_shuffle_ps (v, i, _MM_SHUFFLE (0, 0, 2, 2));
+
+  return _mm_shuffle_ps (v, t, _MM_SHUFFLE (2, 0, 1, 0));
+}
+
+__attribute__ ((target ("sse2")))
+static inline __m128
+set_intensity_sse2 (const EdgefirstZenohPointLayout *layout,
+    IntensityMode mode, const guint8 *s, __m128 v)
+{
+  switch (mode) {
+    case INTENSITY_IN_LOAD:
+      return v;
+    case INTENSITY_LANE:
+      return set_lane3_sse2 (v, _mm_castsi128_ps (_mm_cvtsi32_si128 ((gint)
+                  read_u32 (s + layout->intensity, layout->swap))));
+    case INTENSITY_NONE:
+      return _mm_and_ps (v,
+          _mm_castsi128_ps (_mm_set_epi32 (0, -1, -1, -1)));
+    default:
+      return set_lane3_sse2 (v, _mm_set_ss (read_intensity (layout, s)));
+  }
+}
+
+__attribute__ ((target ("sse2")))
+static gsize
+normalize_sse2_f32 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (s + layout->xyz[0]));
+
+    if (layout->swap)
+      v = bswap32_sse2 (v);
+    _mm_storeu_ps ((gfloat *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        set_intensity_sse2 (layout, mode, s, _mm_castsi128_ps (v)));
+  }
+  return n;
+}
+
+__attribute__ ((target ("sse2")))
+static gsize
+normalize_sse2_f64 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    __m128i xy = _mm_loadu_si128 ((const __m128i *) (s + layout->xyz[0]));
+    __m128i zw = _mm_loadu_si128 ((const __m128i *) (s + layout->xyz[0] + 16));
+    __m128 f;
+
+    if (layout->swap) {
+      xy = bswap64_sse2 (xy);
+      zw = bswap64_sse2 (zw);
+    }
+    f = _mm_movelh_ps (_mm_cvtpd_ps (_mm_castsi128_pd (xy)),
+        _mm_cvtpd_ps (_mm_castsi128_pd (zw)));
+    _mm_storeu_ps ((gfloat *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        set_intensity_sse2 (layout, mode, s, f));
+  }
+  return n;
+}
+
+__attribute__ ((target ("avx2")))
+static gsize
+normalize_avx2_f32 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  const __m128i swap32 = _mm_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+      15, 14, 13, 12);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (s + layout->xyz[0]));
+
+    if (layout->swap)
+      v = _mm_shuffle_epi8 (v, swap32);
+    _mm_storeu_ps ((gfloat *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        set_intensity_sse2 (layout, mode, s, _mm_castsi128_ps (v)));
+  }
+  return n;
+}
+
+/* One 256-bit load and vcvtpd2ps per point */
+__attribute__ ((target ("avx2")))
+static gsize
+normalize_avx2_f64 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  const __m256i swap64 = _mm256_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0,
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+      15, 14, 13, 12, 11, 10, 9, 8);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (s + layout->xyz[0]));
+
+    if (layout->swap)
+      v = _mm256_shuffle_epi8 (v, swap64);
+    _mm_storeu_ps ((gfloat *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        set_intensity_sse2 (layout, mode, s,
+            _mm256_cvtpd_ps (_mm256_castsi256_pd (v))));
+  }
+  return n;
+}
+#endif
+
+/* ── NEON kernels ──────────────────────────────────────────────────── */
+
+#if defined(__ARM_NEON)
+static gsize
+normalize_neon_f32 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    uint8x16_t v = vld1q_u8 (s + layout->xyz[0]);
+    float32x4_t f;
+
+    /* Swapped together with x/y/z */
+    if (mode == INTENSITY_LANE)
+      v = vreinterpretq_u8_u32 (vld1q_lane_u32 ((const uint32_t *) (s +
+                  layout->intensity), vreinterpretq_u32_u8 (v), 3));
+    if (layout->swap)
+      v = vrev32q_u8 (v);
+    f = vreinterpretq_f32_u8 (v);
+    if (mode == INTENSITY_NONE)
+      f = vsetq_lane_f32 (0.0f, f, 3);
+    else if (mode == INTENSITY_CONVERT)
+      f = vsetq_lane_f32 (read_intensity (layout, s), f, 3);
+    vst1q_f32 ((float32_t *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        f);
+  }
+  return n;
+}
+
+#if defined(__aarch64__)
+static gsize
+normalize_neon_f64 (const EdgefirstZenohPointLayout *layout, guint8 *dst,
+    const guint8 *src, gsize num_points)
+{
+  const IntensityMode mode = intensity_mode (layout);
+  gsize n = num_points > 0 ? num_points - 1 : 0;
+
+  for (gsize i = 0; i < n; i++) {
+    const guint8 *s = src + i * layout->point_step;
+    uint8x16_t xy = vld1q_u8 (s + layout->xyz[0]);
+    uint8x16_t zw = vld1q_u8 (s + layout->xyz[0] + 16);
+    float32x2_t lo, hi;
+    uint8x8_t iv;
+
+    if (layout->swap) {
+      xy = vrev64q_u8 (xy);
+      zw = vrev64q_u8 (zw);
+    }
+    lo = vcvt_f32_f64 (vreinterpretq_f64_u8 (xy));
+    hi = vcvt_f32_f64 (vreinterpretq_f64_u8 (zw));
+    switch (mode) {
+      case INTENSITY_IN_LOAD:
+        break;
+      case INTENSITY_LANE:
+        iv = vreinterpret_u8_u32 (vld1_dup_u32 ((const uint32_t *) (s +
+                    layout->intensity)));
+        if (layout->swap)
+          iv = vrev32_u8 (iv);
+        hi = vzip1_f32 (hi, vreinterpret_f32_u8 (iv));
+        break;
+      case INTENSITY_NONE:
+        hi = vset_lane_f32 (0.0f, hi, 1);
+        break;
+      default:
+        hi = vset_lane_f32 (read_intensity (layout, s), hi, 1);
+        break;
+    }
+    vst1q_f32 ((float32_t *) (dst + i * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP),
+        vcombine_f32 (lo, hi));
+  }
+  return n;
+}
+#endif
+#endif
+
+/* ── Dispatch ──────────────────────────────────────────────────────── */
+
+#if defined(HAVE_X86_DISPATCH) || defined(__ARM_NEON)
+typedef enum {
+  KERNEL_SCALAR = 1,
+  KERNEL_SSE2,
+  KERNEL_AVX2,
+  KERNEL_NEON,
+} Kernel;
+
+static Kernel
+detect_kernel (void)
+{
+  static gsize kernel = 0;
+
+  if (g_once_init_enter (&kernel)) {
+    Kernel best = KERNEL_SCALAR;
+
+#ifdef HAVE_X86_DISPATCH
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+      best = KERNEL_AVX2;
+    else if (__builtin_cpu_supports ("sse2"))
+      best = KERNEL_SSE2;
+#elif defined(__ARM_NEON)
+    best = KERNEL_NEON;
+#endif
+    g_once_init_leave (&kernel, best);
+  }
+  return (Kernel) kernel;
+}
+
+/* NULL when only the scalar kernel handles @layout */
+static NormalizeFunc
+select_kernel (const EdgefirstZenohPointLayout *layout)
+{
+  const gboolean f64 = layout->xyz_type == EDGEFIRST_POINT_FIELD_FLOAT64;
+
+  if (!layout->packed_xyz)
+    return NULL;
+
+  switch (detect_kernel ()) {
+#ifdef HAVE_X86_DISPATCH
+    case KERNEL_AVX2:
+      return f64 ? normalize_avx2_f64 : normalize_avx2_f32;
+    case KERNEL_SSE2:
+      return f64 ? normalize_sse2_f64 : normalize_sse2_f32;
+#endif
+#if defined(__ARM_NEON)
+    case KERNEL_NEON:
+#if defined(__aarch64__)
+      return f64 ? normalize_neon_f64 : normalize_neon_f32;
+#else
+      return f64 ? NULL : normalize_neon_f32;
+#endif
+#endif
+    default:
+      return NULL;
+  }
+}
+#endif
+
+void
+edgefirst_zenoh_normalize_points (const EdgefirstZenohPointLayout *layout,
+    guint8 *dst, const guint8 *src, gsize num_points)
+{
+  gsize done = 0;
+
+#if defined(HAVE_X86_DISPATCH) || defined(__ARM_NEON)
+  const NormalizeFunc normalize = select_kernel (layout);
+
+  if (normalize)
+    done = normalize (layout, dst, src, num_points);
+#endif
+
+  normalize_scalar (layout, dst + done * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP,
+      src + done * layout->point_step, num_points - done);
+}
@@ -0,0 +1,99 @@
+/*
+ * EdgeFirst Perception for GStreamer - Point Layout Normalization
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_NORMALIZE_H__
+#define __EDGEFIRST_ZENOH_NORMALIZE_H__
+
+#include <gst/gst.h>
+#include <gst/edgefirst/edgefirstpointcloud2meta.h>
+
+G_BEGIN_DECLS
+
+/**
+ * EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP:
+ *
+ * Bytes per point of the normalized layout: x, y, z and intensity as
+ * FLOAT32 in host byte order.
+ */
+#define EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP 16
+
+/**
+ * EDGEFIRST_ZENOH_NORMALIZED_FIELDS:
+ *
+ * The `fields` caps string of the normalized layout.
+ */
+#define EDGEFIRST_ZENOH_NORMALIZED_FIELDS \
+  "x:F32:0,y:F32:4,z:F32:8,intensity:F32:12"
+
+/**
+ * EDGEFIRST_ZENOH_POINT_STEP_MAX:
+ *
+ * Largest source point that can be normalized.
+ */
+#define EDGEFIRST_ZENOH_POINT_STEP_MAX 512
+
+/**
+ * EdgefirstZenohPointLayout:
+ * @point_step: bytes per source point
+ * @swap: source byte order differs from the host
+ * @xyz_type: FLOAT32 or FLOAT64
+ * @xyz: byte offsets of x, y and z
+ * @packed_xyz: y and z directly follow x
+ * @intensity_type: datatype of intensity, 0 when the cloud has none
+ * @intensity: byte offset of intensity
+ *
+ * Where the fields of the normalized layout are found in a source point.
+ */
+typedef struct {
+  guint point_step;
+  gboolean swap;
+  guint8 xyz_type;
+  guint xyz[3];
+  gboolean packed_xyz;
+  guint8 intensity_type;
+  guint intensity;
+} EdgefirstZenohPointLayout;
+
+/**
+ * edgefirst_zenoh_point_layout_init:
+ * @layout: (out): the source layout
+ * @fields: point fields of the source
+ * @num_fields: number of @fields
+ * @point_step: bytes per source point
+ * @is_bigendian: byte order of the source
+ *
+ * Returns: %TRUE if the source has FLOAT32 or FLOAT64 x, y and z and can be
+ *   normalized.  A missing intensity reads as 0.
+ */
+gboolean edgefirst_zenoh_point_layout_init (EdgefirstZenohPointLayout *layout,
+    const EdgefirstPointFieldDesc *fields, guint num_fields, guint point_step,
+    gboolean is_bigendian);
+
+/**
+ * edgefirst_zenoh_point_layout_is_normalized:
+ * @layout: a layout from edgefirst_zenoh_point_layout_init()
+ *
+ * Returns: %TRUE if points in @layout already have the normalized layout
+ */
+gboolean edgefirst_zenoh_point_layout_is_normalized (
+    const EdgefirstZenohPointLayout *layout);
+
+/**
+ * edgefirst_zenoh_normalize_points:
+ * @layout: source layout
+ * @dst: output, @num_points * %EDGEFIRST_ZENOH_NORMALIZED_POINT_STEP bytes
+ * @src: @num_points source points
+ * @num_points: number of points
+ *
+ * Converts points to the normalized layout, swapping bytes and narrowing
+ * FLOAT64 coordinates on the way.  Integer intensities keep their value.
+ */
+void edgefirst_zenoh_normalize_points (const EdgefirstZenohPointLayout *layout,
+    guint8 *dst, const guint8 *src, gsize num_points);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_NORMALIZE_H__ */
@@ -0,0 +1,161 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Pending Sample Queue
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-queue.h"
+#include <string.h>
+
+static inline gpointer
+queue_slot (EdgefirstZenohQueue *queue, guint i)
+{
+  return queue->items + (gsize) ((queue->head + i) % queue->depth) *
+      queue->item_size;
+}
+
+static void
+queue_drop_oldest (EdgefirstZenohQueue *queue)
+{
+  queue->clear_func (queue_slot (queue, 0));
+  queue->head = (queue->head + 1) % queue->depth;
+  queue->len--;
+  queue->dropped++;
+}
+
+void
+edgefirst_zenoh_queue_init (EdgefirstZenohQueue *queue, gsize item_size,
+    guint depth, EdgefirstZenohQueueClearFunc clear_func)
+{
+  g_return_if_fail (item_size > 0 && depth > 0 && clear_func != NULL);
+
+  queue->dropped = 0;
+  queue->high_water = 0;
+  queue->items = g_malloc_n (depth, item_size);
+  queue->item_size = item_size;
+  queue->depth = depth;
+  queue->head = 0;
+  queue->len = 0;
+  queue->clear_func = clear_func;
+  queue->leaky = EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM;
+  queue->blocking = FALSE;
+  g_cond_init (&queue->space_cond);
+}
+
+void
+edgefirst_zenoh_queue_clear (EdgefirstZenohQueue *queue)
+{
+  edgefirst_zenoh_queue_flush (queue);
+  g_clear_pointer (&queue->items, g_free);
+  g_cond_clear (&queue->space_cond);
+}
+
+void
+edgefirst_zenoh_queue_set_leaky (EdgefirstZenohQueue *queue,
+    EdgefirstZenohSubLeaky leaky)
+{
+  queue->leaky = leaky;
+  g_cond_broadcast (&queue->space_cond);
+}
+
+void
+edgefirst_zenoh_queue_set_blocking (EdgefirstZenohQueue *queue,
+    gboolean blocking)
+{
+  queue->blocking = blocking;
+  g_cond_broadcast (&queue->space_cond);
+}
+
+void
+edgefirst_zenoh_queue_resize (EdgefirstZenohQueue *queue, guint depth)
+{
+  guint8 *items;
+  guint i;
+
+  g_return_if_fail (depth > 0);
+
+  while (queue->len > depth)
+    queue_drop_oldest (queue);
+
+  items = g_malloc_n (depth, queue->item_size);
+  for (i = 0; i < queue->len; i++)
+    memcpy (items + (gsize) i * queue->item_size, queue_slot (queue, i),
+        queue->item_size);
+
+  g_free (queue->items);
+  queue->items = items;
+  queue->depth = depth;
+  queue->head = 0;
+  g_cond_broadcast (&queue->space_cond);
+}
+
+gpointer
+edgefirst_zenoh_queue_push (EdgefirstZenohQueue *queue, GMutex *lock)
+{
+  gpointer slot;
+
+  switch (queue->leaky) {
+    case EDGEFIRST_ZENOH_SUB_LEAKY_NONE:
+      while (queue->leaky == EDGEFIRST_ZENOH_SUB_LEAKY_NONE &&
+          queue->blocking && queue->len >= queue->depth)
+        g_cond_wait (&queue->space_cond, lock);
+      break;
+    case EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM:
+      if (queue->len >= queue->depth) {
+        queue->dropped++;
+        return NULL;
+      }
+      break;
+    case EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY:
+      while (queue->len > 0)
+        queue_drop_oldest (queue);
+      break;
+    case EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM:
+      break;
+  }
+
+  /* Also bounds leaky=none while it may not block */
+  if (queue->len >= queue->depth)
+    queue_drop_oldest (queue);
+
+  slot = queue_slot (queue, queue->len);
+  queue->len++;
+  queue->high_water = MAX (queue->high_water, queue->len);
+
+  return slot;
+}
+
+gboolean
+edgefirst_zenoh_queue_pop (EdgefirstZenohQueue *queue, gpointer out)
+{
+  if (queue->len == 0)
+    return FALSE;
+
+  memcpy (out, queue_slot (queue, 0), queue->item_size);
+  queue->head = (queue->head + 1) % queue->depth;
+  queue->len--;
+  g_cond_signal (&queue->space_cond);
+
+  return TRUE;
+}
+
+void
+edgefirst_zenoh_queue_flush (EdgefirstZenohQueue *queue)
+{
+  while (queue->len > 0) {
+    queue->clear_func (queue_slot (queue, 0));
+    queue->head = (queue->head + 1) % queue->depth;
+    queue->len--;
+  }
+  g_cond_broadcast (&queue->space_cond);
+}
+
+guint
+edgefirst_zenoh_queue_get_length (const EdgefirstZenohQueue *queue)
+{
+  return queue->len;
+}
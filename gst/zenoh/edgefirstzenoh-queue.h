@@ -0,0 +1,144 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Pending Sample Queue
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_QUEUE_H__
+#define __EDGEFIRST_ZENOH_QUEUE_H__
+
+#include <gst/gst.h>
+#include "edgefirstzenohsub.h"
+
+G_BEGIN_DECLS
+
+/**
+ * EdgefirstZenohQueueClearFunc:
+ * @item: an item leaving the queue without being popped
+ *
+ * Releases what @item holds.
+ */
+typedef void (*EdgefirstZenohQueueClearFunc) (gpointer item);
+
+/**
+ * EdgefirstZenohQueue:
+ * @dropped: items dropped by the leaky policy or a resize
+ * @high_water: most items ever pending at once
+ *
+ * Ring of preallocated items carrying received samples from the Zenoh
+ * callback to the streaming thread, so the callback does not allocate.
+ * What happens when it is full follows #EdgefirstZenohSubLeaky.  The owner
+ * serializes all calls with one mutex, which
+ * edgefirst_zenoh_queue_push() waits on under
+ * %EDGEFIRST_ZENOH_SUB_LEAKY_NONE.  The counters may be read and reset
+ * under that mutex.
+ */
+typedef struct {
+  guint64 dropped;
+  guint high_water;
+
+  /*< private >*/
+  guint8 *items;
+  gsize item_size;
+  guint depth;
+  guint head;
+  guint len;
+  EdgefirstZenohQueueClearFunc clear_func;
+  EdgefirstZenohSubLeaky leaky;
+  gboolean blocking;
+  GCond space_cond;
+} EdgefirstZenohQueue;
+
+/**
+ * edgefirst_zenoh_queue_init:
+ * @queue: an #EdgefirstZenohQueue
+ * @item_size: size of one item
+ * @depth: number of items, at least 1
+ * @clear_func: releases items that are dropped or flushed
+ *
+ * The queue starts empty, with %EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM and
+ * blocking off.
+ */
+void edgefirst_zenoh_queue_init (EdgefirstZenohQueue *queue, gsize item_size,
+    guint depth, EdgefirstZenohQueueClearFunc clear_func);
+
+/**
+ * edgefirst_zenoh_queue_clear:
+ * @queue: an #EdgefirstZenohQueue
+ *
+ * Flushes @queue and frees its storage.
+ */
+void edgefirst_zenoh_queue_clear (EdgefirstZenohQueue *queue);
+
+/**
+ * edgefirst_zenoh_queue_set_leaky:
+ * @queue: an #EdgefirstZenohQueue
+ * @leaky: what edgefirst_zenoh_queue_push() does when @queue is full
+ *
+ * Wakes a push waiting under the previous policy.
+ */
+void edgefirst_zenoh_queue_set_leaky (EdgefirstZenohQueue *queue,
+    EdgefirstZenohSubLeaky leaky);
+
+/**
+ * edgefirst_zenoh_queue_set_blocking:
+ * @queue: an #EdgefirstZenohQueue
+ * @blocking: whether %EDGEFIRST_ZENOH_SUB_LEAKY_NONE may wait for room
+ *
+ * Without blocking, a full queue under %EDGEFIRST_ZENOH_SUB_LEAKY_NONE
+ * drops its oldest item.  Turning blocking off wakes a waiting push.
+ */
+void edgefirst_zenoh_queue_set_blocking (EdgefirstZenohQueue *queue,
+    gboolean blocking);
+
+/**
+ * edgefirst_zenoh_queue_resize:
+ * @queue: an #EdgefirstZenohQueue
+ * @depth: new number of items, at least 1
+ *
+ * Keeps the newest items that fit, dropping the others.
+ */
+void edgefirst_zenoh_queue_resize (EdgefirstZenohQueue *queue, guint depth);
+
+/**
+ * edgefirst_zenoh_queue_push:
+ * @queue: an #EdgefirstZenohQueue
+ * @lock: the mutex serializing @queue, held by the caller
+ *
+ * Makes room for a new item following the leaky policy, waiting on @lock
+ * under %EDGEFIRST_ZENOH_SUB_LEAKY_NONE while blocking is on.
+ *
+ * Returns: (nullable): the slot of the new item, for the caller to fill,
+ *   or %NULL when %EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM drops it
+ */
+gpointer edgefirst_zenoh_queue_push (EdgefirstZenohQueue *queue,
+    GMutex *lock);
+
+/**
+ * edgefirst_zenoh_queue_pop:
+ * @queue: an #EdgefirstZenohQueue
+ * @out: where to move the oldest item
+ *
+ * Returns: %FALSE if @queue is empty
+ */
+gboolean edgefirst_zenoh_queue_pop (EdgefirstZenohQueue *queue, gpointer out);
+
+/**
+ * edgefirst_zenoh_queue_flush:
+ * @queue: an #EdgefirstZenohQueue
+ *
+ * Clears every pending item without counting it as dropped.
+ */
+void edgefirst_zenoh_queue_flush (EdgefirstZenohQueue *queue);
+
+/**
+ * edgefirst_zenoh_queue_get_length:
+ * @queue: an #EdgefirstZenohQueue
+ *
+ * Returns: the number of pending items
+ */
+guint edgefirst_zenoh_queue_get_length (const EdgefirstZenohQueue *queue);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_QUEUE_H__ */
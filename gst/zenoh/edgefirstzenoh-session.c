@@ -0,0 +1,534 @@
+/*
+ * EdgeFirst Perception for GStreamer - Shared Zenoh Session
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenoh-session.h"
+#include <gst/edgefirst/edgefirst.h>
+
+GST_DEBUG_CATEGORY_STATIC (edgefirst_zenoh_session_debug);
+#define GST_CAT_DEFAULT edgefirst_zenoh_session_debug
+
+#define TF_STATIC_TOPIC "rt/tf_static"
+
+/* TransformStamped messages are small; larger samples are ignored */
+#define TF_MESSAGE_MAX 1024
+
+struct _EdgefirstZenohSession {
+  gint ref_count;
+  gchar *key;
+  gboolean shm;
+  gboolean shared;          /* in the registry, see open_private() */
+  z_owned_session_t session;
+
+  /* Shared rt/tf_static and dynamic transform subscriptions, protected by
+   * tf_lock */
+  GMutex tf_lock;
+  guint tf_users;
+  EdgefirstTransformCache *tf_cache;
+  z_owned_subscriber_t tf_subscriber;
+  GHashTable *tf_dynamic;   /* topic → DynamicTransforms */
+};
+
+/* A dynamic transform topic and the number of elements using it */
+typedef struct {
+  guint users;
+  z_owned_subscriber_t subscriber;
+} DynamicTransforms;
+
+/* Process-wide registry of open sessions, keyed by resolved config.  Entries
+ * are weak: a session removes itself when its last reference is dropped.
+ * Sessions are opened outside the lock; a key being opened is pending, and
+ * other acquirers of it wait on registry_cond rather than open a second
+ * session. */
+static GMutex registry_lock;
+static GCond registry_cond;
+static GHashTable *registry;   /* key → EdgefirstZenohSession* */
+static GHashTable *pending;    /* keys being opened */
+
+G_DEFINE_BOXED_TYPE_WITH_CODE (EdgefirstZenohSession, edgefirst_zenoh_session,
+    edgefirst_zenoh_session_ref, edgefirst_zenoh_session_unref,
+    GST_DEBUG_CATEGORY_INIT (edgefirst_zenoh_session_debug,
+        "edgefirstzenohsession", 0, "EdgeFirst shared Zenoh session"));
+
+/* ── Config resolution ─────────────────────────────────────────────── */
+
+/* Same interpretation as the element "session" property: an existing file
+ * is a config file, anything else is a connect endpoint. */
+static gchar *
+resolve_config_key (const gchar *config)
+{
+  gchar *key;
+
+  if (!config)
+    return g_strdup ("default");
+
+  if (g_file_test (config, G_FILE_TEST_EXISTS)) {
+    if (g_path_is_absolute (config))
+      return g_strconcat ("file:", config, NULL);
+    else {
+      gchar *cwd = g_get_current_dir ();
+      gchar *path = g_build_filename (cwd, config, NULL);
+
+      key = g_strconcat ("file:", path, NULL);
+      g_free (path);
+      g_free (cwd);
+      return key;
+    }
+  }
+
+  return g_strconcat ("connect:", config, NULL);
+}
+
+static gboolean
+resolve_shm (gboolean shm)
+{
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+  return shm;
+#else
+  if (shm)
+    GST_WARNING ("zenoh-c was built without shared memory support, "
+        "using the network transport");
+  return FALSE;
+#endif
+}
+
+static gchar *
+resolve_key (const gchar *config, gboolean shm)
+{
+  gchar *key = resolve_config_key (config);
+
+  if (shm) {
+    gchar *shm_key = g_strconcat (key, "+shm", NULL);
+
+    g_free (key);
+    return shm_key;
+  }
+  return key;
+}
+
+static gboolean
+open_session (z_owned_session_t *session, const gchar *config, gboolean shm)
+{
+  z_owned_config_t zconfig;
+
+  if (config && g_file_test (config, G_FILE_TEST_EXISTS)) {
+    if (zc_config_from_file (&zconfig, config) != Z_OK) {
+      GST_ERROR ("Failed to load Zenoh config from: %s", config);
+      return FALSE;
+    }
+  } else if (config) {
+    z_config_default (&zconfig);
+    zc_config_insert_json5 (z_loan_mut (zconfig), "connect/endpoints", config);
+  } else {
+    z_config_default (&zconfig);
+  }
+
+  /* Peers on the same host then exchange SHM buffers instead of copying
+   * payloads through the loopback transport */
+  if (shm)
+    zc_config_insert_json5 (z_loan_mut (zconfig),
+        "transport/shared_memory/enabled", "true");
+
+  if (z_open (session, z_move (zconfig), NULL) != Z_OK) {
+    GST_ERROR ("Failed to open Zenoh session");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* ── Registry ──────────────────────────────────────────────────────── */
+
+static void
+dynamic_transforms_free (gpointer data)
+{
+  DynamicTransforms *dynamic = data;
+
+  z_drop (z_move (dynamic->subscriber));
+  g_free (dynamic);
+}
+
+static EdgefirstZenohSession *
+session_new (const gchar *config, gboolean shm, const gchar *key,
+    gboolean shared)
+{
+  EdgefirstZenohSession *session = g_new0 (EdgefirstZenohSession, 1);
+
+  if (!open_session (&session->session, config, shm)) {
+    g_free (session);
+    return NULL;
+  }
+
+  session->ref_count = 1;
+  session->key = g_strdup (key);
+  session->shm = shm;
+  session->shared = shared;
+  g_mutex_init (&session->tf_lock);
+  session->tf_users = 0;
+  session->tf_cache = edgefirst_transform_cache_new ();
+  session->tf_dynamic = g_hash_table_new_full (g_str_hash, g_str_equal,
+      g_free, dynamic_transforms_free);
+
+  return session;
+}
+
+/* Called with registry_lock held.  Sessions in the registry are alive: the
+ * last unref removes them under the lock. */
+static EdgefirstZenohSession *
+registry_lookup (const gchar *key)
+{
+  EdgefirstZenohSession *session;
+
+  if (!registry)
+    return NULL;
+
+  session = g_hash_table_lookup (registry, key);
+  if (session)
+    g_atomic_int_inc (&session->ref_count);
+
+  return session;
+}
+
+static EdgefirstZenohSession *
+acquire_with_key (const gchar *config, gboolean shm, const gchar *key)
+{
+  EdgefirstZenohSession *session;
+
+  g_mutex_lock (&registry_lock);
+
+  if (!registry) {
+    registry = g_hash_table_new (g_str_hash, g_str_equal);
+    pending = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  }
+
+  while (!(session = registry_lookup (key)) &&
+      g_hash_table_contains (pending, key))
+    g_cond_wait (&registry_cond, &registry_lock);
+
+  if (session) {
+    g_mutex_unlock (&registry_lock);
+    GST_DEBUG ("Sharing Zenoh session %s", key);
+    return session;
+  }
+
+  /* Opening can take as long as the router connection, so other keys are
+   * not held up behind it */
+  g_hash_table_add (pending, g_strdup (key));
+  g_mutex_unlock (&registry_lock);
+
+  session = session_new (config, shm, key, TRUE);
+
+  g_mutex_lock (&registry_lock);
+  g_hash_table_remove (pending, key);
+  if (session)
+    g_hash_table_insert (registry, session->key, session);
+  g_cond_broadcast (&registry_cond);
+  g_mutex_unlock (&registry_lock);
+
+  if (session)
+    GST_INFO ("Opened Zenoh session %s", key);
+  return session;
+}
+
+EdgefirstZenohSession *
+edgefirst_zenoh_session_acquire (const gchar *config, gboolean shm)
+{
+  EdgefirstZenohSession *session;
+  gchar *key;
+
+  g_type_ensure (EDGEFIRST_TYPE_ZENOH_SESSION);
+
+  shm = resolve_shm (shm);
+  key = resolve_key (config, shm);
+  session = acquire_with_key (config, shm, key);
+  g_free (key);
+
+  return session;
+}
+
+EdgefirstZenohSession *
+edgefirst_zenoh_session_open_private (const gchar *config, gboolean shm)
+{
+  EdgefirstZenohSession *session;
+  gchar *key;
+
+  g_type_ensure (EDGEFIRST_TYPE_ZENOH_SESSION);
+
+  shm = resolve_shm (shm);
+  key = resolve_key (config, shm);
+  session = session_new (config, shm, key, FALSE);
+  if (session)
+    GST_INFO ("Opened private Zenoh session %s", key);
+  g_free (key);
+
+  return session;
+}
+
+EdgefirstZenohSession *
+edgefirst_zenoh_session_ref (EdgefirstZenohSession *session)
+{
+  g_return_val_if_fail (session != NULL, NULL);
+
+  g_atomic_int_inc (&session->ref_count);
+  return session;
+}
+
+void
+edgefirst_zenoh_session_unref (EdgefirstZenohSession *session)
+{
+  g_return_if_fail (session != NULL);
+
+  if (!session->shared) {
+    if (!g_atomic_int_dec_and_test (&session->ref_count))
+      return;
+  } else {
+    /* The registry lock orders the final unref against a concurrent
+     * registry_lookup() of the same key. */
+    g_mutex_lock (&registry_lock);
+    if (!g_atomic_int_dec_and_test (&session->ref_count)) {
+      g_mutex_unlock (&registry_lock);
+      return;
+    }
+    g_hash_table_remove (registry, session->key);
+    g_mutex_unlock (&registry_lock);
+  }
+
+  GST_INFO ("Closing Zenoh session %s", session->key);
+  if (session->tf_users > 0)
+    z_drop (z_move (session->tf_subscriber));
+  g_hash_table_destroy (session->tf_dynamic);
+  z_drop (z_move (session->session));
+  edgefirst_transform_cache_free (session->tf_cache);
+  g_mutex_clear (&session->tf_lock);
+  g_free (session->key);
+  g_free (session);
+}
+
+const z_loaned_session_t *
+edgefirst_zenoh_session_loan (EdgefirstZenohSession *session)
+{
+  return z_loan (session->session);
+}
+
+const gchar *
+edgefirst_zenoh_session_get_key (EdgefirstZenohSession *session)
+{
+  return session->key;
+}
+
+gboolean
+edgefirst_zenoh_session_has_shm (EdgefirstZenohSession *session)
+{
+  return session->shm;
+}
+
+/* ── Shared transforms ─────────────────────────────────────────────── */
+
+static gboolean
+tf_parse (const z_loaned_sample_t *sample, EdgefirstTransformData *td)
+{
+  const z_loaned_bytes_t *payload = z_sample_payload (sample);
+  z_bytes_reader_t reader;
+  guint8 data[TF_MESSAGE_MAX];
+  gsize len = z_bytes_len (payload);
+  EdgefirstCdrTransformView tf;
+
+  if (len > sizeof (data))
+    return FALSE;
+
+  reader = z_bytes_get_reader (payload);
+  if (z_bytes_reader_read (&reader, data, len) != len ||
+      !edgefirst_cdr_transform_view_parse (data, len, &tf)) {
+    GST_DEBUG ("Failed to deserialize TransformStamped");
+    return FALSE;
+  }
+
+  edgefirst_cdr_transform_view_to_data (&tf, td);
+  return TRUE;
+}
+
+/* Runs on a Zenoh thread */
+static void
+tf_static_handler (z_loaned_sample_t *sample, void *context)
+{
+  EdgefirstZenohSession *session = context;
+  EdgefirstTransformData td;
+
+  if (!tf_parse (sample, &td))
+    return;
+
+  edgefirst_transform_cache_insert (session->tf_cache, &td);
+  GST_DEBUG ("Cached transform: %s -> %s", td.child_frame_id,
+      td.parent_frame_id);
+}
+
+/* Runs on a Zenoh thread */
+static void
+tf_dynamic_handler (z_loaned_sample_t *sample, void *context)
+{
+  EdgefirstZenohSession *session = context;
+  EdgefirstTransformData td;
+
+  if (tf_parse (sample, &td))
+    edgefirst_transform_cache_insert_dynamic (session->tf_cache, &td);
+}
+
+/* Declare a transform subscriber; failure is non-fatal since transforms
+ * are optional */
+static void
+tf_subscribe (EdgefirstZenohSession *session, const gchar *topic,
+    void (*handler) (z_loaned_sample_t *, void *),
+    z_owned_subscriber_t *subscriber)
+{
+  z_owned_closure_sample_t callback;
+  z_view_keyexpr_t ke;
+
+  z_closure_sample (&callback, handler, NULL, session);
+  if (z_view_keyexpr_from_str (&ke, topic) != Z_OK ||
+      z_declare_subscriber (z_loan (session->session), subscriber,
+          z_loan (ke), z_move (callback), NULL) != Z_OK)
+    GST_WARNING ("Failed to subscribe to %s", topic);
+  else
+    GST_DEBUG ("Subscribed to %s on session %s", topic, session->key);
+}
+
+EdgefirstTransformCache *
+edgefirst_zenoh_session_acquire_transforms (EdgefirstZenohSession *session,
+    const gchar *dynamic_topic)
+{
+  DynamicTransforms *dynamic;
+
+  g_return_val_if_fail (session != NULL, NULL);
+
+  g_mutex_lock (&session->tf_lock);
+  if (session->tf_users++ == 0)
+    tf_subscribe (session, TF_STATIC_TOPIC, tf_static_handler,
+        &session->tf_subscriber);
+
+  if (dynamic_topic) {
+    dynamic = g_hash_table_lookup (session->tf_dynamic, dynamic_topic);
+    if (!dynamic) {
+      dynamic = g_new0 (DynamicTransforms, 1);
+      tf_subscribe (session, dynamic_topic, tf_dynamic_handler,
+          &dynamic->subscriber);
+      g_hash_table_insert (session->tf_dynamic, g_strdup (dynamic_topic),
+          dynamic);
+    }
+    dynamic->users++;
+  }
+  g_mutex_unlock (&session->tf_lock);
+
+  return session->tf_cache;
+}
+
+void
+edgefirst_zenoh_session_release_transforms (EdgefirstZenohSession *session,
+    const gchar *dynamic_topic)
+{
+  DynamicTransforms *dynamic;
+
+  g_return_if_fail (session != NULL);
+
+  g_mutex_lock (&session->tf_lock);
+  if (dynamic_topic) {
+    dynamic = g_hash_table_lookup (session->tf_dynamic, dynamic_topic);
+    if (dynamic && --dynamic->users == 0)
+      g_hash_table_remove (session->tf_dynamic, dynamic_topic);
+  }
+  if (session->tf_users > 0 && --session->tf_users == 0)
+    z_drop (z_move (session->tf_subscriber));
+  g_mutex_unlock (&session->tf_lock);
+}
+
+/* ── GstContext sharing ────────────────────────────────────────────── */
+
+/* Contexts name a session by its registry key rather than hold a
+ * reference, which would keep it open for as long as the pipeline caches
+ * the context, after every element using it has stopped. */
+static EdgefirstZenohSession *
+session_from_context (GstContext *context, const gchar *key)
+{
+  EdgefirstZenohSession *session;
+  const gchar *context_key;
+
+  if (!context)
+    return NULL;
+
+  context_key = gst_structure_get_string (
+      gst_context_get_structure (context), "key");
+  if (g_strcmp0 (context_key, key) != 0)
+    return NULL;
+
+  g_mutex_lock (&registry_lock);
+  session = registry_lookup (key);
+  g_mutex_unlock (&registry_lock);
+
+  return session;
+}
+
+static EdgefirstZenohSession *
+lookup_element_context (GstElement *element, const gchar *key)
+{
+  GstContext *context;
+  EdgefirstZenohSession *session;
+
+  context = gst_element_get_context (element,
+      EDGEFIRST_ZENOH_SESSION_CONTEXT_TYPE);
+  session = session_from_context (context, key);
+  if (context)
+    gst_context_unref (context);
+
+  return session;
+}
+
+EdgefirstZenohSession *
+edgefirst_zenoh_session_obtain (GstElement *element, const gchar *config,
+    gboolean shm)
+{
+  EdgefirstZenohSession *session;
+  GstContext *context;
+  gchar *key;
+
+  g_return_val_if_fail (GST_IS_ELEMENT (element), NULL);
+
+  g_type_ensure (EDGEFIRST_TYPE_ZENOH_SESSION);
+
+  shm = resolve_shm (shm);
+  key = resolve_key (config, shm);
+
+  session = lookup_element_context (element, key);
+  if (!session) {
+    /* The parent bin answers with a context it has cached, the
+     * application may answer from a sync bus handler. */
+    gst_element_post_message (element,
+        gst_message_new_need_context (GST_OBJECT (element),
+            EDGEFIRST_ZENOH_SESSION_CONTEXT_TYPE));
+    session = lookup_element_context (element, key);
+  }
+
+  if (session) {
+    GST_DEBUG_OBJECT (element, "Using Zenoh session %s from context", key);
+    g_free (key);
+    return session;
+  }
+
+  session = acquire_with_key (config, shm, key);
+  g_free (key);
+  if (!session)
+    return NULL;
+
+  context = gst_context_new (EDGEFIRST_ZENOH_SESSION_CONTEXT_TYPE, TRUE);
+  gst_structure_set (gst_context_writable_structure (context), "key",
+      G_TYPE_STRING, session->key, NULL);
+  gst_element_set_context (element, context);
+  gst_element_post_message (element,
+      gst_message_new_have_context (GST_OBJECT (element), context));
+
+  return session;
+}
@@ -0,0 +1,161 @@
+/*
+ * EdgeFirst Perception for GStreamer - Shared Zenoh Session
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_SESSION_H__
+#define __EDGEFIRST_ZENOH_SESSION_H__
+
+#include <gst/gst.h>
+#include <zenoh.h>
+#include "transform-cache.h"
+
+G_BEGIN_DECLS
+
+/**
+ * EDGEFIRST_ZENOH_SESSION_CONTEXT_TYPE:
+ *
+ * #GstContext type used to share an #EdgefirstZenohSession between elements.
+ * The context structure names the session by its resolved config key, in a
+ * "key" string field; it holds no reference, so the session still closes
+ * when the last element using it stops.
+ */
+#define EDGEFIRST_ZENOH_SESSION_CONTEXT_TYPE "edgefirst.zenoh.session"
+
+/* Zenoh shared memory is only available when zenoh-c was built with the
+ * shared-memory and unstable API features. */
+#if defined(Z_FEATURE_SHARED_MEMORY) && defined(Z_FEATURE_UNSTABLE_API)
+#define EDGEFIRST_ZENOH_HAVE_SHM 1
+#endif
+
+#define EDGEFIRST_TYPE_ZENOH_SESSION (edgefirst_zenoh_session_get_type())
+
+typedef struct _EdgefirstZenohSession EdgefirstZenohSession;
+
+GType edgefirst_zenoh_session_get_type (void);
+
+/**
+ * edgefirst_zenoh_session_acquire:
+ * @config: (nullable): Zenoh config file path, locator, or NULL for defaults
+ * @shm: enable the shared-memory transport
+ *
+ * Returns the process-wide session for @config, opening it on first use.
+ * Sessions are keyed by the resolved config and @shm, so elements with the
+ * same "session" and "shm" properties share one Zenoh session.  @shm is
+ * ignored when zenoh-c lacks shared-memory support.  Opening does not block
+ * acquirers of other keys; those of the same key wait for it.
+ *
+ * Returns: (transfer full) (nullable): a session, or NULL if it could not be
+ *   opened
+ */
+EdgefirstZenohSession *edgefirst_zenoh_session_acquire (const gchar *config,
+    gboolean shm);
+
+/**
+ * edgefirst_zenoh_session_open_private:
+ * @config: (nullable): Zenoh config file path, locator, or NULL for defaults
+ * @shm: enable the shared-memory transport
+ *
+ * Opens a Zenoh session for the caller alone: it is neither registered for
+ * edgefirst_zenoh_session_acquire() nor announced through #GstContext.  For
+ * elements that may block their receive callbacks, which would otherwise
+ * stall every element sharing the session.
+ *
+ * Returns: (transfer full) (nullable): a session, or NULL if it could not be
+ *   opened
+ */
+EdgefirstZenohSession *edgefirst_zenoh_session_open_private (
+    const gchar *config, gboolean shm);
+
+/**
+ * edgefirst_zenoh_session_obtain:
+ * @element: the element that needs a session
+ * @config: (nullable): the element's "session" property
+ * @shm: the element's "shm" property
+ *
+ * Looks up a session through #GstContext first (element context, then a
+ * NEED_CONTEXT message to the bin and application) and falls back to
+ * edgefirst_zenoh_session_acquire().  A newly acquired session is announced
+ * with a HAVE_CONTEXT message so other elements in the pipeline reuse it.
+ * Contexts naming a different config, or a session that has since closed,
+ * are ignored.
+ *
+ * Returns: (transfer full) (nullable): a session, or NULL on failure
+ */
+EdgefirstZenohSession *edgefirst_zenoh_session_obtain (GstElement *element,
+    const gchar *config, gboolean shm);
+
+/**
+ * edgefirst_zenoh_session_ref:
+ * @session: a #EdgefirstZenohSession
+ *
+ * Returns: (transfer full): @session
+ */
+EdgefirstZenohSession *edgefirst_zenoh_session_ref (EdgefirstZenohSession *session);
+
+/**
+ * edgefirst_zenoh_session_unref:
+ * @session: a #EdgefirstZenohSession
+ *
+ * Drops a reference; the Zenoh session is closed with the last one.  All
+ * subscribers and publishers declared on it must be dropped first.
+ */
+void edgefirst_zenoh_session_unref (EdgefirstZenohSession *session);
+
+/**
+ * edgefirst_zenoh_session_loan:
+ * @session: a #EdgefirstZenohSession
+ *
+ * Returns: (transfer none): the loaned Zenoh session
+ */
+const z_loaned_session_t *edgefirst_zenoh_session_loan (EdgefirstZenohSession *session);
+
+/**
+ * edgefirst_zenoh_session_get_key:
+ * @session: a #EdgefirstZenohSession
+ *
+ * Returns: (transfer none): the resolved config key of @session
+ */
+const gchar *edgefirst_zenoh_session_get_key (EdgefirstZenohSession *session);
+
+/**
+ * edgefirst_zenoh_session_has_shm:
+ * @session: a #EdgefirstZenohSession
+ *
+ * Returns: TRUE if @session was opened with the shared-memory transport
+ */
+gboolean edgefirst_zenoh_session_has_shm (EdgefirstZenohSession *session);
+
+/**
+ * edgefirst_zenoh_session_acquire_transforms:
+ * @session: a #EdgefirstZenohSession
+ * @dynamic_topic: (nullable): topic of time-varying transforms, or %NULL
+ *
+ * Returns the transform cache of @session, fed by one `rt/tf_static`
+ * subscriber and one subscriber per @dynamic_topic, shared by every element
+ * on the session.  Each subscriber is declared by its first caller and
+ * dropped when the last one calls
+ * edgefirst_zenoh_session_release_transforms().  Cached transforms live as
+ * long as the session, since static transforms are not re-sent.
+ *
+ * Returns: (transfer none): the transform cache, valid until the matching
+ *   edgefirst_zenoh_session_release_transforms()
+ */
+EdgefirstTransformCache *edgefirst_zenoh_session_acquire_transforms (
+    EdgefirstZenohSession *session, const gchar *dynamic_topic);
+
+/**
+ * edgefirst_zenoh_session_release_transforms:
+ * @session: a #EdgefirstZenohSession
+ * @dynamic_topic: (nullable): the topic given to
+ *   edgefirst_zenoh_session_acquire_transforms()
+ *
+ * Releases a cache returned by edgefirst_zenoh_session_acquire_transforms().
+ */
+void edgefirst_zenoh_session_release_transforms (
+    EdgefirstZenohSession *session, const gchar *dynamic_topic);
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_SESSION_H__ */
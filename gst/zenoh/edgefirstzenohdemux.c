@@ -0,0 +1,922 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Demultiplexing Subscriber
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "edgefirstzenohdemux.h"
+#include "edgefirstzenoh-enums.h"
+#include "edgefirstzenoh-session.h"
+#include "edgefirstzenoh-decode.h"
+#include "edgefirstzenoh-queue.h"
+#include <gst/base/gstflowcombiner.h>
+#include <gst/allocators/gstdmabuf.h>
+#include <zenoh.h>
+#include <unistd.h>
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC (edgefirst_zenoh_demux_debug);
+#define GST_CAT_DEFAULT edgefirst_zenoh_demux_debug
+
+#define DEFAULT_QUEUE_DEPTH 16
+#define DEFAULT_MAX_AGE 0
+#define DEFAULT_MIN_INTERVAL 0
+
+/* Queue item carrying an undecoded sample from callback to streaming task */
+typedef struct {
+  z_owned_sample_t sample;
+  GstClockTime received;   /* gst_util_get_timestamp() at arrival */
+  gint fd;                 /* dmabuffer mode: imported frame fd, else -1 */
+} EdgefirstDemuxItem;
+
+/* One source pad, added for the first sample on its key expression */
+typedef struct {
+  gchar *key;
+  GstPad *pad;
+  EdgefirstZenohDecoder decoder;
+  gboolean have_caps;
+  gboolean need_segment;
+} EdgefirstDemuxStream;
+
+enum {
+  PROP_0,
+  PROP_TOPIC,
+  PROP_MESSAGE_TYPE,
+  PROP_SESSION,
+  PROP_ZERO_COPY,
+  PROP_SHM,
+  PROP_QUEUE_DEPTH,
+  PROP_MAX_AGE,
+  PROP_MIN_INTERVAL,
+  PROP_NORMALIZE_LAYOUT,
+  PROP_TF_TOPIC,
+  PROP_TARGET_FRAME,
+  PROP_STATS,
+};
+
+struct _EdgefirstZenohDemux {
+  GstElement parent;
+
+  /* Properties */
+  gchar *topic;
+  EdgefirstZenohSubMessageType message_type;
+  gchar *session_config;
+  gboolean zero_copy;
+  gboolean shm;
+  guint queue_depth;
+  EdgefirstZenohHeaderFilter filter;   /* protected by lock */
+  gboolean normalize_layout;
+  gchar *tf_topic;
+  gchar *target_frame;
+
+  /* Pending samples of every stream, protected by lock, sized to
+   * queue_depth at start.  A full queue drops its oldest sample. */
+  GMutex lock;
+  GCond cond;             /* signalled when a sample is queued */
+  EdgefirstZenohQueue queue;
+  gboolean flushing;      /* protected by lock */
+  gboolean playing;       /* protected by lock; samples wait outside PLAYING */
+
+  /* Statistics, protected by lock */
+  guint64 stat_received;
+  guint64 stat_decoded;
+  guint64 stat_decode_failures;
+  guint64 stat_filtered;
+  guint stat_streams;
+
+  /* Streaming task pushing every pad */
+  GstTask *task;
+  GRecMutex task_lock;
+
+  /* Streams by key expression, streaming task only */
+  GHashTable *streams;    /* gchar * -> EdgefirstDemuxStream */
+  EdgefirstDemuxStream *last_stream;
+  GString *key;           /* key of the sample being pushed */
+  GstFlowCombiner *flow_combiner;
+  gboolean wrap_payload;
+  guint group_id;
+
+  /* dmabuffer mode: fds are duplicated from the publisher process on
+   * arrival, while the publisher still holds the frame */
+  GMutex import_lock;
+  EdgefirstZenohFdImporter fd_importer;   /* protected by import_lock */
+
+  /* Zenoh session and the one subscriber for every stream */
+  EdgefirstZenohSession *session;   /* shared, see edgefirstzenoh-session.h */
+  z_owned_subscriber_t subscriber;
+
+  /* rt/tf_static and tf-topic transforms, owned by the session and shared
+   * with every element and stream on it; NULL when stopped */
+  EdgefirstTransformCache *transform_cache;
+  gchar *tf_topic_active;   /* tf-topic at start, released at stop */
+};
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src_%s",
+    GST_PAD_SRC,
+    GST_PAD_SOMETIMES,
+    GST_STATIC_CAPS (EDGEFIRST_POINTCLOUD2_CAPS "; "
+        "other/tensors, num-tensors = (int) 1; "
+        "video/x-raw; "
+        "video/x-raw(" GST_CAPS_FEATURE_MEMORY_DMABUF ")")
+    );
+
+#define edgefirst_zenoh_demux_parent_class parent_class
+G_DEFINE_TYPE (EdgefirstZenohDemux, edgefirst_zenoh_demux, GST_TYPE_ELEMENT);
+
+static void edgefirst_zenoh_demux_set_property (GObject *object,
+    guint prop_id, const GValue *value, GParamSpec *pspec);
+static void edgefirst_zenoh_demux_get_property (GObject *object,
+    guint prop_id, GValue *value, GParamSpec *pspec);
+static void edgefirst_zenoh_demux_finalize (GObject *object);
+
+static GstStateChangeReturn edgefirst_zenoh_demux_change_state (
+    GstElement *element, GstStateChange transition);
+
+static void edgefirst_zenoh_demux_loop (gpointer data);
+static void zenoh_demux_data_handler (z_loaned_sample_t *sample,
+    void *context);
+
+/* ── Pending sample queue ──────────────────────────────────────────── */
+
+static void
+demux_item_clear (gpointer data)
+{
+  EdgefirstDemuxItem *item = data;
+
+  z_drop (z_move (item->sample));
+  if (item->fd >= 0)
+    close (item->fd);
+  item->fd = -1;
+}
+
+static GstStructure *
+get_stats (EdgefirstZenohDemux *self)
+{
+  GstStructure *s;
+
+  g_mutex_lock (&self->lock);
+  s = gst_structure_new ("application/x-edgefirst-zenoh-demux-stats",
+      "received", G_TYPE_UINT64, self->stat_received,
+      "decoded", G_TYPE_UINT64, self->stat_decoded,
+      "dropped", G_TYPE_UINT64, self->queue.dropped,
+      "decode-failures", G_TYPE_UINT64, self->stat_decode_failures,
+      "filtered", G_TYPE_UINT64, self->stat_filtered,
+      "streams", G_TYPE_UINT, self->stat_streams,
+      NULL);
+  g_mutex_unlock (&self->lock);
+
+  return s;
+}
+
+/* ── Class init ────────────────────────────────────────────────────── */
+
+static void
+edgefirst_zenoh_demux_class_init (EdgefirstZenohDemuxClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  gobject_class->set_property = edgefirst_zenoh_demux_set_property;
+  gobject_class->get_property = edgefirst_zenoh_demux_get_property;
+  gobject_class->finalize = edgefirst_zenoh_demux_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_TOPIC,
+      g_param_spec_string ("topic", "Topic",
+          "Zenoh key expression to subscribe to, usually with wildcards; "
+          "each key it matches gets its own source pad",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MESSAGE_TYPE,
+      g_param_spec_enum ("message-type", "Message Type",
+          "Type of message expected on every matching key",
+          EDGEFIRST_TYPE_ZENOH_SUB_MESSAGE_TYPE,
+          EDGEFIRST_ZENOH_MSG_POINTCLOUD2,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_SESSION,
+      g_param_spec_string ("session", "Session",
+          "Zenoh locator or path to configuration file",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_ZERO_COPY,
+      g_param_spec_boolean ("zero-copy", "Zero Copy",
+          "Wrap the received Zenoh payload in the output buffer instead of "
+          "copying it (keeps the network buffer alive until downstream "
+          "releases the buffer)",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_SHM,
+      g_param_spec_boolean ("shm", "Shared Memory",
+          "Use the Zenoh shared-memory transport for same-host publishers "
+          "and wrap received SHM buffers without copying (implies zero-copy)",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_DEPTH,
+      g_param_spec_uint ("queue-depth", "Queue Depth",
+          "Maximum number of received samples of all streams waiting to be "
+          "decoded; the oldest is dropped when it is full",
+          1, G_MAXUINT, DEFAULT_QUEUE_DEPTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_AGE,
+      g_param_spec_uint ("max-age", "Maximum Age",
+          "Drop messages whose header stamp is older than this many "
+          "milliseconds on arrival (0 = no limit)",
+          0, G_MAXUINT, DEFAULT_MAX_AGE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_MIN_INTERVAL,
+      g_param_spec_uint ("min-interval", "Minimum Interval",
+          "Drop messages stamped less than this many milliseconds after "
+          "the last accepted one of the same stream and frame_id "
+          "(0 = keep all)",
+          0, G_MAXUINT, DEFAULT_MIN_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NORMALIZE_LAYOUT,
+      g_param_spec_boolean ("normalize-layout", "Normalize Layout",
+          "Convert point clouds to packed FLOAT32 x, y, z, intensity in "
+          "host byte order while copying them out of the message",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TF_TOPIC,
+      g_param_spec_string ("tf-topic", "TF Topic",
+          "Topic of time-varying TransformStamped messages; point clouds "
+          "get the transform interpolated at their header stamp "
+          "(NULL = static transforms only)",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TARGET_FRAME,
+      g_param_spec_string ("target-frame", "Target Frame",
+          "Frame the attached point cloud transform maps into, resolved "
+          "through the transform tree (NULL = parent of the cloud frame)",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Receive statistics: received, decoded, dropped, decode-failures, "
+          "filtered and streams",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (element_class,
+      "EdgeFirst Zenoh Demultiplexer",
+      "Source/Network",
+      "Subscribe to a wildcard Zenoh key expression and produce one stream "
+      "per matching key",
+      "Au-Zone Technologies <support@au-zone.com>");
+
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (edgefirst_zenoh_demux_change_state);
+
+  GST_DEBUG_CATEGORY_INIT (edgefirst_zenoh_demux_debug, "edgefirstzenohdemux",
+      0, "EdgeFirst Zenoh Demultiplexer");
+}
+
+static void
+demux_stream_free (gpointer data)
+{
+  EdgefirstDemuxStream *stream = data;
+
+  edgefirst_zenoh_decoder_clear (&stream->decoder);
+  g_free (stream->key);
+  g_free (stream);
+}
+
+static void
+edgefirst_zenoh_demux_init (EdgefirstZenohDemux *self)
+{
+  self->topic = NULL;
+  self->message_type = EDGEFIRST_ZENOH_MSG_POINTCLOUD2;
+  self->session_config = NULL;
+  self->zero_copy = FALSE;
+  self->shm = FALSE;
+  self->queue_depth = DEFAULT_QUEUE_DEPTH;
+  edgefirst_zenoh_header_filter_init (&self->filter);
+  self->filter.max_age = DEFAULT_MAX_AGE;
+  self->filter.min_interval = DEFAULT_MIN_INTERVAL;
+  self->normalize_layout = FALSE;
+  self->tf_topic = NULL;
+  self->target_frame = NULL;
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  g_mutex_init (&self->import_lock);
+  edgefirst_zenoh_queue_init (&self->queue, sizeof (EdgefirstDemuxItem),
+      DEFAULT_QUEUE_DEPTH, demux_item_clear);
+  self->flushing = TRUE;
+  self->playing = FALSE;
+
+  g_rec_mutex_init (&self->task_lock);
+  self->task = gst_task_new (edgefirst_zenoh_demux_loop, self, NULL);
+  gst_task_set_lock (self->task, &self->task_lock);
+
+  self->streams = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+      demux_stream_free);
+  self->last_stream = NULL;
+  self->key = g_string_new (NULL);
+  self->flow_combiner = gst_flow_combiner_new ();
+  edgefirst_zenoh_fd_importer_init (&self->fd_importer);
+  self->transform_cache = NULL;
+  self->tf_topic_active = NULL;
+}
+
+static void
+edgefirst_zenoh_demux_finalize (GObject *object)
+{
+  EdgefirstZenohDemux *self = EDGEFIRST_ZENOH_DEMUX (object);
+
+  g_free (self->topic);
+  g_free (self->session_config);
+  g_free (self->tf_topic);
+  g_free (self->target_frame);
+  edgefirst_zenoh_header_filter_clear (&self->filter);
+  g_hash_table_unref (self->streams);
+  g_string_free (self->key, TRUE);
+  gst_flow_combiner_free (self->flow_combiner);
+  gst_object_unref (self->task);
+  g_rec_mutex_clear (&self->task_lock);
+  edgefirst_zenoh_queue_clear (&self->queue);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+  g_mutex_clear (&self->import_lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+edgefirst_zenoh_demux_set_property (GObject *object, guint prop_id,
+    const GValue *value, GParamSpec *pspec)
+{
+  EdgefirstZenohDemux *self = EDGEFIRST_ZENOH_DEMUX (object);
+
+  switch (prop_id) {
+    case PROP_TOPIC:
+      g_free (self->topic);
+      self->topic = g_value_dup_string (value);
+      break;
+    case PROP_MESSAGE_TYPE:
+      self->message_type = g_value_get_enum (value);
+      break;
+    case PROP_SESSION:
+      g_free (self->session_config);
+      self->session_config = g_value_dup_string (value);
+      break;
+    case PROP_ZERO_COPY:
+      self->zero_copy = g_value_get_boolean (value);
+      break;
+    case PROP_SHM:
+      self->shm = g_value_get_boolean (value);
+      break;
+    case PROP_QUEUE_DEPTH:
+      self->queue_depth = g_value_get_uint (value);
+      break;
+    case PROP_MAX_AGE:
+      g_mutex_lock (&self->lock);
+      self->filter.max_age = g_value_get_uint (value);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MIN_INTERVAL:
+      g_mutex_lock (&self->lock);
+      self->filter.min_interval = g_value_get_uint (value);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_NORMALIZE_LAYOUT:
+      self->normalize_layout = g_value_get_boolean (value);
+      break;
+    case PROP_TF_TOPIC:
+      g_free (self->tf_topic);
+      self->tf_topic = g_value_dup_string (value);
+      break;
+    case PROP_TARGET_FRAME:
+      g_free (self->target_frame);
+      self->target_frame = g_value_dup_string (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+edgefirst_zenoh_demux_get_property (GObject *object, guint prop_id,
+    GValue *value, GParamSpec *pspec)
+{
+  EdgefirstZenohDemux *self = EDGEFIRST_ZENOH_DEMUX (object);
+
+  switch (prop_id) {
+    case PROP_TOPIC:
+      g_value_set_string (value, self->topic);
+      break;
+    case PROP_MESSAGE_TYPE:
+      g_value_set_enum (value, self->message_type);
+      break;
+    case PROP_SESSION:
+      g_value_set_string (value, self->session_config);
+      break;
+    case PROP_ZERO_COPY:
+      g_value_set_boolean (value, self->zero_copy);
+      break;
+    case PROP_SHM:
+      g_value_set_boolean (value, self->shm);
+      break;
+    case PROP_QUEUE_DEPTH:
+      g_value_set_uint (value, self->queue_depth);
+      break;
+    case PROP_MAX_AGE:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint (value, self->filter.max_age);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MIN_INTERVAL:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint (value, self->filter.min_interval);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_NORMALIZE_LAYOUT:
+      g_value_set_boolean (value, self->normalize_layout);
+      break;
+    case PROP_TF_TOPIC:
+      g_value_set_string (value, self->tf_topic);
+      break;
+    case PROP_TARGET_FRAME:
+      g_value_set_string (value, self->target_frame);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, get_stats (self));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* ── Zenoh callbacks ───────────────────────────────────────────────── */
+
+/* Takes a reference on the received sample; which stream it belongs to is
+ * only looked up on the streaming task.  As in edgefirstzenohsub, the
+ * header filters run before the sample is queued, and a DmaBuffer fd is
+ * imported here, before the sample can wait in the queue. */
+static void
+zenoh_demux_data_handler (z_loaned_sample_t *sample, void *context)
+{
+  EdgefirstZenohDemux *self = (EdgefirstZenohDemux *) context;
+  GstClockTime received = gst_util_get_timestamp ();
+  EdgefirstDemuxItem *item;
+  gint fd = -1;
+
+  /* message_type is read without a lock; it only changes in READY */
+  if (self->message_type == EDGEFIRST_ZENOH_MSG_TRANSFORM)
+    return;
+
+  g_mutex_lock (&self->lock);
+  if (!edgefirst_zenoh_header_filter_sample (&self->filter, TRUE, sample)) {
+    self->stat_received++;
+    self->stat_filtered++;
+    g_mutex_unlock (&self->lock);
+    return;
+  }
+  g_mutex_unlock (&self->lock);
+
+  if (self->message_type == EDGEFIRST_ZENOH_MSG_DMABUFFER) {
+    g_mutex_lock (&self->import_lock);
+    fd = edgefirst_zenoh_import_dmabuffer (GST_ELEMENT (self),
+        &self->fd_importer, sample);
+    g_mutex_unlock (&self->import_lock);
+    if (fd < 0) {
+      g_mutex_lock (&self->lock);
+      self->stat_received++;
+      self->stat_decode_failures++;
+      g_mutex_unlock (&self->lock);
+      return;
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  self->stat_received++;
+
+  /* The queue is leaky=downstream, so this never fails */
+  item = edgefirst_zenoh_queue_push (&self->queue, &self->lock);
+  z_sample_clone (&item->sample, sample);
+  item->received = received;
+  item->fd = fd;
+
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+}
+
+/* ── Streams ───────────────────────────────────────────────────────── */
+
+static gboolean
+demux_src_query (GstPad *pad, GstObject *parent, GstQuery *query)
+{
+  /* Buffers are stamped on arrival, so no latency beyond the transport */
+  if (GST_QUERY_TYPE (query) == GST_QUERY_LATENCY) {
+    gst_query_set_latency (query, TRUE, 0, GST_CLOCK_TIME_NONE);
+    return TRUE;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/* Pad names are the key expression with everything but letters, digits,
+ * '-' and '_' replaced, made unique if two keys map to the same name. */
+static gchar *
+demux_pad_name (EdgefirstZenohDemux *self, const gchar *key)
+{
+  GString *name = g_string_new ("src_");
+  GstPad *existing;
+  gsize len;
+
+  for (const gchar *c = key; *c; c++)
+    g_string_append_c (name, g_ascii_isalnum (*c) || *c == '-' ? *c : '_');
+
+  len = name->len;
+  for (guint i = 1;
+      (existing = gst_element_get_static_pad (GST_ELEMENT (self),
+              name->str)) != NULL; i++) {
+    gst_object_unref (existing);
+    g_string_truncate (name, len);
+    g_string_append_printf (name, "_%u", i);
+  }
+
+  return g_string_free (name, FALSE);
+}
+
+static EdgefirstDemuxStream *
+demux_add_stream (EdgefirstZenohDemux *self, const gchar *key)
+{
+  EdgefirstDemuxStream *stream = g_new0 (EdgefirstDemuxStream, 1);
+  GstPadTemplate *templ;
+  GstEvent *event;
+  gchar *name, *stream_id;
+
+  stream->key = g_strdup (key);
+  stream->need_segment = TRUE;
+
+  edgefirst_zenoh_decoder_init (&stream->decoder, GST_ELEMENT (self));
+  stream->decoder.message_type = self->message_type;
+  stream->decoder.wrap_payload = self->wrap_payload;
+  stream->decoder.normalize_layout = self->normalize_layout;
+  edgefirst_zenoh_decoder_start (&stream->decoder, self->transform_cache,
+      self->target_frame);
+
+  name = demux_pad_name (self, key);
+  templ = gst_element_class_get_pad_template (GST_ELEMENT_GET_CLASS (self),
+      "src_%s");
+  stream->pad = gst_pad_new_from_template (templ, name);
+  g_free (name);
+  gst_pad_set_query_function (stream->pad,
+      GST_DEBUG_FUNCPTR (demux_src_query));
+  gst_pad_use_fixed_caps (stream->pad);
+  gst_pad_set_active (stream->pad, TRUE);
+
+  stream_id = gst_pad_create_stream_id (stream->pad, GST_ELEMENT (self),
+      key);
+  event = gst_event_new_stream_start (stream_id);
+  gst_event_set_group_id (event, self->group_id);
+  gst_pad_push_event (stream->pad, event);
+  g_free (stream_id);
+
+  GST_INFO_OBJECT (self, "New stream %s on pad %s", key,
+      GST_PAD_NAME (stream->pad));
+
+  g_hash_table_insert (self->streams, stream->key, stream);
+  gst_flow_combiner_add_pad (self->flow_combiner, stream->pad);
+  gst_element_add_pad (GST_ELEMENT (self), stream->pad);
+
+  g_mutex_lock (&self->lock);
+  self->stat_streams++;
+  g_mutex_unlock (&self->lock);
+
+  return stream;
+}
+
+/* The stream of @sample's key expression, added on its first sample.
+ * Consecutive samples usually share a stream, which is checked first. */
+static EdgefirstDemuxStream *
+demux_get_stream (EdgefirstZenohDemux *self, const z_loaned_sample_t *sample)
+{
+  z_view_string_t key;
+  EdgefirstDemuxStream *stream;
+
+  z_keyexpr_as_view_string (z_sample_keyexpr (sample), &key);
+  g_string_truncate (self->key, 0);
+  g_string_append_len (self->key, z_string_data (z_loan (key)),
+      (gssize) z_string_len (z_loan (key)));
+
+  if (self->last_stream && strcmp (self->last_stream->key,
+          self->key->str) == 0)
+    return self->last_stream;
+
+  stream = g_hash_table_lookup (self->streams, self->key->str);
+  if (!stream)
+    stream = demux_add_stream (self, self->key->str);
+
+  self->last_stream = stream;
+  return stream;
+}
+
+/* Set the PTS of @buffer to the running time at which it was received */
+static void
+timestamp_buffer (EdgefirstZenohDemux *self, GstBuffer *buffer,
+    GstClockTime received)
+{
+  GstClock *clock;
+  GstClockTime base_time, now, waited, arrival;
+
+  GST_OBJECT_LOCK (self);
+  clock = GST_ELEMENT_CLOCK (self);
+  if (clock)
+    gst_object_ref (clock);
+  base_time = GST_ELEMENT_CAST (self)->base_time;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!clock) {
+    buffer->pts = GST_CLOCK_TIME_NONE;
+    return;
+  }
+
+  /* As in edgefirstzenohsub: carry over the time spent queued */
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+  waited = gst_util_get_timestamp () - received;
+  arrival = now > waited ? now - waited : 0;
+
+  buffer->pts = arrival > base_time ? arrival - base_time : 0;
+}
+
+/* Decode @item and push it on the pad of its stream.  Returns the combined
+ * flow of all pads. */
+static GstFlowReturn
+demux_push_item (EdgefirstZenohDemux *self, EdgefirstDemuxItem *item)
+{
+  const z_loaned_sample_t *sample = z_loan (item->sample);
+  EdgefirstDemuxStream *stream = demux_get_stream (self, sample);
+  GstBuffer *buffer;
+  GstCaps *caps = NULL;
+  guint64 stamp;
+  GstFlowReturn ret;
+
+  buffer = edgefirst_zenoh_decoder_decode (&stream->decoder, sample,
+      &item->fd, &caps, &stamp);
+
+  g_mutex_lock (&self->lock);
+  if (buffer)
+    self->stat_decoded++;
+  else
+    self->stat_decode_failures++;
+  g_mutex_unlock (&self->lock);
+
+  if (!buffer) {
+    if (caps)
+      gst_caps_unref (caps);
+    return GST_FLOW_OK;
+  }
+
+  /* Handlers only return caps when the stream signature changed; messages
+   * without caps of their own (CameraInfo) get the fixated peer caps, as
+   * from basesrc */
+  if (!caps && !stream->have_caps) {
+    GstCaps *templ = gst_pad_get_pad_template_caps (stream->pad);
+
+    caps = gst_pad_peer_query_caps (stream->pad, templ);
+    gst_caps_unref (templ);
+    if (gst_caps_is_empty (caps))
+      gst_clear_caps (&caps);
+    else
+      caps = gst_caps_fixate (caps);
+  }
+  if (caps) {
+    GST_DEBUG_OBJECT (stream->pad, "Stream changed, caps %" GST_PTR_FORMAT,
+        caps);
+    gst_pad_push_event (stream->pad, gst_event_new_caps (caps));
+    gst_caps_unref (caps);
+    stream->have_caps = TRUE;
+  }
+
+  if (stream->need_segment) {
+    GstSegment segment;
+
+    gst_segment_init (&segment, GST_FORMAT_TIME);
+    gst_pad_push_event (stream->pad, gst_event_new_segment (&segment));
+    stream->need_segment = FALSE;
+  }
+
+  timestamp_buffer (self, buffer, item->received);
+  ret = gst_pad_push (stream->pad, buffer);
+
+  return gst_flow_combiner_update_pad_flow (self->flow_combiner, stream->pad,
+      ret);
+}
+
+/* ── Streaming task ────────────────────────────────────────────────── */
+
+static void
+edgefirst_zenoh_demux_loop (gpointer data)
+{
+  EdgefirstZenohDemux *self = data;
+  EdgefirstDemuxItem item;
+  GstFlowReturn ret;
+
+  /* Live: samples are only pushed in PLAYING and wait (or are dropped by
+   * the queue) otherwise */
+  g_mutex_lock (&self->lock);
+  while (!self->flushing && (!self->playing ||
+          !edgefirst_zenoh_queue_pop (&self->queue, &item)))
+    g_cond_wait (&self->cond, &self->lock);
+
+  if (self->flushing) {
+    g_mutex_unlock (&self->lock);
+    gst_task_pause (self->task);
+    return;
+  }
+  g_mutex_unlock (&self->lock);
+
+  ret = demux_push_item (self, &item);
+  demux_item_clear (&item);
+
+  if (ret == GST_FLOW_OK)
+    return;
+
+  GST_DEBUG_OBJECT (self, "Pausing task, reason %s", gst_flow_get_name (ret));
+  if (ret == GST_FLOW_NOT_LINKED || ret < GST_FLOW_EOS)
+    GST_ELEMENT_FLOW_ERROR (self, ret);
+  gst_task_pause (self->task);
+}
+
+/* ── Start / Stop ──────────────────────────────────────────────────── */
+
+static gboolean
+edgefirst_zenoh_demux_start (EdgefirstZenohDemux *self)
+{
+  z_owned_closure_sample_t callback;
+  z_view_keyexpr_t ke;
+
+  if (!self->topic) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, (NULL),
+        ("No topic specified"));
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT (self, "Starting Zenoh demultiplexer on topic: %s",
+      self->topic);
+
+  g_mutex_lock (&self->lock);
+  edgefirst_zenoh_queue_resize (&self->queue, self->queue_depth);
+  self->queue.dropped = 0;
+  self->queue.high_water = 0;
+  self->flushing = FALSE;
+  self->stat_received = 0;
+  self->stat_decoded = 0;
+  self->stat_decode_failures = 0;
+  self->stat_filtered = 0;
+  self->stat_streams = 0;
+  edgefirst_zenoh_header_filter_reset (&self->filter);
+  g_mutex_unlock (&self->lock);
+
+  self->session = edgefirst_zenoh_session_obtain (GST_ELEMENT (self),
+      self->session_config, self->shm);
+  if (!self->session) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ, (NULL),
+        ("Failed to open Zenoh session"));
+    return FALSE;
+  }
+
+  /* Copying SHM payloads would throw away the point of the transport */
+  self->wrap_payload = self->zero_copy ||
+      edgefirst_zenoh_session_has_shm (self->session);
+  self->group_id = gst_util_group_id_next ();
+
+  /* Streams are added from the task, which needs the transforms */
+  g_free (self->tf_topic_active);
+  self->tf_topic_active = g_strdup (self->tf_topic);
+  self->transform_cache = edgefirst_zenoh_session_acquire_transforms (
+      self->session, self->tf_topic_active);
+
+  z_closure_sample (&callback, zenoh_demux_data_handler, NULL, self);
+  z_view_keyexpr_from_str (&ke, self->topic);
+
+  if (z_declare_subscriber (edgefirst_zenoh_session_loan (self->session),
+          &self->subscriber, z_loan (ke), z_move (callback), NULL) != Z_OK) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ, (NULL),
+        ("Failed to create subscriber for: %s", self->topic));
+    edgefirst_zenoh_session_release_transforms (self->session,
+        self->tf_topic_active);
+    self->transform_cache = NULL;
+    g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
+    return FALSE;
+  }
+
+  return gst_task_start (self->task);
+}
+
+static void
+edgefirst_zenoh_demux_stop (EdgefirstZenohDemux *self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  GST_INFO_OBJECT (self, "Stopping Zenoh demultiplexer");
+
+  g_mutex_lock (&self->lock);
+  self->flushing = TRUE;
+  g_cond_signal (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  gst_task_stop (self->task);
+  gst_task_join (self->task);
+
+  if (self->session) {
+    z_drop (z_move (self->subscriber));
+    edgefirst_zenoh_session_release_transforms (self->session,
+        self->tf_topic_active);
+    self->transform_cache = NULL;
+    g_clear_pointer (&self->tf_topic_active, g_free);
+  }
+  g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
+
+  g_mutex_lock (&self->lock);
+  edgefirst_zenoh_queue_flush (&self->queue);
+  g_mutex_unlock (&self->lock);
+
+  g_hash_table_iter_init (&iter, self->streams);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    EdgefirstDemuxStream *stream = value;
+
+    gst_flow_combiner_remove_pad (self->flow_combiner, stream->pad);
+    gst_pad_set_active (stream->pad, FALSE);
+    gst_element_remove_pad (GST_ELEMENT (self), stream->pad);
+  }
+  g_hash_table_remove_all (self->streams);
+  self->last_stream = NULL;
+
+  g_mutex_lock (&self->import_lock);
+  edgefirst_zenoh_fd_importer_clear (&self->fd_importer);
+  g_mutex_unlock (&self->import_lock);
+}
+
+static GstStateChangeReturn
+edgefirst_zenoh_demux_change_state (GstElement *element,
+    GstStateChange transition)
+{
+  EdgefirstZenohDemux *self = EDGEFIRST_ZENOH_DEMUX (element);
+  GstStateChangeReturn ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      if (!edgefirst_zenoh_demux_start (self)) {
+        edgefirst_zenoh_demux_stop (self);
+        return GST_STATE_CHANGE_FAILURE;
+      }
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
+      g_mutex_lock (&self->lock);
+      self->playing = TRUE;
+      g_cond_signal (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+      g_mutex_lock (&self->lock);
+      self->playing = FALSE;
+      g_mutex_unlock (&self->lock);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      edgefirst_zenoh_demux_stop (self);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+
+  /* Live source: there is nothing to preroll */
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+    case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+      ret = GST_STATE_CHANGE_NO_PREROLL;
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
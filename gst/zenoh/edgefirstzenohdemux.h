@@ -0,0 +1,19 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Demultiplexing Subscriber
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __EDGEFIRST_ZENOH_DEMUX_H__
+#define __EDGEFIRST_ZENOH_DEMUX_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define EDGEFIRST_TYPE_ZENOH_DEMUX (edgefirst_zenoh_demux_get_type())
+G_DECLARE_FINAL_TYPE (EdgefirstZenohDemux, edgefirst_zenoh_demux, EDGEFIRST, ZENOH_DEMUX, GstElement)
+
+G_END_DECLS
+
+#endif /* __EDGEFIRST_ZENOH_DEMUX_H__ */
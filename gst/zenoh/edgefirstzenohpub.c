@@ -10,21 +10,82 @@
 
 #include "edgefirstzenohpub.h"
 #include "edgefirstzenoh-enums.h"
+#include "edgefirstzenoh-session.h"
+#include "edgefirstzenoh-dmabuf.h"
+#include "edgefirstzenoh-compress.h"
+#include "edgefirstzenoh-encode.h"
 #include <gst/edgefirst/edgefirst.h>
 #include <gst/video/video.h>
-#include <edgefirst/schemas.h>
+#include <gst/allocators/gstdmabuf.h>
 #include <zenoh.h>
+#include <unistd.h>
 #include <string.h>
 
 GST_DEBUG_CATEGORY_STATIC (edgefirst_zenoh_pub_debug);
 #define GST_CAT_DEFAULT edgefirst_zenoh_pub_debug
 
+#define DEFAULT_SHM_SIZE (32 * 1024 * 1024)
+#define DEFAULT_QUEUE_DEPTH 4
+#define DEFAULT_CONGESTION_CONTROL EDGEFIRST_ZENOH_PUB_CONGESTION_DROP
+#define DEFAULT_PRIORITY EDGEFIRST_ZENOH_PUB_PRIORITY_DATA
+#define DEFAULT_PUBLISH_WHEN EDGEFIRST_ZENOH_PUB_PUBLISH_ALWAYS
+#define DEFAULT_COMPRESSION EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE
+#define DEFAULT_COMPRESSION_PRECISION 1.0f
+#define DEFAULT_DMABUF_HOLD 2
+
+/* Encoding parameters parsed once from the sink caps in set_caps().  A
+ * new descriptor is built on every caps change; queued buffers keep a
+ * reference to the one they arrived under. */
+typedef struct {
+  gint ref_count;
+
+  /* application/x-pointcloud2 */
+  EdgefirstPointFieldDesc fields[32];
+  guint num_fields;
+  uint32_t width;
+  uint32_t height;
+  uint32_t point_step;
+  uint32_t row_step;
+  gboolean is_bigendian;
+  gboolean is_dense;
+  gboolean has_xyz;         /* FLOAT32 x, y and z at xyz_offsets */
+  guint xyz_offsets[3];
+
+  /* other/tensors "dimensions", outermost first */
+  guint16 dims[EDGEFIRST_RADAR_MAX_DIMS + 1];
+  guint num_dims;
+
+  /* video/x-raw; encoding is NULL for formats ROS has no name for, fourcc
+   * is 0 for formats edgefirst_msgs/DmaBuffer has no code for */
+  const char *encoding;
+  uint32_t step;
+  uint32_t fourcc;
+  uint32_t stride;          /* plane 0 stride of the default layout */
+} EdgefirstCapsDesc;
+
+/* Buffer waiting in the publish queue, with the caps it arrived under */
+typedef struct {
+  GstBuffer *buffer;
+  EdgefirstCapsDesc *desc;
+} EdgefirstPublishItem;
+
 enum {
   PROP_0,
   PROP_TOPIC,
   PROP_MESSAGE_TYPE,
   PROP_SESSION,
   PROP_RELIABLE,
+  PROP_SHM,
+  PROP_SHM_SIZE,
+  PROP_CONGESTION_CONTROL,
+  PROP_PRIORITY,
+  PROP_EXPRESS,
+  PROP_QUEUE_DEPTH,
+  PROP_PUBLISH_WHEN,
+  PROP_COMPRESSION,
+  PROP_COMPRESSION_PRECISION,
+  PROP_DMABUF_HOLD,
+  PROP_STATS,
 };
 
 struct _EdgefirstZenohPub {
@@ -35,11 +96,69 @@ struct _EdgefirstZenohPub {
   EdgefirstZenohPubMessageType message_type;
   gchar *session_config;
   gboolean reliable;
+  gboolean shm;
+  guint shm_size;
+  EdgefirstZenohPubCongestionControl congestion_control;
+  EdgefirstZenohPubPriority priority;
+  gboolean express;
+  guint queue_depth;
+  EdgefirstZenohPubPublishWhen publish_when;
+  EdgefirstZenohPubCompression compression;
+  gfloat compression_precision;
+  guint dmabuf_hold;
+
+  /* Whether any subscriber matches topic, updated by the Zenoh matching
+   * listener; accessed atomically */
+  gint matched;
+
+  /* Publish queue: a ring of queue_depth items drained by publish_thread,
+   * protected by lock.  Not used when queue_depth is 0. */
+  GMutex lock;
+  GCond cond;             /* signalled when an item is queued or on stop */
+  GCond drained_cond;     /* signalled when an item has been published */
+  GThread *publish_thread;
+  EdgefirstPublishItem *ring;
+  guint ring_head;
+  guint ring_len;
+  gboolean publishing;    /* publish_thread is sending an item */
+  gboolean stopping;
+  GstFlowReturn last_ret; /* first error from publish_thread */
+
+  /* Statistics, protected by lock */
+  guint64 stat_published;
+  guint64 stat_skipped;
+  guint64 stat_dropped;
+
+  /* Current sink caps, see EdgefirstCapsDesc; set on the streaming thread */
+  EdgefirstCapsDesc *desc;
 
   /* Zenoh session and publisher handles */
-  z_owned_session_t session;
+  EdgefirstZenohSession *session;   /* shared, see edgefirstzenoh-session.h */
   z_owned_publisher_t publisher;
-  gboolean session_valid;
+
+  /* CDR header and trailer of the message being published */
+  GByteArray *scratch;
+
+  /* EdgefirstZenohDetectBoxMsg entries of the detection message being
+   * published */
+  GArray *detect_boxes;
+
+  /* Point cloud compression contexts and the quantized copy of the points
+   * being compressed */
+  EdgefirstZenohCodec *codec;
+  GByteArray *quantized;
+
+  /* The last dmabuf_hold published DMA-BUF buffers, kept alive so their
+   * fds stay valid until subscribers have imported them; allocated in
+   * start() */
+  GstBuffer **dmabuf_held;
+  guint dmabuf_held_idx;
+
+  /* Shared-memory provider messages are encoded into when shm is active */
+  gboolean shm_active;
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+  z_owned_shm_provider_t shm_provider;
+#endif
 };
 
 static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -47,7 +166,8 @@ static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS (EDGEFIRST_POINTCLOUD2_CAPS "; "
         "other/tensors, num-tensors = (int) 1; "
-        "video/x-raw")
+        "video/x-raw; "
+        "video/x-raw(" GST_CAPS_FEATURE_MEMORY_DMABUF ")")
     );
 
 #define edgefirst_zenoh_pub_parent_class parent_class
@@ -61,7 +181,13 @@ static void edgefirst_zenoh_pub_finalize (GObject *object);
 
 static gboolean edgefirst_zenoh_pub_start (GstBaseSink *sink);
 static gboolean edgefirst_zenoh_pub_stop (GstBaseSink *sink);
+static gboolean edgefirst_zenoh_pub_set_caps (GstBaseSink *sink, GstCaps *caps);
+static gboolean edgefirst_zenoh_pub_propose_allocation (GstBaseSink *sink,
+    GstQuery *query);
+static gboolean edgefirst_zenoh_pub_event (GstBaseSink *sink, GstEvent *event);
 static GstFlowReturn edgefirst_zenoh_pub_render (GstBaseSink *sink, GstBuffer *buffer);
+static GstFlowReturn edgefirst_zenoh_pub_render_list (GstBaseSink *sink,
+    GstBufferList *list);
 
 static void
 edgefirst_zenoh_pub_class_init (EdgefirstZenohPubClass *klass)
@@ -96,6 +222,89 @@ edgefirst_zenoh_pub_class_init (EdgefirstZenohPubClass *klass)
           "Use reliable QoS for message delivery",
           TRUE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_SHM,
+      g_param_spec_boolean ("shm", "Shared Memory",
+          "Encode messages into Zenoh shared memory so subscribers on the "
+          "same host receive them without a copy",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SHM_SIZE,
+      g_param_spec_uint ("shm-size", "Shared Memory Size",
+          "Size in bytes of the shared-memory pool used when shm is enabled",
+          1024 * 1024, G_MAXUINT, DEFAULT_SHM_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CONGESTION_CONTROL,
+      g_param_spec_enum ("congestion-control", "Congestion Control",
+          "What Zenoh does when the transport queue is full",
+          EDGEFIRST_TYPE_ZENOH_PUB_CONGESTION_CONTROL,
+          DEFAULT_CONGESTION_CONTROL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PRIORITY,
+      g_param_spec_enum ("priority", "Priority",
+          "Zenoh transport priority of published messages",
+          EDGEFIRST_TYPE_ZENOH_PUB_PRIORITY, DEFAULT_PRIORITY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_EXPRESS,
+      g_param_spec_boolean ("express", "Express",
+          "Send messages immediately instead of batching them",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_DEPTH,
+      g_param_spec_uint ("queue-depth", "Queue Depth",
+          "Buffers waiting for the publishing thread before the oldest is "
+          "dropped (0 = publish on the streaming thread)",
+          0, G_MAXUINT, DEFAULT_QUEUE_DEPTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PUBLISH_WHEN,
+      g_param_spec_enum ("publish-when", "Publish When",
+          "Publish every buffer (always) or only while a subscriber matches "
+          "the topic (matched)",
+          EDGEFIRST_TYPE_ZENOH_PUB_PUBLISH_WHEN, DEFAULT_PUBLISH_WHEN,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_enum ("compression", "Compression",
+          "Compression of PointCloud2 point data; subscribers decompress "
+          "it transparently",
+          EDGEFIRST_TYPE_ZENOH_PUB_COMPRESSION, DEFAULT_COMPRESSION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION_PRECISION,
+      g_param_spec_float ("compression-precision", "Compression Precision",
+          "Quantization step of x/y/z in millimetres for "
+          "compression=quantized-zstd",
+          0.01f, 1000.0f, DEFAULT_COMPRESSION_PRECISION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_DMABUF_HOLD,
+      g_param_spec_uint ("dmabuf-hold", "DMA-BUF Hold",
+          "Number of published frames kept referenced for "
+          "message-type=dmabuffer.  Subscribers import the fd when the "
+          "sample arrives; a frame released before that is reused by "
+          "upstream, and the import fails or maps the next frame.  Raise it "
+          "for slow links; upstream pools are asked for as many extra "
+          "buffers",
+          1, 64, DEFAULT_DMABUF_HOLD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Publish statistics: published, skipped (no matching subscriber) "
+          "and dropped (publish queue full)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "EdgeFirst Zenoh Publisher",
       "Sink/Network",
@@ -106,7 +315,13 @@ edgefirst_zenoh_pub_class_init (EdgefirstZenohPubClass *klass)
 
   basesink_class->start = GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_start);
   basesink_class->stop = GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_stop);
+  basesink_class->set_caps = GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_set_caps);
+  basesink_class->propose_allocation =
+      GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_propose_allocation);
+  basesink_class->event = GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_event);
   basesink_class->render = GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_render);
+  basesink_class->render_list =
+      GST_DEBUG_FUNCPTR (edgefirst_zenoh_pub_render_list);
 
   GST_DEBUG_CATEGORY_INIT (edgefirst_zenoh_pub_debug, "edgefirstzenohpub", 0,
       "EdgeFirst Zenoh Publisher");
@@ -119,7 +334,37 @@ edgefirst_zenoh_pub_init (EdgefirstZenohPub *self)
   self->message_type = EDGEFIRST_ZENOH_PUB_POINTCLOUD2;
   self->session_config = NULL;
   self->reliable = TRUE;
-  self->session_valid = FALSE;
+  self->shm = FALSE;
+  self->shm_size = DEFAULT_SHM_SIZE;
+  self->shm_active = FALSE;
+  self->scratch = g_byte_array_sized_new (512);
+  self->detect_boxes = g_array_new (FALSE, FALSE,
+      sizeof (EdgefirstZenohDetectBoxMsg));
+  self->congestion_control = DEFAULT_CONGESTION_CONTROL;
+  self->priority = DEFAULT_PRIORITY;
+  self->express = FALSE;
+  self->queue_depth = DEFAULT_QUEUE_DEPTH;
+  self->publish_when = DEFAULT_PUBLISH_WHEN;
+  self->compression = DEFAULT_COMPRESSION;
+  self->compression_precision = DEFAULT_COMPRESSION_PRECISION;
+  self->dmabuf_hold = DEFAULT_DMABUF_HOLD;
+  self->codec = NULL;
+  self->quantized = g_byte_array_new ();
+  self->matched = TRUE;
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  g_cond_init (&self->drained_cond);
+  self->publish_thread = NULL;
+  self->ring = NULL;
+  self->ring_head = 0;
+  self->ring_len = 0;
+  self->desc = NULL;
+  self->dmabuf_held = NULL;
+  self->dmabuf_held_idx = 0;
+  self->stat_published = 0;
+  self->stat_skipped = 0;
+  self->stat_dropped = 0;
 }
 
 static void
@@ -129,6 +374,12 @@ edgefirst_zenoh_pub_finalize (GObject *object)
 
   g_free (self->topic);
   g_free (self->session_config);
+  g_byte_array_unref (self->scratch);
+  g_array_unref (self->detect_boxes);
+  g_byte_array_unref (self->quantized);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+  g_cond_clear (&self->drained_cond);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -154,12 +405,58 @@ edgefirst_zenoh_pub_set_property (GObject *object, guint prop_id,
     case PROP_RELIABLE:
       self->reliable = g_value_get_boolean (value);
       break;
+    case PROP_SHM:
+      self->shm = g_value_get_boolean (value);
+      break;
+    case PROP_SHM_SIZE:
+      self->shm_size = g_value_get_uint (value);
+      break;
+    case PROP_CONGESTION_CONTROL:
+      self->congestion_control = g_value_get_enum (value);
+      break;
+    case PROP_PRIORITY:
+      self->priority = g_value_get_enum (value);
+      break;
+    case PROP_EXPRESS:
+      self->express = g_value_get_boolean (value);
+      break;
+    case PROP_QUEUE_DEPTH:
+      self->queue_depth = g_value_get_uint (value);
+      break;
+    case PROP_PUBLISH_WHEN:
+      self->publish_when = g_value_get_enum (value);
+      break;
+    case PROP_COMPRESSION:
+      self->compression = g_value_get_enum (value);
+      break;
+    case PROP_COMPRESSION_PRECISION:
+      self->compression_precision = g_value_get_float (value);
+      break;
+    case PROP_DMABUF_HOLD:
+      self->dmabuf_hold = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static GstStructure *
+get_stats (EdgefirstZenohPub *self)
+{
+  GstStructure *s;
+
+  g_mutex_lock (&self->lock);
+  s = gst_structure_new ("application/x-edgefirst-zenoh-pub-stats",
+      "published", G_TYPE_UINT64, self->stat_published,
+      "skipped", G_TYPE_UINT64, self->stat_skipped,
+      "dropped", G_TYPE_UINT64, self->stat_dropped,
+      NULL);
+  g_mutex_unlock (&self->lock);
+
+  return s;
+}
+
 static void
 edgefirst_zenoh_pub_get_property (GObject *object, guint prop_id,
     GValue *value, GParamSpec *pspec)
@@ -179,290 +476,353 @@ edgefirst_zenoh_pub_get_property (GObject *object, guint prop_id,
     case PROP_RELIABLE:
       g_value_set_boolean (value, self->reliable);
       break;
+    case PROP_SHM:
+      g_value_set_boolean (value, self->shm);
+      break;
+    case PROP_SHM_SIZE:
+      g_value_set_uint (value, self->shm_size);
+      break;
+    case PROP_CONGESTION_CONTROL:
+      g_value_set_enum (value, self->congestion_control);
+      break;
+    case PROP_PRIORITY:
+      g_value_set_enum (value, self->priority);
+      break;
+    case PROP_EXPRESS:
+      g_value_set_boolean (value, self->express);
+      break;
+    case PROP_QUEUE_DEPTH:
+      g_value_set_uint (value, self->queue_depth);
+      break;
+    case PROP_PUBLISH_WHEN:
+      g_value_set_enum (value, self->publish_when);
+      break;
+    case PROP_COMPRESSION:
+      g_value_set_enum (value, self->compression);
+      break;
+    case PROP_COMPRESSION_PRECISION:
+      g_value_set_float (value, self->compression_precision);
+      break;
+    case PROP_DMABUF_HOLD:
+      g_value_set_uint (value, self->dmabuf_hold);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, get_stats (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
-/* ── Zenoh session helpers ─────────────────────────────────────────── */
-
-static gboolean
-open_zenoh_session (EdgefirstZenohPub *self)
-{
-  z_owned_config_t config;
-
-  if (self->session_config && g_file_test (self->session_config, G_FILE_TEST_EXISTS)) {
-    if (zc_config_from_file (&config, self->session_config) != Z_OK) {
-      GST_ERROR_OBJECT (self, "Failed to load Zenoh config from: %s",
-          self->session_config);
-      return FALSE;
-    }
-  } else if (self->session_config) {
-    z_config_default (&config);
-    zc_config_insert_json5 (z_loan_mut (config), "connect/endpoints",
-        self->session_config);
-  } else {
-    z_config_default (&config);
-  }
-
-  if (z_open (&self->session, z_move (config), NULL) != Z_OK) {
-    GST_ERROR_OBJECT (self, "Failed to open Zenoh session");
-    return FALSE;
-  }
-
-  self->session_valid = TRUE;
-  return TRUE;
-}
+/* ── Publish helpers ───────────────────────────────────────────────── */
 
-/* ── CDR little-endian encoding helpers ────────────────────────────── */
+/* An input buffer kept mapped while Zenoh references its memory.  With
+ * buffer NULL, map.data is a heap block owned by the MappedBuffer. */
+typedef struct {
+  GstBuffer *buffer;
+  GstMapInfo map;
+} MappedBuffer;
 
-static inline void
-cdr_pad_to (GByteArray *b, size_t align)
+static MappedBuffer *
+mapped_buffer_new (GstBuffer *buffer)
 {
-  static const guint8 zeros[8] = { 0 };
-  size_t pad = (align - (b->len % align)) % align;
-  if (pad)
-    g_byte_array_append (b, zeros, (guint) pad);
-}
+  MappedBuffer *mapped = g_new (MappedBuffer, 1);
 
-static inline void
-cdr_write_u8 (GByteArray *b, guint8 v)
-{
-  g_byte_array_append (b, &v, 1);
+  if (!gst_buffer_map (buffer, &mapped->map, GST_MAP_READ)) {
+    g_free (mapped);
+    return NULL;
+  }
+  mapped->buffer = gst_buffer_ref (buffer);
+  return mapped;
 }
 
-static inline void
-cdr_write_i32 (GByteArray *b, gint32 v)
+static MappedBuffer *
+mapped_buffer_new_take (guint8 *data, gsize size)
 {
-  cdr_pad_to (b, 4);
-  g_byte_array_append (b, (const guint8 *) &v, 4);
-}
+  MappedBuffer *mapped = g_new0 (MappedBuffer, 1);
 
-static inline void
-cdr_write_u32 (GByteArray *b, guint32 v)
-{
-  cdr_pad_to (b, 4);
-  g_byte_array_append (b, (const guint8 *) &v, 4);
+  mapped->map.data = data;
+  mapped->map.size = size;
+  return mapped;
 }
 
-static inline void
-cdr_write_u64 (GByteArray *b, guint64 v)
+static void
+mapped_buffer_free (MappedBuffer *mapped)
 {
-  cdr_pad_to (b, 8);
-  g_byte_array_append (b, (const guint8 *) &v, 8);
+  if (mapped->buffer) {
+    gst_buffer_unmap (mapped->buffer, &mapped->map);
+    gst_buffer_unref (mapped->buffer);
+  } else {
+    g_free (mapped->map.data);
+  }
+  g_free (mapped);
 }
 
-static inline void
-cdr_write_string (GByteArray *b, const char *s)
+/* Zenoh payload deleter, may run on a Zenoh thread */
+static void
+mapped_buffer_deleter (void *data, void *context)
 {
-  guint32 len = (guint32) strlen (s ? s : "") + 1;   /* includes null */
-  cdr_write_u32 (b, len);
-  g_byte_array_append (b, (const guint8 *) (s ? s : ""), len);
+  mapped_buffer_free (context);
 }
 
-/* ── Publish helpers ───────────────────────────────────────────────── */
-
-/* Encode sensor_msgs/PointCloud2 to CDR little-endian.
- * Returns allocated bytes (free with g_free); sets *out_len. */
-static guint8 *
-encode_pointcloud2_cdr (int32_t stamp_sec, uint32_t stamp_nanosec,
-                        const char *frame_id,
-                        uint32_t height, uint32_t width,
-                        uint32_t point_step, uint32_t row_step,
-                        const EdgefirstPointFieldDesc *fields, guint num_fields,
-                        gboolean is_bigendian, gboolean is_dense,
-                        const uint8_t *data, size_t data_len,
-                        size_t *out_len)
+/* Encode @msg and publish it.  @mapped holds the bulk data @msg points to
+ * and is released once Zenoh no longer needs it; it is NULL for messages
+ * without bulk data.  @attachment, if not NULL, is sent as the Zenoh
+ * attachment of the sample.
+ *
+ * Normally only the CDR header and trailer are written, into a reused
+ * scratch buffer, and the mapped data is attached as its own slice of the
+ * Zenoh payload.  With shm the whole message is encoded into an SHM buffer
+ * so same-host subscribers map it without a copy. */
+static GstFlowReturn
+publish_message (EdgefirstZenohPub *self, EdgefirstZenohEncodeFunc encode,
+    gconstpointer msg, MappedBuffer *mapped, const gchar *attachment)
 {
-  static const guint8 cdr_le_header[4] = { 0x00, 0x01, 0x00, 0x00 };
-  GByteArray *b = g_byte_array_new ();
-
-  g_byte_array_append (b, cdr_le_header, 4);
-
-  /* Header.stamp + frame_id */
-  cdr_write_i32 (b, stamp_sec);
-  cdr_write_u32 (b, stamp_nanosec);
-  cdr_write_string (b, frame_id);
+  EdgefirstZenohCdrWriter w;
+  z_owned_bytes_writer_t writer;
+  z_owned_bytes_t payload, data, attachment_bytes;
+  z_publisher_put_options_t put_opts;
+  const guint8 *scratch;
+  size_t size, head_len, tail_len;
+
+  edgefirst_zenoh_cdr_writer_init (&w, NULL, TRUE);
+  encode (&w, msg);
+  size = w.len;
+
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+  if (self->shm_active) {
+    z_buf_layout_alloc_result_t alloc;
+    z_alloc_alignment_t alignment = { 0 };
+
+    z_shm_provider_alloc_gc_defrag (&alloc, z_loan (self->shm_provider),
+        size, alignment);
+    if (alloc.status == ZC_BUF_LAYOUT_ALLOC_STATUS_OK) {
+      edgefirst_zenoh_cdr_writer_init (&w,
+          z_shm_mut_data_mut (z_loan_mut (alloc.buf)), FALSE);
+      encode (&w, msg);
+      if (mapped)
+        mapped_buffer_free (mapped);
+      z_bytes_from_shm_mut (&payload, z_move (alloc.buf));
+      goto put;
+    }
 
-  cdr_write_u32 (b, height);
-  cdr_write_u32 (b, width);
+    /* Subscribers still receive the message, just through the network
+     * transport */
+    GST_DEBUG_OBJECT (self, "SHM provider exhausted, publishing %"
+        G_GSIZE_FORMAT " bytes from the heap", size);
+  }
+#endif
 
-  /* fields: sequence<PointField> */
-  cdr_write_u32 (b, num_fields);
-  for (guint i = 0; i < num_fields; i++) {
-    cdr_write_string (b, fields[i].name);
-    cdr_write_u32 (b, fields[i].offset);
-    cdr_write_u8 (b, (guint8) fields[i].datatype);
-    cdr_write_u32 (b, fields[i].count);
+  g_byte_array_set_size (self->scratch, (guint) (size - w.payload_len));
+  edgefirst_zenoh_cdr_writer_init (&w, self->scratch->data, TRUE);
+  encode (&w, msg);
+
+  scratch = self->scratch->data;
+  head_len = w.payload_len ? w.payload_off : w.len;
+  tail_len = w.len - w.payload_len - head_len;
+
+  z_bytes_writer_empty (&writer);
+  z_bytes_writer_write_all (z_loan_mut (writer), scratch, head_len);
+  if (w.payload_len) {
+    if (z_bytes_from_buf (&data, (uint8_t *) w.payload, w.payload_len,
+            mapped_buffer_deleter, mapped) == Z_OK) {
+      mapped = NULL;
+      z_bytes_writer_append (z_loan_mut (writer), z_move (data));
+    } else {
+      z_bytes_writer_write_all (z_loan_mut (writer), w.payload,
+          w.payload_len);
+    }
   }
+  z_bytes_writer_write_all (z_loan_mut (writer), scratch + head_len,
+      tail_len);
+  z_bytes_writer_finish (z_move (writer), &payload);
 
-  cdr_write_u8 (b, is_bigendian ? 1 : 0);
-  cdr_write_u32 (b, point_step);
-  cdr_write_u32 (b, row_step);
+  if (mapped)
+    mapped_buffer_free (mapped);
 
-  /* data: sequence<uint8> */
-  cdr_write_u32 (b, (guint32) data_len);
-  if (data_len)
-    g_byte_array_append (b, data, (guint) data_len);
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+put:
+#endif
+  z_publisher_put_options_default (&put_opts);
+  if (attachment) {
+    z_bytes_copy_from_str (&attachment_bytes, attachment);
+    put_opts.attachment = z_move (attachment_bytes);
+  }
 
-  cdr_write_u8 (b, is_dense ? 1 : 0);
+  if (z_publisher_put (z_loan (self->publisher), z_move (payload),
+          &put_opts) != Z_OK) {
+    GST_WARNING_OBJECT (self, "Failed to publish %" G_GSIZE_FORMAT " bytes",
+        size);
+  } else {
+    g_mutex_lock (&self->lock);
+    self->stat_published++;
+    g_mutex_unlock (&self->lock);
+  }
 
-  *out_len = b->len;
-  return g_byte_array_free (b, FALSE);
+  return GST_FLOW_OK;
 }
 
-/* Encode edgefirst_msgs/RadarCube to CDR little-endian.
- * Field order: Header (stamp, frame_id), timestamp, layout[], cube[], is_complex.
- * Returns allocated bytes (free with g_free); sets *out_len. */
-static guint8 *
-encode_radarcube_cdr (int32_t stamp_sec, uint32_t stamp_nanosec,
-                      const char *frame_id,
-                      guint64 timestamp,
-                      const guint8 *layout, guint layout_len,
-                      const gint16 *cube, guint cube_len,
-                      gboolean is_complex,
-                      size_t *out_len)
+/* Compress the points of @mapped into a new heap block.  quantized-zstd
+ * falls back to lossless zstd for clouds without FLOAT32 x/y/z or with
+ * padded rows.  Exactly row_step * height bytes are compressed, the size
+ * subscribers check the attachment against; returns NULL if @mapped is
+ * shorter. */
+static MappedBuffer *
+compress_points (EdgefirstZenohPub *self, const EdgefirstCapsDesc *desc,
+    MappedBuffer *mapped, EdgefirstZenohCompressionInfo *info)
 {
-  static const guint8 cdr_le_header[4] = { 0x00, 0x01, 0x00, 0x00 };
-  GByteArray *b = g_byte_array_new ();
-
-  g_byte_array_append (b, cdr_le_header, 4);
-
-  /* Header */
-  cdr_write_i32 (b, stamp_sec);
-  cdr_write_u32 (b, stamp_nanosec);
-  cdr_write_string (b, frame_id);
-
-  /* timestamp (uint64, 8-byte aligned) */
-  cdr_write_u64 (b, timestamp);
-
-  /* layout: sequence<uint8> */
-  cdr_write_u32 (b, layout_len);
-  if (layout_len)
-    g_byte_array_append (b, layout, layout_len);
-
-  /* cube: sequence<int16> (element count + int16 bytes) */
-  cdr_write_u32 (b, cube_len);
-  if (cube_len)
-    g_byte_array_append (b, (const guint8 *) cube, cube_len * sizeof (gint16));
+  const guint8 *src = mapped->map.data;
+  gsize len = (gsize) desc->row_step * desc->height;
+  gsize num_points = (gsize) desc->width * desc->height;
+  guint8 *data;
+  gsize size;
+
+  if (len == 0 || mapped->map.size < len)
+    return NULL;
+
+  info->codec = self->compression;
+  info->size = len;
+  info->precision = self->compression_precision;
+
+  if (info->codec == EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD) {
+    if (desc->has_xyz && !desc->is_bigendian && desc->point_step > 0 &&
+        num_points * desc->point_step == len) {
+      g_byte_array_set_size (self->quantized, (guint) len);
+      edgefirst_zenoh_quantize_xyz (self->quantized->data, src, num_points,
+          desc->point_step, desc->xyz_offsets, info->precision);
+      src = self->quantized->data;
+    } else {
+      info->codec = EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD;
+    }
+  }
 
-  /* is_complex */
-  cdr_write_u8 (b, is_complex ? 1 : 0);
+  data = edgefirst_zenoh_codec_compress (self->codec, info->codec, src, len,
+      &size);
+  if (!data)
+    return NULL;
 
-  *out_len = b->len;
-  return g_byte_array_free (b, FALSE);
+  GST_LOG_OBJECT (self, "Compressed %" G_GSIZE_FORMAT " bytes of points to %"
+      G_GSIZE_FORMAT, len, size);
+  return mapped_buffer_new_take (data, size);
 }
 
 static GstFlowReturn
-publish_pointcloud2 (EdgefirstZenohPub *self, GstBuffer *buffer)
+publish_pointcloud2 (EdgefirstZenohPub *self, GstBuffer *buffer,
+    const EdgefirstCapsDesc *desc)
 {
   EdgefirstPointCloud2Meta *meta;
-  GstMapInfo map;
-  GstCaps *caps;
-  GstStructure *s;
-  const gchar *fields_str = NULL;
-  EdgefirstPointFieldDesc fields[32];
-  guint num_fields = 0;
-  guint8 *out_bytes = NULL;
-  size_t out_len = 0;
-  int32_t stamp_sec = 0;
-  uint32_t stamp_nanosec = 0;
-  const gchar *frame_id = "";
-  gint w = 0, h = 0, ps = 0;
-  gboolean bigendian = FALSE, dense = FALSE;
-
-  /* Get caps info */
-  caps = gst_pad_get_current_caps (GST_BASE_SINK_PAD (self));
-  if (caps) {
-    s = gst_caps_get_structure (caps, 0);
-    gst_structure_get_int (s, "width", &w);
-    gst_structure_get_int (s, "height", &h);
-    gst_structure_get_int (s, "point-step", &ps);
-    gst_structure_get_boolean (s, "is-bigendian", &bigendian);
-    gst_structure_get_boolean (s, "is-dense", &dense);
-    fields_str = gst_structure_get_string (s, "fields");
-    num_fields = edgefirst_parse_point_fields (fields_str, fields, 32);
-    gst_caps_unref (caps);
-  }
+  MappedBuffer *mapped, *packed;
+  EdgefirstZenohCompressionInfo info;
+  EdgefirstZenohPointCloud2Msg msg = { 0, };
+  GstFlowReturn ret;
+  gchar *attachment;
+
+  msg.frame_id = "";
 
   /* Get header from meta */
   meta = edgefirst_buffer_get_pointcloud2_meta (buffer);
   if (meta) {
     if (meta->frame_id[0] != '\0')
-      frame_id = meta->frame_id;
+      msg.frame_id = meta->frame_id;
     if (meta->ros_timestamp_ns > 0) {
-      stamp_sec = (int32_t) (meta->ros_timestamp_ns / G_GUINT64_CONSTANT (1000000000));
-      stamp_nanosec = (uint32_t) (meta->ros_timestamp_ns % G_GUINT64_CONSTANT (1000000000));
+      msg.stamp_sec = (int32_t) (meta->ros_timestamp_ns / G_GUINT64_CONSTANT (1000000000));
+      msg.stamp_nanosec = (uint32_t) (meta->ros_timestamp_ns % G_GUINT64_CONSTANT (1000000000));
     }
   }
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
+  mapped = mapped_buffer_new (buffer);
+  if (!mapped)
     return GST_FLOW_ERROR;
 
-  out_bytes = encode_pointcloud2_cdr (stamp_sec, stamp_nanosec, frame_id,
-      (uint32_t) h, (uint32_t) w, (uint32_t) ps,
-      (uint32_t) (w * ps), fields, num_fields,
-      bigendian, dense, map.data, map.size, &out_len);
+  msg.height = desc->height;
+  msg.width = desc->width;
+  msg.point_step = desc->point_step;
+  msg.row_step = desc->row_step;
+  msg.fields = desc->fields;
+  msg.num_fields = desc->num_fields;
+  msg.is_bigendian = desc->is_bigendian;
+  msg.is_dense = desc->is_dense;
+  msg.data = mapped->map.data;
+  msg.data_len = mapped->map.size;
+
+  if (self->compression == EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE)
+    return publish_message (self, edgefirst_zenoh_encode_pointcloud2, &msg,
+        mapped, NULL);
+
+  packed = compress_points (self, desc, mapped, &info);
+  if (!packed) {
+    GST_WARNING_OBJECT (self, "Failed to compress %" G_GSIZE_FORMAT
+        " bytes of points, publishing them uncompressed", msg.data_len);
+    return publish_message (self, edgefirst_zenoh_encode_pointcloud2, &msg,
+        mapped, NULL);
+  }
+  mapped_buffer_free (mapped);
 
-  gst_buffer_unmap (buffer, &map);
+  attachment = edgefirst_zenoh_compression_to_attachment (&info);
+  msg.data = packed->map.data;
+  msg.data_len = packed->map.size;
+  ret = publish_message (self, edgefirst_zenoh_encode_pointcloud2, &msg,
+      packed, attachment);
+  g_free (attachment);
 
-  if (out_bytes) {
-    z_owned_bytes_t payload;
-    z_bytes_copy_from_buf (&payload, out_bytes, out_len);
-    z_publisher_put (z_loan (self->publisher), z_move (payload), NULL);
-    g_free (out_bytes);
-  } else {
-    GST_WARNING_OBJECT (self, "Failed to encode PointCloud2");
-  }
+  return ret;
+}
 
-  return GST_FLOW_OK;
+/* The cube shape is desc->dims without the innermost 2 that
+ * edgefirstzenohsub adds for (real, imaginary) pairs */
+static guint
+radar_shape (const EdgefirstCapsDesc *desc, gboolean is_complex,
+    guint num_dims, guint16 *shape)
+{
+  guint n = desc->num_dims;
+
+  if (is_complex && n == num_dims + 1 && desc->dims[n - 1] == 2)
+    n--;
+  n = MIN (n, EDGEFIRST_RADAR_MAX_DIMS);
+
+  memcpy (shape, desc->dims, n * sizeof (guint16));
+  return n;
 }
 
 static GstFlowReturn
-publish_radarcube (EdgefirstZenohPub *self, GstBuffer *buffer)
+publish_radarcube (EdgefirstZenohPub *self, GstBuffer *buffer,
+    const EdgefirstCapsDesc *desc)
 {
   EdgefirstRadarCubeMeta *meta;
-  GstMapInfo map;
-  guint8 *out_bytes = NULL;
-  size_t out_len = 0;
+  MappedBuffer *mapped;
   guint8 layout[EDGEFIRST_RADAR_MAX_DIMS];
-  guint layout_len = 0;
-  guint64 timestamp = 0;
-  const gchar *frame_id = "";
-  gboolean is_complex = FALSE;
+  guint16 shape[EDGEFIRST_RADAR_MAX_DIMS];
+  EdgefirstZenohRadarCubeMsg msg = { 0, };
+
+  msg.frame_id = "";
+  msg.layout = layout;
+  msg.shape = shape;
 
   meta = edgefirst_buffer_get_radar_cube_meta (buffer);
   if (meta) {
-    layout_len = meta->num_dims;
+    msg.layout_len = meta->num_dims;
     for (guint8 i = 0; i < meta->num_dims; i++)
       layout[i] = (guint8) meta->layout[i];
-    timestamp = meta->radar_timestamp;
-    is_complex = meta->is_complex;
+    msg.scales = meta->scales;
+    msg.scales_len = meta->num_dims;
+    msg.timestamp = meta->radar_timestamp;
+    msg.is_complex = meta->is_complex;
     if (meta->frame_id[0] != '\0')
-      frame_id = meta->frame_id;
+      msg.frame_id = meta->frame_id;
   }
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
-    return GST_FLOW_ERROR;
-
-  out_bytes = encode_radarcube_cdr (0, 0, frame_id, timestamp,
-      layout, layout_len,
-      (const gint16 *) map.data, (guint) (map.size / sizeof (gint16)),
-      is_complex, &out_len);
+  msg.shape_len = radar_shape (desc, msg.is_complex, msg.layout_len, shape);
 
-  gst_buffer_unmap (buffer, &map);
+  mapped = mapped_buffer_new (buffer);
+  if (!mapped)
+    return GST_FLOW_ERROR;
 
-  if (out_bytes) {
-    z_owned_bytes_t payload;
-    z_bytes_copy_from_buf (&payload, out_bytes, out_len);
-    z_publisher_put (z_loan (self->publisher), z_move (payload), NULL);
-    g_free (out_bytes);
-  } else {
-    GST_WARNING_OBJECT (self, "Failed to encode RadarCube");
-  }
+  msg.cube = (const gint16 *) mapped->map.data;
+  msg.cube_len = (guint) (mapped->map.size / sizeof (gint16));
 
-  return GST_FLOW_OK;
+  return publish_message (self, edgefirst_zenoh_encode_radarcube, &msg,
+      mapped, NULL);
 }
 
 static const char *
@@ -483,82 +843,528 @@ gst_format_to_ros_encoding (GstVideoFormat format)
 }
 
 static GstFlowReturn
-publish_image (EdgefirstZenohPub *self, GstBuffer *buffer)
+publish_image (EdgefirstZenohPub *self, GstBuffer *buffer,
+    const EdgefirstCapsDesc *desc)
 {
-  GstMapInfo map;
-  GstCaps *caps;
-  GstVideoInfo info;
-  const char *encoding = NULL;
-  uint8_t *out_bytes = NULL;
-  size_t out_len = 0;
-  uint32_t width = 0, height = 0, step = 0;
-
-  caps = gst_pad_get_current_caps (GST_BASE_SINK_PAD (self));
-  if (caps) {
-    gst_video_info_from_caps (&info, caps);
-    encoding = gst_format_to_ros_encoding (GST_VIDEO_INFO_FORMAT (&info));
-    if (!encoding) {
-      GST_WARNING_OBJECT (self, "Unsupported video format for ROS encoding");
-      gst_caps_unref (caps);
-      return GST_FLOW_ERROR;
-    }
-    width = (uint32_t) GST_VIDEO_INFO_WIDTH (&info);
-    height = (uint32_t) GST_VIDEO_INFO_HEIGHT (&info);
-    step = width * (uint32_t) GST_VIDEO_INFO_COMP_PSTRIDE (&info, 0);
-    gst_caps_unref (caps);
+  MappedBuffer *mapped;
+  EdgefirstZenohImageMsg msg = { 0, };
+
+  msg.frame_id = "";
+  msg.encoding = desc->encoding;
+  msg.width = desc->width;
+  msg.height = desc->height;
+  msg.step = desc->step;
+
+  if (!msg.encoding) {
+    GST_WARNING_OBJECT (self, "No ROS encoding for the negotiated caps");
+    return GST_FLOW_ERROR;
+  }
+
+  mapped = mapped_buffer_new (buffer);
+  if (!mapped)
+    return GST_FLOW_ERROR;
+
+  msg.data = mapped->map.data;
+  msg.data_len = mapped->map.size;
+
+  return publish_message (self, edgefirst_zenoh_encode_image, &msg,
+      mapped, NULL);
+}
+
+/* Detections travel as a few dozen bytes per box instead of as a rendered
+ * image.  Buffers without an EdgefirstDetectionMeta are not published. */
+static GstFlowReturn
+publish_detect (EdgefirstZenohPub *self, GstBuffer *buffer)
+{
+  EdgefirstZenohDetectMsg msg;
+
+  if (!edgefirst_zenoh_detect_msg_init (&msg, self->detect_boxes, buffer,
+          (guint64) g_get_real_time () * 1000)) {
+    GST_LOG_OBJECT (self, "No detection meta on buffer, skipping");
+    return GST_FLOW_OK;
   }
 
-  if (!encoding) {
-    GST_WARNING_OBJECT (self, "No caps available for image encoding");
+  return publish_message (self, edgefirst_zenoh_encode_detect, &msg,
+      NULL, NULL);
+}
+
+/* Unix time of @buffer: its "timestamp/x-unix" reference timestamp if
+ * upstream attached one, else now */
+static GstClockTime
+dmabuf_capture_time (GstBuffer *buffer)
+{
+  static GstStaticCaps unix_caps = GST_STATIC_CAPS ("timestamp/x-unix");
+  GstReferenceTimestampMeta *meta;
+  GstCaps *caps;
+
+  caps = gst_static_caps_get (&unix_caps);
+  meta = gst_buffer_get_reference_timestamp_meta (buffer, caps);
+  gst_caps_unref (caps);
+  if (meta && GST_CLOCK_TIME_IS_VALID (meta->timestamp))
+    return meta->timestamp;
+
+  return (GstClockTime) g_get_real_time () * GST_USECOND;
+}
+
+/* Sends only the fd of the frame; a subscriber on the same host duplicates
+ * it with pidfd_getfd() and maps the memory itself.  The sample carries the
+ * boot id of this host, so subscribers elsewhere ignore the pid.
+ * Subscribers only map DMA-BUFs and memfds sealed against shrinking, so
+ * other fd memory is sealed here first. */
+static GstFlowReturn
+publish_dmabuffer (EdgefirstZenohPub *self, GstBuffer *buffer,
+    const EdgefirstCapsDesc *desc)
+{
+  GstMemory *mem;
+  GstVideoMeta *vmeta;
+  EdgefirstZenohDmaBufferMsg msg = { 0, };
+  GstClockTime ts;
+  GError *error = NULL;
+  gsize offset, size;
+
+  mem = gst_buffer_peek_memory (buffer, 0);
+  if (gst_buffer_n_memory (buffer) != 1 || !gst_is_fd_memory (mem)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT, (NULL),
+        ("message-type=dmabuffer needs buffers of a single DMA-BUF or "
+            "memfd memory"));
     return GST_FLOW_ERROR;
   }
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
+  if (!gst_is_dmabuf_memory (mem) &&
+      !edgefirst_zenoh_dmabuf_seal (gst_fd_memory_get_fd (mem), &error)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT, (NULL), ("%s", error->message));
+    g_clear_error (&error);
     return GST_FLOW_ERROR;
+  }
 
-  if (ros_image_encode (&out_bytes, &out_len,
-          0, 0, "", height, width, encoding, 0, step,
-          map.data, map.size) == 0) {
-    z_owned_bytes_t payload;
-    z_bytes_copy_from_buf (&payload, out_bytes, out_len);
-    z_publisher_put (z_loan (self->publisher), z_move (payload), NULL);
-    ros_bytes_free (out_bytes, out_len);
+  /* DmaBuffer has no offset field; the frame must start the fd */
+  size = gst_memory_get_sizes (mem, &offset, NULL);
+  if (offset != 0) {
+    GST_WARNING_OBJECT (self, "Memory starts %" G_GSIZE_FORMAT
+        " bytes into its fd, not publishing", offset);
+    return GST_FLOW_OK;
+  }
+
+  /* Header stamps are wall-clock time, as for Detect, so subscribers can
+   * compare them with max-age and timestamp-mode=sensor; the PTS is
+   * running time.  A capture time from upstream is kept when present. */
+  msg.frame_id = "";
+  ts = dmabuf_capture_time (buffer);
+  msg.stamp_sec = (int32_t) (ts / GST_SECOND);
+  msg.stamp_nanosec = (uint32_t) (ts % GST_SECOND);
+  msg.pid = (uint32_t) getpid ();
+  msg.fd = gst_fd_memory_get_fd (mem);
+  msg.width = desc->width;
+  msg.height = desc->height;
+  msg.fourcc = desc->fourcc;
+  msg.length = (uint32_t) size;
+  vmeta = gst_buffer_get_video_meta (buffer);
+  msg.stride = vmeta ? (uint32_t) vmeta->stride[0] : desc->stride;
+
+  /* Keep the frame alive, and its fd open, for dmabuf_hold more frames */
+  gst_buffer_replace (&self->dmabuf_held[self->dmabuf_held_idx], buffer);
+  self->dmabuf_held_idx = (self->dmabuf_held_idx + 1) % self->dmabuf_hold;
+
+  return publish_message (self, edgefirst_zenoh_encode_dmabuffer, &msg,
+      NULL, edgefirst_zenoh_dmabuf_attachment ());
+}
+
+/* ── Shared memory ─────────────────────────────────────────────────── */
+
+static void
+shm_provider_start (EdgefirstZenohPub *self)
+{
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+  z_owned_memory_layout_t layout;
+  z_alloc_alignment_t alignment = { 0 };
+
+  if (!edgefirst_zenoh_session_has_shm (self->session))
+    return;
+
+  if (z_memory_layout_new (&layout, self->shm_size, alignment) != Z_OK) {
+    GST_WARNING_OBJECT (self, "Invalid SHM layout of %u bytes",
+        self->shm_size);
+    return;
+  }
+
+  if (z_posix_shm_provider_new (&self->shm_provider,
+          z_loan (layout)) != Z_OK) {
+    GST_WARNING_OBJECT (self, "Failed to create SHM provider, publishing "
+        "through the network transport");
   } else {
-    GST_WARNING_OBJECT (self, "Failed to encode Image");
+    GST_INFO_OBJECT (self, "Publishing from a %u byte SHM pool",
+        self->shm_size);
+    self->shm_active = TRUE;
   }
+  z_drop (z_move (layout));
+#endif
+}
 
-  gst_buffer_unmap (buffer, &map);
-  return GST_FLOW_OK;
+static void
+shm_provider_stop (EdgefirstZenohPub *self)
+{
+#ifdef EDGEFIRST_ZENOH_HAVE_SHM
+  if (self->shm_active)
+    z_drop (z_move (self->shm_provider));
+#endif
+  self->shm_active = FALSE;
+}
+
+/* ── Caps descriptor ───────────────────────────────────────────────── */
+
+static EdgefirstCapsDesc *
+caps_desc_ref (EdgefirstCapsDesc *desc)
+{
+  g_atomic_int_inc (&desc->ref_count);
+  return desc;
+}
+
+static void
+caps_desc_unref (EdgefirstCapsDesc *desc)
+{
+  if (g_atomic_int_dec_and_test (&desc->ref_count))
+    g_free (desc);
+}
+
+static EdgefirstCapsDesc *
+caps_desc_new (GstCaps *caps)
+{
+  EdgefirstCapsDesc *desc = g_new0 (EdgefirstCapsDesc, 1);
+  GstStructure *s = gst_caps_get_structure (caps, 0);
+  GstVideoInfo info;
+  const gchar *str;
+  gint w = 0, h = 0, ps = 0;
+
+  desc->ref_count = 1;
+
+  if (gst_structure_has_name (s, "video/x-raw")) {
+    if (gst_video_info_from_caps (&info, caps)) {
+      desc->encoding =
+          gst_format_to_ros_encoding (GST_VIDEO_INFO_FORMAT (&info));
+      desc->width = (uint32_t) GST_VIDEO_INFO_WIDTH (&info);
+      desc->height = (uint32_t) GST_VIDEO_INFO_HEIGHT (&info);
+      desc->step = desc->width * (uint32_t) GST_VIDEO_INFO_COMP_PSTRIDE (&info,
+          0);
+      desc->fourcc = edgefirst_zenoh_fourcc_from_video_format
+          (GST_VIDEO_INFO_FORMAT (&info));
+      desc->stride = (uint32_t) GST_VIDEO_INFO_PLANE_STRIDE (&info, 0);
+    }
+    return desc;
+  }
+
+  gst_structure_get_int (s, "width", &w);
+  gst_structure_get_int (s, "height", &h);
+  gst_structure_get_int (s, "point-step", &ps);
+  desc->width = (uint32_t) w;
+  desc->height = (uint32_t) h;
+  desc->point_step = (uint32_t) ps;
+  desc->row_step = (uint32_t) (w * ps);
+  gst_structure_get_boolean (s, "is-bigendian", &desc->is_bigendian);
+  gst_structure_get_boolean (s, "is-dense", &desc->is_dense);
+  str = gst_structure_get_string (s, "fields");
+  desc->num_fields = edgefirst_parse_point_fields (str, desc->fields,
+      G_N_ELEMENTS (desc->fields));
+  desc->has_xyz = edgefirst_zenoh_find_xyz (desc->fields, desc->num_fields,
+      desc->xyz_offsets);
+
+  /* NNStreamer lists the innermost dimension first */
+  str = gst_structure_get_string (s, "dimensions");
+  if (str) {
+    gchar **tokens = g_strsplit (str, ":", -1);
+    guint n = g_strv_length (tokens);
+
+    for (guint i = n; i > 0 && desc->num_dims < G_N_ELEMENTS (desc->dims);
+        i--)
+      desc->dims[desc->num_dims++] =
+          (guint16) g_ascii_strtoull (tokens[i - 1], NULL, 10);
+    g_strfreev (tokens);
+  }
+
+  return desc;
+}
+
+/* ── Publish queue ─────────────────────────────────────────────────── */
+
+static GstFlowReturn
+publish_buffer (EdgefirstZenohPub *self, GstBuffer *buffer,
+    const EdgefirstCapsDesc *desc)
+{
+  GST_LOG_OBJECT (self, "Publishing buffer of size %" G_GSIZE_FORMAT,
+      gst_buffer_get_size (buffer));
+
+  if (!desc) {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("Buffer received before caps"));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  switch (self->message_type) {
+    case EDGEFIRST_ZENOH_PUB_POINTCLOUD2:
+      return publish_pointcloud2 (self, buffer, desc);
+    case EDGEFIRST_ZENOH_PUB_RADARCUBE:
+      return publish_radarcube (self, buffer, desc);
+    case EDGEFIRST_ZENOH_PUB_IMAGE:
+      return publish_image (self, buffer, desc);
+    case EDGEFIRST_ZENOH_PUB_DETECT:
+      return publish_detect (self, buffer);
+    case EDGEFIRST_ZENOH_PUB_DMABUFFER:
+      return publish_dmabuffer (self, buffer, desc);
+    default:
+      GST_ERROR_OBJECT (self, "Unknown message type: %d", self->message_type);
+      return GST_FLOW_ERROR;
+  }
+}
+
+static void
+publish_item_clear (EdgefirstPublishItem *item)
+{
+  gst_buffer_unref (item->buffer);
+  if (item->desc)
+    caps_desc_unref (item->desc);
+}
+
+/* Drains the ring so a slow or blocking Zenoh put never stalls the
+ * streaming thread */
+static gpointer
+publish_thread_func (gpointer data)
+{
+  EdgefirstZenohPub *self = data;
+  EdgefirstPublishItem item;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->lock);
+  while (TRUE) {
+    while (!self->stopping && self->ring_len == 0)
+      g_cond_wait (&self->cond, &self->lock);
+    if (self->stopping)
+      break;
+
+    item = self->ring[self->ring_head];
+    self->ring_head = (self->ring_head + 1) % self->queue_depth;
+    self->ring_len--;
+    self->publishing = TRUE;
+    g_mutex_unlock (&self->lock);
+
+    ret = publish_buffer (self, item.buffer, item.desc);
+    publish_item_clear (&item);
+
+    g_mutex_lock (&self->lock);
+    self->publishing = FALSE;
+    if (ret != GST_FLOW_OK && self->last_ret == GST_FLOW_OK)
+      self->last_ret = ret;
+    g_cond_broadcast (&self->drained_cond);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return NULL;
+}
+
+/* Queues @buffer for publish_thread, dropping the oldest queued buffer if
+ * the ring is full.  Returns the first error the thread ran into. */
+static GstFlowReturn
+publish_queue_push (EdgefirstZenohPub *self, GstBuffer *buffer)
+{
+  EdgefirstPublishItem *item;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->lock);
+  if (self->ring_len == self->queue_depth) {
+    GST_DEBUG_OBJECT (self, "Publish queue full, dropping oldest buffer");
+    self->stat_dropped++;
+    publish_item_clear (&self->ring[self->ring_head]);
+    self->ring_head = (self->ring_head + 1) % self->queue_depth;
+    self->ring_len--;
+  }
+
+  item = &self->ring[(self->ring_head + self->ring_len) % self->queue_depth];
+  item->buffer = gst_buffer_ref (buffer);
+  item->desc = self->desc ? caps_desc_ref (self->desc) : NULL;
+  self->ring_len++;
+  g_cond_signal (&self->cond);
+
+  ret = self->last_ret;
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
+/* Waits until everything queued before EOS has been handed to Zenoh */
+static void
+publish_queue_drain (EdgefirstZenohPub *self)
+{
+  g_mutex_lock (&self->lock);
+  while (!self->stopping && (self->ring_len > 0 || self->publishing))
+    g_cond_wait (&self->drained_cond, &self->lock);
+  g_mutex_unlock (&self->lock);
+}
+
+static void
+publish_queue_flush (EdgefirstZenohPub *self)
+{
+  g_mutex_lock (&self->lock);
+  while (self->ring_len > 0) {
+    publish_item_clear (&self->ring[self->ring_head]);
+    self->ring_head = (self->ring_head + 1) % self->queue_depth;
+    self->ring_len--;
+  }
+  self->last_ret = GST_FLOW_OK;
+  g_cond_broadcast (&self->drained_cond);
+  g_mutex_unlock (&self->lock);
 }
 
 /* ── Start / Stop / Render ─────────────────────────────────────────── */
 
+static z_priority_t
+zenoh_priority (EdgefirstZenohPubPriority priority)
+{
+  switch (priority) {
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_REAL_TIME:
+      return Z_PRIORITY_REAL_TIME;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_HIGH:
+      return Z_PRIORITY_INTERACTIVE_HIGH;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_LOW:
+      return Z_PRIORITY_INTERACTIVE_LOW;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_HIGH:
+      return Z_PRIORITY_DATA_HIGH;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_LOW:
+      return Z_PRIORITY_DATA_LOW;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_BACKGROUND:
+      return Z_PRIORITY_BACKGROUND;
+    case EDGEFIRST_ZENOH_PUB_PRIORITY_DATA:
+    default:
+      return Z_PRIORITY_DATA;
+  }
+}
+
+static void
+publisher_options_init (EdgefirstZenohPub *self, z_publisher_options_t *opts)
+{
+  z_publisher_options_default (opts);
+
+  opts->congestion_control =
+      self->congestion_control == EDGEFIRST_ZENOH_PUB_CONGESTION_BLOCK ?
+      Z_CONGESTION_CONTROL_BLOCK : Z_CONGESTION_CONTROL_DROP;
+  opts->priority = zenoh_priority (self->priority);
+  opts->is_express = self->express;
+
+  /* Per-publisher reliability is part of the zenoh-c unstable API */
+#ifdef Z_FEATURE_UNSTABLE_API
+  opts->reliability = self->reliable ?
+      Z_RELIABILITY_RELIABLE : Z_RELIABILITY_BEST_EFFORT;
+#else
+  if (!self->reliable)
+    GST_WARNING_OBJECT (self, "reliable=false needs zenoh-c built with the "
+        "unstable API, publishing reliably");
+#endif
+}
+
+/* Runs on a Zenoh thread whenever the first subscriber appears or the last
+ * one goes away */
+static void
+matching_status_cb (const z_matching_status_t *status, void *context)
+{
+  EdgefirstZenohPub *self = context;
+
+  GST_DEBUG_OBJECT (self, "Subscribers %s", status->matching ?
+      "matched" : "gone");
+  g_atomic_int_set (&self->matched, status->matching);
+}
+
+static void
+matching_listener_start (EdgefirstZenohPub *self)
+{
+  z_owned_closure_matching_status_t closure;
+  z_matching_status_t status;
+
+  /* Until told otherwise assume a subscriber, so a listener failure never
+   * silences the topic */
+  g_atomic_int_set (&self->matched, TRUE);
+
+  z_closure_matching_status (&closure, matching_status_cb, NULL, self);
+  if (z_publisher_declare_background_matching_listener (z_loan
+          (self->publisher), z_move (closure)) != Z_OK) {
+    GST_WARNING_OBJECT (self, "Failed to declare matching listener, "
+        "publishing unconditionally");
+    return;
+  }
+
+  if (z_publisher_get_matching_status (z_loan (self->publisher),
+          &status) == Z_OK)
+    g_atomic_int_set (&self->matched, status.matching);
+}
+
+static const gchar *
+compression_nick (EdgefirstZenohPubCompression compression)
+{
+  GEnumClass *klass = g_type_class_peek (EDGEFIRST_TYPE_ZENOH_PUB_COMPRESSION);
+  GEnumValue *value = g_enum_get_value (klass, compression);
+
+  return value ? value->value_nick : "unknown";
+}
+
 static gboolean
 edgefirst_zenoh_pub_start (GstBaseSink *sink)
 {
   EdgefirstZenohPub *self = EDGEFIRST_ZENOH_PUB (sink);
   z_view_keyexpr_t ke;
+  z_publisher_options_t opts;
 
   if (!self->topic) {
     GST_ERROR_OBJECT (self, "No topic specified");
     return FALSE;
   }
 
+  if (!edgefirst_zenoh_compression_available (self->compression)) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, (NULL),
+        ("compression=%s is not available in this build",
+            compression_nick (self->compression)));
+    return FALSE;
+  }
+
   GST_INFO_OBJECT (self, "Starting Zenoh publisher on topic: %s", self->topic);
 
-  if (!open_zenoh_session (self))
+  self->session = edgefirst_zenoh_session_obtain (GST_ELEMENT (self),
+      self->session_config, self->shm);
+  if (!self->session) {
+    GST_ERROR_OBJECT (self, "Failed to open Zenoh session");
     return FALSE;
+  }
 
   z_view_keyexpr_from_str (&ke, self->topic);
+  publisher_options_init (self, &opts);
 
-  if (z_declare_publisher (z_loan (self->session), &self->publisher,
-          z_loan (ke), NULL) != Z_OK) {
+  if (z_declare_publisher (edgefirst_zenoh_session_loan (self->session),
+          &self->publisher, z_loan (ke), &opts) != Z_OK) {
     GST_ERROR_OBJECT (self, "Failed to create publisher for: %s", self->topic);
-    z_drop (z_move (self->session));
-    self->session_valid = FALSE;
+    g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
     return FALSE;
   }
 
+  if (self->shm)
+    shm_provider_start (self);
+
+  matching_listener_start (self);
+
+  if (self->compression != EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE)
+    self->codec = edgefirst_zenoh_codec_new ();
+
+  self->dmabuf_held = g_new0 (GstBuffer *, self->dmabuf_hold);
+  self->dmabuf_held_idx = 0;
+
+  self->stat_published = 0;
+  self->stat_skipped = 0;
+  self->stat_dropped = 0;
+  self->ring_head = 0;
+  self->ring_len = 0;
+  self->publishing = FALSE;
+  self->stopping = FALSE;
+  self->last_ret = GST_FLOW_OK;
+  if (self->queue_depth > 0) {
+    self->ring = g_new (EdgefirstPublishItem, self->queue_depth);
+    self->publish_thread = g_thread_new ("zenohpub", publish_thread_func,
+        self);
+  }
+
   return TRUE;
 }
 
@@ -569,36 +1375,140 @@ edgefirst_zenoh_pub_stop (GstBaseSink *sink)
 
   GST_INFO_OBJECT (self, "Stopping Zenoh publisher");
 
+  if (self->publish_thread) {
+    g_mutex_lock (&self->lock);
+    self->stopping = TRUE;
+    g_cond_broadcast (&self->cond);
+    g_cond_broadcast (&self->drained_cond);
+    g_mutex_unlock (&self->lock);
+
+    g_thread_join (self->publish_thread);
+    self->publish_thread = NULL;
+
+    publish_queue_flush (self);
+    g_clear_pointer (&self->ring, g_free);
+  }
+
   z_drop (z_move (self->publisher));
+  shm_provider_stop (self);
 
-  if (self->session_valid) {
-    z_drop (z_move (self->session));
-    self->session_valid = FALSE;
+  if (self->dmabuf_held) {
+    for (guint i = 0; i < self->dmabuf_hold; i++)
+      gst_clear_buffer (&self->dmabuf_held[i]);
+    g_clear_pointer (&self->dmabuf_held, g_free);
   }
 
+  g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
+  g_clear_pointer (&self->desc, caps_desc_unref);
+  g_clear_pointer (&self->codec, edgefirst_zenoh_codec_free);
+
+  return TRUE;
+}
+
+static gboolean
+edgefirst_zenoh_pub_set_caps (GstBaseSink *sink, GstCaps *caps)
+{
+  EdgefirstZenohPub *self = EDGEFIRST_ZENOH_PUB (sink);
+  EdgefirstCapsDesc *desc = caps_desc_new (caps);
+
+  if (self->message_type == EDGEFIRST_ZENOH_PUB_IMAGE && !desc->encoding) {
+    GST_ERROR_OBJECT (self, "No ROS encoding for caps %" GST_PTR_FORMAT, caps);
+    caps_desc_unref (desc);
+    return FALSE;
+  }
+
+  if (self->message_type == EDGEFIRST_ZENOH_PUB_DMABUFFER && !desc->fourcc) {
+    GST_ERROR_OBJECT (self, "No DmaBuffer fourcc for caps %" GST_PTR_FORMAT,
+        caps);
+    caps_desc_unref (desc);
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (self, "Caps %" GST_PTR_FORMAT ": %u fields, %u dims",
+      caps, desc->num_fields, desc->num_dims);
+
+  if (self->desc)
+    caps_desc_unref (self->desc);
+  self->desc = desc;
+
+  return TRUE;
+}
+
+/* DmaBuffer frames stay referenced after render, in the publish queue and
+ * the dmabuf-hold ring; ask upstream pools for that many extra buffers so
+ * they are not starved */
+static gboolean
+edgefirst_zenoh_pub_propose_allocation (GstBaseSink *sink, GstQuery *query)
+{
+  EdgefirstZenohPub *self = EDGEFIRST_ZENOH_PUB (sink);
+  GstCaps *caps;
+  GstVideoInfo info;
+  guint size = 0;
+
+  if (self->message_type != EDGEFIRST_ZENOH_PUB_DMABUFFER)
+    return TRUE;
+
+  /* publish_dmabuffer() sends the GstVideoMeta stride */
+  gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+
+  gst_query_parse_allocation (query, &caps, NULL);
+  if (caps && gst_video_info_from_caps (&info, caps))
+    size = (guint) GST_VIDEO_INFO_SIZE (&info);
+
+  gst_query_add_allocation_pool (query, NULL, size,
+      self->dmabuf_hold + self->queue_depth, 0);
   return TRUE;
 }
 
+static gboolean
+edgefirst_zenoh_pub_event (GstBaseSink *sink, GstEvent *event)
+{
+  EdgefirstZenohPub *self = EDGEFIRST_ZENOH_PUB (sink);
+
+  if (self->publish_thread) {
+    switch (GST_EVENT_TYPE (event)) {
+      case GST_EVENT_EOS:
+        publish_queue_drain (self);
+        break;
+      case GST_EVENT_FLUSH_STOP:
+        publish_queue_flush (self);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return GST_BASE_SINK_CLASS (parent_class)->event (sink, event);
+}
+
 static GstFlowReturn
 edgefirst_zenoh_pub_render (GstBaseSink *sink, GstBuffer *buffer)
 {
   EdgefirstZenohPub *self = EDGEFIRST_ZENOH_PUB (sink);
 
-  GST_LOG_OBJECT (self, "Publishing buffer of size %" G_GSIZE_FORMAT,
-      gst_buffer_get_size (buffer));
-
-  switch (self->message_type) {
-    case EDGEFIRST_ZENOH_PUB_POINTCLOUD2:
-      return publish_pointcloud2 (self, buffer);
-    case EDGEFIRST_ZENOH_PUB_RADARCUBE:
-      return publish_radarcube (self, buffer);
-    case EDGEFIRST_ZENOH_PUB_IMAGE:
-      return publish_image (self, buffer);
-    case EDGEFIRST_ZENOH_PUB_DMABUFFER:
-      GST_WARNING_OBJECT (self, "DMA buffer publishing not yet implemented");
-      return GST_FLOW_OK;
-    default:
-      GST_ERROR_OBJECT (self, "Unknown message type: %d", self->message_type);
-      return GST_FLOW_ERROR;
+  /* Nobody listening: skip mapping and encoding entirely */
+  if (self->publish_when == EDGEFIRST_ZENOH_PUB_PUBLISH_MATCHED &&
+      !g_atomic_int_get (&self->matched)) {
+    g_mutex_lock (&self->lock);
+    self->stat_skipped++;
+    g_mutex_unlock (&self->lock);
+    return GST_FLOW_OK;
   }
+
+  if (self->publish_thread)
+    return publish_queue_push (self, buffer);
+
+  return publish_buffer (self, buffer, self->desc);
+}
+
+static GstFlowReturn
+edgefirst_zenoh_pub_render_list (GstBaseSink *sink, GstBufferList *list)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint n = gst_buffer_list_length (list);
+
+  for (guint i = 0; i < n && ret == GST_FLOW_OK; i++)
+    ret = edgefirst_zenoh_pub_render (sink, gst_buffer_list_get (list, i));
+
+  return ret;
 }
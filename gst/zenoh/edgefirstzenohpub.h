@@ -21,6 +21,7 @@ G_DECLARE_FINAL_TYPE (EdgefirstZenohPub, edgefirst_zenoh_pub, EDGEFIRST, ZENOH_P
  * @EDGEFIRST_ZENOH_PUB_RADARCUBE: RadarCube message
  * @EDGEFIRST_ZENOH_PUB_IMAGE: sensor_msgs/Image message
  * @EDGEFIRST_ZENOH_PUB_DMABUFFER: edgefirst/DmaBuffer message
+ * @EDGEFIRST_ZENOH_PUB_DETECT: edgefirst_msgs/Detect message from #EdgefirstDetectionMeta
  *
  * Message types supported by the Zenoh publisher.
  */
@@ -29,8 +30,72 @@ typedef enum {
   EDGEFIRST_ZENOH_PUB_RADARCUBE = 1,
   EDGEFIRST_ZENOH_PUB_IMAGE = 2,
   EDGEFIRST_ZENOH_PUB_DMABUFFER = 3,
+  EDGEFIRST_ZENOH_PUB_DETECT = 4,
 } EdgefirstZenohPubMessageType;
 
+/**
+ * EdgefirstZenohPubCongestionControl:
+ * @EDGEFIRST_ZENOH_PUB_CONGESTION_DROP: Drop messages when the transport is congested
+ * @EDGEFIRST_ZENOH_PUB_CONGESTION_BLOCK: Block the publishing thread until there is room
+ *
+ * Zenoh congestion control of the publisher.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_PUB_CONGESTION_DROP = 0,
+  EDGEFIRST_ZENOH_PUB_CONGESTION_BLOCK = 1,
+} EdgefirstZenohPubCongestionControl;
+
+/**
+ * EdgefirstZenohPubPriority:
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_REAL_TIME: Highest priority
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_HIGH: Interactive, high
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_LOW: Interactive, low
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_HIGH: Data, high
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_DATA: Data (Zenoh default)
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_LOW: Data, low
+ * @EDGEFIRST_ZENOH_PUB_PRIORITY_BACKGROUND: Lowest priority
+ *
+ * Zenoh transport priority of the publisher.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_PUB_PRIORITY_REAL_TIME = 1,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_HIGH = 2,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_INTERACTIVE_LOW = 3,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_HIGH = 4,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_DATA = 5,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_DATA_LOW = 6,
+  EDGEFIRST_ZENOH_PUB_PRIORITY_BACKGROUND = 7,
+} EdgefirstZenohPubPriority;
+
+/**
+ * EdgefirstZenohPubPublishWhen:
+ * @EDGEFIRST_ZENOH_PUB_PUBLISH_ALWAYS: Publish every buffer
+ * @EDGEFIRST_ZENOH_PUB_PUBLISH_MATCHED: Skip buffers while no subscriber matches the topic
+ *
+ * When the publisher encodes and sends buffers.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_PUB_PUBLISH_ALWAYS = 0,
+  EDGEFIRST_ZENOH_PUB_PUBLISH_MATCHED = 1,
+} EdgefirstZenohPubPublishWhen;
+
+/**
+ * EdgefirstZenohPubCompression:
+ * @EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE: Publish point data uncompressed
+ * @EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4: LZ4 frame, lossless
+ * @EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD: Zstandard, lossless
+ * @EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD: x/y/z quantized to a
+ *   fixed millimetre precision, then Zstandard
+ *
+ * Compression of the PointCloud2 data sequence.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_PUB_COMPRESSION_NONE = 0,
+  EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4 = 1,
+  EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD = 2,
+  EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD = 3,
+} EdgefirstZenohPubCompression;
+
 G_END_DECLS
 
 #endif /* __EDGEFIRST_ZENOH_PUB_H__ */
@@ -10,22 +10,33 @@
 
 #include "edgefirstzenohsub.h"
 #include "edgefirstzenoh-enums.h"
-#include "transform-cache.h"
-#include <gst/edgefirst/edgefirst.h>
-#include <gst/video/video.h>
-#include <edgefirst/schemas.h>
+#include "edgefirstzenoh-session.h"
+#include "edgefirstzenoh-decode.h"
+#include "edgefirstzenoh-clocksync.h"
+#include "edgefirstzenoh-queue.h"
+#include <gst/allocators/gstdmabuf.h>
 #include <zenoh.h>
+#include <unistd.h>
 #include <string.h>
 
 GST_DEBUG_CATEGORY_STATIC (edgefirst_zenoh_sub_debug);
 #define GST_CAT_DEFAULT edgefirst_zenoh_sub_debug
 
-#define BUFFER_QUEUE_MAX 16
+#define DEFAULT_QUEUE_DEPTH 16
+#define DEFAULT_LEAKY EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM
+#define DEFAULT_MAX_AGE 0
+#define DEFAULT_MIN_INTERVAL 0
+#define DEFAULT_TIMESTAMP_MODE EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL
 
-/* Queue item carrying both buffer and caps from callback to streaming thread */
+/* Measured latency above the last reported value that triggers a latency
+ * message, so jitter does not cause constant reconfiguration */
+#define LATENCY_REPORT_THRESHOLD GST_MSECOND
+
+/* Queue item carrying an undecoded sample from callback to streaming thread */
 typedef struct {
-  GstBuffer *buf;
-  GstCaps *caps;   /* may be NULL */
+  z_owned_sample_t sample;
+  GstClockTime received;   /* gst_util_get_timestamp() at arrival */
+  gint fd;                 /* dmabuffer mode: imported frame fd, else -1 */
 } EdgefirstQueueItem;
 
 enum {
@@ -34,6 +45,18 @@ enum {
   PROP_MESSAGE_TYPE,
   PROP_SESSION,
   PROP_RELIABLE,
+  PROP_ZERO_COPY,
+  PROP_SHM,
+  PROP_QUEUE_DEPTH,
+  PROP_LEAKY,
+  PROP_MAX_AGE,
+  PROP_FRAME_ID,
+  PROP_MIN_INTERVAL,
+  PROP_NORMALIZE_LAYOUT,
+  PROP_TIMESTAMP_MODE,
+  PROP_TF_TOPIC,
+  PROP_TARGET_FRAME,
+  PROP_STATS,
 };
 
 struct _EdgefirstZenohSub {
@@ -44,22 +67,57 @@ struct _EdgefirstZenohSub {
   EdgefirstZenohSubMessageType message_type;
   gchar *session_config;
   gboolean reliable;
+  gboolean zero_copy;
+  gboolean shm;
+  guint queue_depth;              /* protected by lock */
+  EdgefirstZenohSubLeaky leaky;   /* protected by lock */
+  EdgefirstZenohHeaderFilter filter;   /* protected by lock */
+  gchar *frame_id;
+  gboolean normalize_layout;
+  EdgefirstZenohSubTimestampMode timestamp_mode;
+  gchar *tf_topic;
+  gchar *target_frame;
 
   /* Runtime state */
   gboolean started;
+  gboolean private_session;   /* protected by lock; leaky=none at start */
   GMutex lock;
-  GCond cond;
-  GQueue *buffer_queue;   /* of EdgefirstQueueItem* */
-  GstCaps *last_caps;     /* set on streaming thread only */
+  GCond cond;             /* signalled when a sample is queued */
 
-  /* Transform cache for /tf_static */
-  EdgefirstTransformCache *transform_cache;
+  /* Buffers and caps from samples, streaming thread only */
+  EdgefirstZenohDecoder decoder;
+
+  /* Pending samples, protected by lock; its counters are the dropped and
+   * queue-high-water statistics */
+  EdgefirstZenohQueue queue;
+
+  /* Statistics, protected by lock */
+  guint64 stat_received;
+  guint64 stat_decoded;
+  guint64 stat_decode_failures;
+  guint64 stat_filtered;
+
+  /* timestamp-mode=sensor: stamp mapping, streaming thread only */
+  EdgefirstZenohClockSync clock_sync;
+
+  /* Measured and last reported latency, protected by lock */
+  GstClockTime latency;
+  GstClockTime reported_latency;
+  gboolean latency_posted;
+
+  /* dmabuffer mode: fds are duplicated from the publisher process on
+   * arrival, while the publisher still holds the frame */
+  GMutex import_lock;
+  EdgefirstZenohFdImporter fd_importer;   /* protected by import_lock */
 
   /* Zenoh session and subscriber handles */
-  z_owned_session_t session;
+  EdgefirstZenohSession *session;   /* see edgefirstzenoh-session.h */
   z_owned_subscriber_t subscriber;
-  z_owned_subscriber_t tf_subscriber;
-  gboolean session_valid;
+
+  /* rt/tf_static and tf-topic transforms, owned by the session and shared
+   * with every element on it; NULL when stopped */
+  EdgefirstTransformCache *transform_cache;
+  gchar *tf_topic_active;   /* tf-topic at start, released at stop */
 };
 
 static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
@@ -67,7 +125,8 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS (EDGEFIRST_POINTCLOUD2_CAPS "; "
         "other/tensors, num-tensors = (int) 1; "
-        "video/x-raw")
+        "video/x-raw; "
+        "video/x-raw(" GST_CAPS_FEATURE_MEMORY_DMABUF ")")
     );
 
 #define edgefirst_zenoh_sub_parent_class parent_class
@@ -79,46 +138,113 @@ static void edgefirst_zenoh_sub_get_property (GObject *object, guint prop_id,
     GValue *value, GParamSpec *pspec);
 static void edgefirst_zenoh_sub_finalize (GObject *object);
 
+static GstStateChangeReturn edgefirst_zenoh_sub_change_state (
+    GstElement *element, GstStateChange transition);
 static gboolean edgefirst_zenoh_sub_start (GstBaseSrc *src);
 static gboolean edgefirst_zenoh_sub_stop (GstBaseSrc *src);
+static gboolean edgefirst_zenoh_sub_decide_allocation (GstBaseSrc *src,
+    GstQuery *query);
+static gboolean edgefirst_zenoh_sub_query (GstBaseSrc *src, GstQuery *query);
 static GstFlowReturn edgefirst_zenoh_sub_create (GstPushSrc *src, GstBuffer **buf);
 
 /* ── Forward declarations for callbacks ────────────────────────────── */
 
 static void zenoh_sub_data_handler (z_loaned_sample_t *sample, void *context);
-static void zenoh_sub_tf_handler (z_loaned_sample_t *sample, void *context);
 
-/* ── Helper: push buffer + caps to queue ───────────────────────────── */
+/* ── Pending sample queue ──────────────────────────────────────────── */
 
 static void
-queue_item_free (EdgefirstQueueItem *item)
+queue_item_clear (gpointer data)
 {
-  gst_buffer_unref (item->buf);
-  gst_clear_caps (&item->caps);
-  g_free (item);
+  EdgefirstQueueItem *item = data;
+
+  z_drop (z_move (item->sample));
+  if (item->fd >= 0)
+    close (item->fd);
+  item->fd = -1;
 }
 
+/* ── Helper: push sample to queue ──────────────────────────────────── */
+
+/* Takes a reference on the received sample; decoding is deferred to the
+ * streaming thread so samples dropped here cost no decode work.  The header
+ * filters run first, on the header alone, so unwanted samples never take a
+ * queue slot or evict wanted ones.  A DmaBuffer fd is only valid while the
+ * publisher holds the frame, so it is imported here, before the sample can
+ * wait in the queue. */
 static void
-push_to_queue (EdgefirstZenohSub *self, GstBuffer *buffer, GstCaps *caps)
+push_to_queue (EdgefirstZenohSub *self, const z_loaned_sample_t *sample)
 {
-  EdgefirstQueueItem *item = g_new0 (EdgefirstQueueItem, 1);
-  item->buf = buffer;
-  item->caps = caps;   /* takes ownership, may be NULL */
+  GstClockTime received = gst_util_get_timestamp ();
+  EdgefirstQueueItem *item;
+  gint fd = -1;
 
   g_mutex_lock (&self->lock);
+  if (!edgefirst_zenoh_header_filter_sample (&self->filter, FALSE, sample)) {
+    self->stat_received++;
+    self->stat_filtered++;
+    g_mutex_unlock (&self->lock);
+    GST_LOG_OBJECT (self, "Filtered sample");
+    return;
+  }
+  g_mutex_unlock (&self->lock);
+
+  if (self->message_type == EDGEFIRST_ZENOH_MSG_DMABUFFER) {
+    g_mutex_lock (&self->import_lock);
+    fd = edgefirst_zenoh_import_dmabuffer (GST_ELEMENT (self),
+        &self->fd_importer, sample);
+    g_mutex_unlock (&self->import_lock);
+    if (fd < 0) {
+      g_mutex_lock (&self->lock);
+      self->stat_received++;
+      self->stat_decode_failures++;
+      g_mutex_unlock (&self->lock);
+      return;
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  self->stat_received++;
 
-  /* Drop oldest if queue is full */
-  while (g_queue_get_length (self->buffer_queue) >= BUFFER_QUEUE_MAX) {
-    EdgefirstQueueItem *old = g_queue_pop_head (self->buffer_queue);
-    GST_DEBUG_OBJECT (self, "Dropping oldest buffer from queue");
-    queue_item_free (old);
+  /* Under leaky=none this back-pressures the Zenoh RX thread, which the
+   * queue only allows in PLAYING on a private session, see change_state */
+  item = edgefirst_zenoh_queue_push (&self->queue, &self->lock);
+  if (!item) {
+    GST_DEBUG_OBJECT (self, "Queue full, dropping new sample");
+    g_mutex_unlock (&self->lock);
+    if (fd >= 0)
+      close (fd);
+    return;
   }
 
-  g_queue_push_tail (self->buffer_queue, item);
+  z_sample_clone (&item->sample, sample);
+  item->received = received;
+  item->fd = fd;
+
   g_cond_signal (&self->cond);
   g_mutex_unlock (&self->lock);
 }
 
+static GstStructure *
+get_stats (EdgefirstZenohSub *self)
+{
+  GstStructure *s;
+
+  g_mutex_lock (&self->lock);
+  s = gst_structure_new ("application/x-edgefirst-zenoh-sub-stats",
+      "received", G_TYPE_UINT64, self->stat_received,
+      "decoded", G_TYPE_UINT64, self->stat_decoded,
+      "dropped", G_TYPE_UINT64, self->queue.dropped,
+      "decode-failures", G_TYPE_UINT64, self->stat_decode_failures,
+      "filtered", G_TYPE_UINT64, self->stat_filtered,
+      "queue-high-water", G_TYPE_UINT, self->queue.high_water,
+      "latency", G_TYPE_UINT64, self->latency,
+      NULL);
+  g_mutex_unlock (&self->lock);
+
+  return s;
+}
+
 /* ── Class init ────────────────────────────────────────────────────── */
 
 static void
@@ -155,6 +281,97 @@ edgefirst_zenoh_sub_class_init (EdgefirstZenohSubClass *klass)
           "Use reliable QoS for message delivery",
           TRUE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_ZERO_COPY,
+      g_param_spec_boolean ("zero-copy", "Zero Copy",
+          "Wrap the received Zenoh payload in the output buffer instead of "
+          "copying it (keeps the network buffer alive until downstream "
+          "releases the buffer)",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SHM,
+      g_param_spec_boolean ("shm", "Shared Memory",
+          "Use the Zenoh shared-memory transport for same-host publishers "
+          "and wrap received SHM buffers without copying (implies zero-copy)",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_DEPTH,
+      g_param_spec_uint ("queue-depth", "Queue Depth",
+          "Maximum number of received samples waiting to be decoded",
+          1, G_MAXUINT, DEFAULT_QUEUE_DEPTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_LEAKY,
+      g_param_spec_enum ("leaky", "Leaky",
+          "What to do when the queue is full: block the Zenoh callback "
+          "(none), drop the new sample (upstream), drop the oldest sample "
+          "(downstream) or keep only the newest sample (latest-only). "
+          "none opens a Zenoh session for this element alone at start, so "
+          "that stalling its receive thread does not stall other elements; "
+          "outside PLAYING, or when set to none after start, it drops the "
+          "oldest",
+          EDGEFIRST_TYPE_ZENOH_SUB_LEAKY, DEFAULT_LEAKY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_AGE,
+      g_param_spec_uint ("max-age", "Maximum Age",
+          "Drop messages whose header stamp is older than this many "
+          "milliseconds on arrival (0 = no limit)",
+          0, G_MAXUINT, DEFAULT_MAX_AGE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_FRAME_ID,
+      g_param_spec_string ("frame-id", "Frame ID",
+          "Comma-separated header frame_id values to accept, for wildcard "
+          "topics (NULL = any)",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MIN_INTERVAL,
+      g_param_spec_uint ("min-interval", "Minimum Interval",
+          "Drop messages stamped less than this many milliseconds after "
+          "the last accepted one of the same frame_id (0 = keep all)",
+          0, G_MAXUINT, DEFAULT_MIN_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_PLAYING));
+
+  g_object_class_install_property (gobject_class, PROP_NORMALIZE_LAYOUT,
+      g_param_spec_boolean ("normalize-layout", "Normalize Layout",
+          "Convert point clouds to packed FLOAT32 x, y, z, intensity in "
+          "host byte order while copying them out of the message",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TIMESTAMP_MODE,
+      g_param_spec_enum ("timestamp-mode", "Timestamp Mode",
+          "Buffer timestamps: running time of arrival, or the message "
+          "header stamp mapped onto the pipeline clock with drift and "
+          "jitter removed (sensor)",
+          EDGEFIRST_TYPE_ZENOH_SUB_TIMESTAMP_MODE, DEFAULT_TIMESTAMP_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TF_TOPIC,
+      g_param_spec_string ("tf-topic", "TF Topic",
+          "Topic of time-varying TransformStamped messages; point clouds "
+          "get the transform interpolated at their header stamp "
+          "(NULL = static transforms only)",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TARGET_FRAME,
+      g_param_spec_string ("target-frame", "Target Frame",
+          "Frame the attached point cloud transform maps into, resolved "
+          "through the transform tree (NULL = parent of the cloud frame)",
+          NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Receive statistics: received, decoded, dropped, decode-failures, "
+          "filtered, queue-high-water and latency",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "EdgeFirst Zenoh Subscriber",
       "Source/Network",
@@ -163,8 +380,13 @@ edgefirst_zenoh_sub_class_init (EdgefirstZenohSubClass *klass)
 
   gst_element_class_add_static_pad_template (element_class, &src_template);
 
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_change_state);
   basesrc_class->start = GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_start);
   basesrc_class->stop = GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_stop);
+  basesrc_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_decide_allocation);
+  basesrc_class->query = GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_query);
   pushsrc_class->create = GST_DEBUG_FUNCPTR (edgefirst_zenoh_sub_create);
 
   GST_DEBUG_CATEGORY_INIT (edgefirst_zenoh_sub_debug, "edgefirstzenohsub", 0,
@@ -178,14 +400,35 @@ edgefirst_zenoh_sub_init (EdgefirstZenohSub *self)
   self->message_type = EDGEFIRST_ZENOH_MSG_POINTCLOUD2;
   self->session_config = NULL;
   self->reliable = TRUE;
+  self->zero_copy = FALSE;
+  self->shm = FALSE;
+  self->queue_depth = DEFAULT_QUEUE_DEPTH;
+  self->leaky = DEFAULT_LEAKY;
+  edgefirst_zenoh_header_filter_init (&self->filter);
+  self->filter.max_age = DEFAULT_MAX_AGE;
+  self->filter.min_interval = DEFAULT_MIN_INTERVAL;
+  self->frame_id = NULL;
+  self->normalize_layout = FALSE;
+  self->timestamp_mode = DEFAULT_TIMESTAMP_MODE;
+  self->tf_topic = NULL;
+  self->target_frame = NULL;
   self->started = FALSE;
-  self->session_valid = FALSE;
+  self->private_session = FALSE;
 
   g_mutex_init (&self->lock);
   g_cond_init (&self->cond);
-  self->buffer_queue = g_queue_new ();
-  self->last_caps = NULL;
-  self->transform_cache = edgefirst_transform_cache_new ();
+  g_mutex_init (&self->import_lock);
+  edgefirst_zenoh_queue_init (&self->queue, sizeof (EdgefirstQueueItem),
+      DEFAULT_QUEUE_DEPTH, queue_item_clear);
+  edgefirst_zenoh_queue_set_leaky (&self->queue, DEFAULT_LEAKY);
+  edgefirst_zenoh_decoder_init (&self->decoder, GST_ELEMENT (self));
+  self->transform_cache = NULL;
+  self->tf_topic_active = NULL;
+  edgefirst_zenoh_fd_importer_init (&self->fd_importer);
+  edgefirst_zenoh_clock_sync_reset (&self->clock_sync);
+  self->latency = 0;
+  self->reported_latency = 0;
+  self->latency_posted = FALSE;
 
   gst_base_src_set_live (GST_BASE_SRC (self), TRUE);
   gst_base_src_set_format (GST_BASE_SRC (self), GST_FORMAT_TIME);
@@ -198,11 +441,15 @@ edgefirst_zenoh_sub_finalize (GObject *object)
 
   g_free (self->topic);
   g_free (self->session_config);
+  g_free (self->frame_id);
+  edgefirst_zenoh_header_filter_clear (&self->filter);
+  g_free (self->tf_topic);
+  g_free (self->target_frame);
   g_mutex_clear (&self->lock);
   g_cond_clear (&self->cond);
-  g_queue_free_full (self->buffer_queue, (GDestroyNotify) queue_item_free);
-  gst_clear_caps (&self->last_caps);
-  edgefirst_transform_cache_free (self->transform_cache);
+  g_mutex_clear (&self->import_lock);
+  edgefirst_zenoh_queue_clear (&self->queue);
+  edgefirst_zenoh_decoder_clear (&self->decoder);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -228,6 +475,56 @@ edgefirst_zenoh_sub_set_property (GObject *object, guint prop_id,
     case PROP_RELIABLE:
       self->reliable = g_value_get_boolean (value);
       break;
+    case PROP_ZERO_COPY:
+      self->zero_copy = g_value_get_boolean (value);
+      break;
+    case PROP_SHM:
+      self->shm = g_value_get_boolean (value);
+      break;
+    case PROP_QUEUE_DEPTH:
+      g_mutex_lock (&self->lock);
+      self->queue_depth = g_value_get_uint (value);
+      edgefirst_zenoh_queue_resize (&self->queue, self->queue_depth);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_LEAKY:
+      g_mutex_lock (&self->lock);
+      self->leaky = g_value_get_enum (value);
+      edgefirst_zenoh_queue_set_leaky (&self->queue, self->leaky);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MAX_AGE:
+      g_mutex_lock (&self->lock);
+      self->filter.max_age = g_value_get_uint (value);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_FRAME_ID:
+      g_free (self->frame_id);
+      self->frame_id = g_value_dup_string (value);
+      g_mutex_lock (&self->lock);
+      edgefirst_zenoh_header_filter_set_frame_ids (&self->filter,
+          self->frame_id);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MIN_INTERVAL:
+      g_mutex_lock (&self->lock);
+      self->filter.min_interval = g_value_get_uint (value);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_NORMALIZE_LAYOUT:
+      self->normalize_layout = g_value_get_boolean (value);
+      break;
+    case PROP_TIMESTAMP_MODE:
+      self->timestamp_mode = g_value_get_enum (value);
+      break;
+    case PROP_TF_TOPIC:
+      g_free (self->tf_topic);
+      self->tf_topic = g_value_dup_string (value);
+      break;
+    case PROP_TARGET_FRAME:
+      g_free (self->target_frame);
+      self->target_frame = g_value_dup_string (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -253,454 +550,200 @@ edgefirst_zenoh_sub_get_property (GObject *object, guint prop_id,
     case PROP_RELIABLE:
       g_value_set_boolean (value, self->reliable);
       break;
+    case PROP_ZERO_COPY:
+      g_value_set_boolean (value, self->zero_copy);
+      break;
+    case PROP_SHM:
+      g_value_set_boolean (value, self->shm);
+      break;
+    case PROP_QUEUE_DEPTH:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint (value, self->queue_depth);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_LEAKY:
+      g_mutex_lock (&self->lock);
+      g_value_set_enum (value, self->leaky);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MAX_AGE:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint (value, self->filter.max_age);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_FRAME_ID:
+      g_value_set_string (value, self->frame_id);
+      break;
+    case PROP_MIN_INTERVAL:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint (value, self->filter.min_interval);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_NORMALIZE_LAYOUT:
+      g_value_set_boolean (value, self->normalize_layout);
+      break;
+    case PROP_TIMESTAMP_MODE:
+      g_value_set_enum (value, self->timestamp_mode);
+      break;
+    case PROP_TF_TOPIC:
+      g_value_set_string (value, self->tf_topic);
+      break;
+    case PROP_TARGET_FRAME:
+      g_value_set_string (value, self->target_frame);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, get_stats (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
-/* ── Zenoh session helpers ─────────────────────────────────────────── */
+/* ── Allocation ────────────────────────────────────────────────────── */
 
 static gboolean
-open_zenoh_session (EdgefirstZenohSub *self)
+edgefirst_zenoh_sub_decide_allocation (GstBaseSrc *src, GstQuery *query)
 {
-  z_owned_config_t config;
-
-  if (self->session_config && g_file_test (self->session_config, G_FILE_TEST_EXISTS)) {
-    if (zc_config_from_file (&config, self->session_config) != Z_OK) {
-      GST_ERROR_OBJECT (self, "Failed to load Zenoh config from: %s",
-          self->session_config);
-      return FALSE;
-    }
-  } else if (self->session_config) {
-    z_config_default (&config);
-    zc_config_insert_json5 (z_loan_mut (config), "connect/endpoints",
-        self->session_config);
-  } else {
-    z_config_default (&config);
-  }
-
-  if (z_open (&self->session, z_move (config), NULL) != Z_OK) {
-    GST_ERROR_OBJECT (self, "Failed to open Zenoh session");
-    return FALSE;
-  }
+  EdgefirstZenohSub *self = EDGEFIRST_ZENOH_SUB (src);
 
-  self->session_valid = TRUE;
+  edgefirst_zenoh_decoder_decide_allocation (&self->decoder, query);
   return TRUE;
 }
 
-/* ── CDR parsing helper ─────────────────────────────────────────────── */
+/* ── Zenoh callbacks ───────────────────────────────────────────────── */
 
-/* Extract translation and rotation from a TransformStamped CDR buffer.
- * Walks past the Header strings and child_frame_id to reach the doubles.
- * Assumes little-endian CDR (standard on aarch64/x86_64). */
-static gboolean
-parse_transform_cdr (const uint8_t *data, size_t len,
-                     double *tx, double *ty, double *tz,
-                     double *rx, double *ry, double *rz, double *rw)
+static void
+zenoh_sub_data_handler (z_loaned_sample_t *sample, void *context)
 {
-  size_t off;
-  uint32_t str_len;
+  EdgefirstZenohSub *self = (EdgefirstZenohSub *) context;
 
-  if (!data || len < 4)
-    return FALSE;
+  /* message_type is read without a lock; it must be set before READY state */
+  if (self->message_type == EDGEFIRST_ZENOH_MSG_TRANSFORM)
+    return;
 
-  off = 4;   /* skip CDR encapsulation header */
-
-  /* stamp.sec (int32) + stamp.nanosec (uint32) */
-  if (off + 8 > len) return FALSE;
-  off += 8;
-
-  /* frame_id string: uint32 length + chars */
-  if (off + 4 > len) return FALSE;
-  memcpy (&str_len, data + off, 4);
-  off += 4 + str_len;
-  if (off > len) return FALSE;
-
-  /* pad to 4-byte boundary */
-  off = (off + 3) & ~(size_t) 3;
-
-  /* child_frame_id string: uint32 length + chars */
-  if (off + 4 > len) return FALSE;
-  memcpy (&str_len, data + off, 4);
-  off += 4 + str_len;
-  if (off > len) return FALSE;
-
-  /* pad to 8-byte boundary for doubles */
-  off = (off + 7) & ~(size_t) 7;
-
-  /* 7 doubles: tx, ty, tz, rx, ry, rz, rw */
-  if (off + 56 > len) return FALSE;
-  memcpy (tx, data + off,      8);
-  memcpy (ty, data + off + 8,  8);
-  memcpy (tz, data + off + 16, 8);
-  memcpy (rx, data + off + 24, 8);
-  memcpy (ry, data + off + 32, 8);
-  memcpy (rz, data + off + 40, 8);
-  memcpy (rw, data + off + 48, 8);
-  return TRUE;
+  push_to_queue (self, sample);
 }
 
-/* ── Data deserialization handlers ─────────────────────────────────── */
-
-static GstBuffer *
-handle_pointcloud2 (EdgefirstZenohSub *self, const uint8_t *data, size_t len,
-    GstCaps **out_caps)
-{
-  ros_point_cloud2_t *pcd;
-  GstBuffer *buffer;
-  const uint8_t *cloud_data;
-  size_t cloud_data_len;
-  EdgefirstPointCloud2Meta *meta;
-  GstCaps *caps;
-
-  pcd = ros_point_cloud2_from_cdr (data, len);
-  if (!pcd) {
-    GST_WARNING_OBJECT (self, "Failed to deserialize PointCloud2");
-    return NULL;
-  }
-
-  cloud_data = ros_point_cloud2_get_data (pcd, &cloud_data_len);
-  if (!cloud_data || cloud_data_len == 0) {
-    ros_point_cloud2_free (pcd);
-    return NULL;
-  }
-
-  buffer = gst_buffer_new_allocate (NULL, cloud_data_len, NULL);
-  gst_buffer_fill (buffer, 0, cloud_data, cloud_data_len);
-
-  /* Attach metadata */
-  meta = edgefirst_buffer_add_pointcloud2_meta (buffer);
-  if (meta) {
-    meta->point_count = ros_point_cloud2_get_width (pcd)
-        * ros_point_cloud2_get_height (pcd);
-
-    const char *frame_id = ros_point_cloud2_get_frame_id (pcd);
-    if (frame_id)
-      g_strlcpy (meta->frame_id, frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
+/* ── Timestamps and latency ────────────────────────────────────────── */
 
-    meta->ros_timestamp_ns =
-        (guint64) ros_point_cloud2_get_stamp_sec (pcd) * G_GUINT64_CONSTANT (1000000000)
-        + ros_point_cloud2_get_stamp_nanosec (pcd);
-
-    /* Lookup transform from cache */
-    if (meta->frame_id[0] != '\0') {
-      meta->has_transform = edgefirst_transform_cache_lookup (
-          self->transform_cache, meta->frame_id, NULL, &meta->transform);
-    }
-  }
-
-  /* fields_len is available but get_field_at() is not in 2.2.0; omit fields from caps */
-  caps = gst_caps_new_simple ("application/x-pointcloud2",
-      "width", G_TYPE_INT, (gint) ros_point_cloud2_get_width (pcd),
-      "height", G_TYPE_INT, (gint) ros_point_cloud2_get_height (pcd),
-      "point-step", G_TYPE_INT, (gint) ros_point_cloud2_get_point_step (pcd),
-      "is-bigendian", G_TYPE_BOOLEAN, (gboolean) ros_point_cloud2_get_is_bigendian (pcd),
-      "is-dense", G_TYPE_BOOLEAN, (gboolean) ros_point_cloud2_get_is_dense (pcd),
-      NULL);
-
-  *out_caps = caps;
-
-  ros_point_cloud2_free (pcd);
-  return buffer;
-}
-
-static GstBuffer *
-handle_radarcube (EdgefirstZenohSub *self, const uint8_t *data, size_t len,
-    GstCaps **out_caps)
+/* Set the PTS of @buffer to running time: the arrival of the sample, or in
+ * sensor mode its header @stamp mapped onto the pipeline clock. */
+static void
+timestamp_buffer (EdgefirstZenohSub *self, GstBuffer *buffer,
+    GstClockTime received, guint64 stamp)
 {
-  ros_radar_cube_t *cube;
-  GstBuffer *buffer;
-  const uint8_t *cube_raw;
-  size_t cube_raw_len;
-  EdgefirstRadarCubeMeta *meta;
-  const uint8_t *layout;
-  size_t layout_len;
-
-  cube = ros_radar_cube_from_cdr (data, len);
-  if (!cube) {
-    GST_WARNING_OBJECT (self, "Failed to deserialize RadarCube");
-    return NULL;
-  }
-
-  /* cube_raw_len is in bytes; cube_len is number of int16 elements */
-  cube_raw = ros_radar_cube_get_cube_raw (cube, &cube_raw_len);
-  if (!cube_raw || cube_raw_len == 0) {
-    ros_radar_cube_free (cube);
-    return NULL;
+  GstClock *clock;
+  GstClockTime base_time, now, waited, arrival, pts, latency = 0;
+  gboolean post = FALSE;
+
+  GST_OBJECT_LOCK (self);
+  clock = GST_ELEMENT_CLOCK (self);
+  if (clock)
+    gst_object_ref (clock);
+  base_time = GST_ELEMENT_CAST (self)->base_time;
+  GST_OBJECT_UNLOCK (self);
+
+  if (!clock) {
+    buffer->pts = GST_CLOCK_TIME_NONE;
+    return;
   }
 
-  buffer = gst_buffer_new_allocate (NULL, cube_raw_len, NULL);
-  gst_buffer_fill (buffer, 0, cube_raw, cube_raw_len);
-
-  /* Attach metadata */
-  meta = edgefirst_buffer_add_radar_cube_meta (buffer);
-  if (meta) {
-    layout = ros_radar_cube_get_layout (cube, &layout_len);
-
-    meta->num_dims = (guint8) MIN (layout_len, EDGEFIRST_RADAR_MAX_DIMS);
-    if (layout) {
-      for (guint8 i = 0; i < meta->num_dims; i++)
-        meta->layout[i] = (EdgefirstRadarDimension) layout[i];
+  /* Arrival is recorded on the monotonic system time, which need not be
+   * the pipeline clock; carry over the time spent queued instead */
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+  waited = gst_util_get_timestamp () - received;
+  arrival = now > waited ? now - waited : 0;
+
+  pts = arrival;
+  if (self->timestamp_mode == EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR &&
+      stamp != 0) {
+    pts = edgefirst_zenoh_clock_sync_update (&self->clock_sync, stamp,
+        arrival);
+    latency = edgefirst_zenoh_clock_sync_get_latency (&self->clock_sync);
+
+    g_mutex_lock (&self->lock);
+    self->latency = latency;
+    if (!self->latency_posted &&
+        latency > self->reported_latency + LATENCY_REPORT_THRESHOLD) {
+      self->latency_posted = TRUE;
+      post = TRUE;
     }
-
-    /* scales are not available in 2.2.0 API */
-    memset (meta->scales, 0, sizeof (meta->scales));
-
-    meta->is_complex = ros_radar_cube_get_is_complex (cube);
-    meta->radar_timestamp = ros_radar_cube_get_timestamp (cube);
-
-    const char *frame_id = ros_radar_cube_get_frame_id (cube);
-    if (frame_id)
-      g_strlcpy (meta->frame_id, frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
-
-    /* shape info not available in 2.2.0; emit caps without dimensions */
-    *out_caps = gst_caps_new_simple ("other/tensors",
-        "num-tensors", G_TYPE_INT, 1,
-        "types", G_TYPE_STRING, "int16",
-        "format", G_TYPE_STRING, "static",
-        NULL);
-  }
-
-  ros_radar_cube_free (cube);
-  return buffer;
-}
-
-static GstVideoFormat
-ros_encoding_to_gst_format (const char *encoding)
-{
-  if (!encoding)
-    return GST_VIDEO_FORMAT_UNKNOWN;
-
-  if (g_strcmp0 (encoding, "rgb8") == 0)
-    return GST_VIDEO_FORMAT_RGB;
-  if (g_strcmp0 (encoding, "bgr8") == 0)
-    return GST_VIDEO_FORMAT_BGR;
-  if (g_strcmp0 (encoding, "rgba8") == 0)
-    return GST_VIDEO_FORMAT_RGBA;
-  if (g_strcmp0 (encoding, "bgra8") == 0)
-    return GST_VIDEO_FORMAT_BGRA;
-  if (g_strcmp0 (encoding, "mono8") == 0)
-    return GST_VIDEO_FORMAT_GRAY8;
-  if (g_strcmp0 (encoding, "mono16") == 0)
-    return GST_VIDEO_FORMAT_GRAY16_LE;
-  if (g_strcmp0 (encoding, "yuv422") == 0)
-    return GST_VIDEO_FORMAT_UYVY;
-
-  return GST_VIDEO_FORMAT_UNKNOWN;
-}
-
-static GstBuffer *
-handle_image (EdgefirstZenohSub *self, const uint8_t *data, size_t len,
-    GstCaps **out_caps)
-{
-  ros_image_t *img;
-  GstBuffer *buffer;
-  const uint8_t *img_data;
-  size_t img_data_len;
-  const char *encoding;   /* borrowed — do NOT free */
-  GstVideoFormat format;
-  GstVideoInfo info;
-
-  img = ros_image_from_cdr (data, len);
-  if (!img) {
-    GST_WARNING_OBJECT (self, "Failed to deserialize Image");
-    return NULL;
-  }
-
-  img_data = ros_image_get_data (img, &img_data_len);
-  if (!img_data || img_data_len == 0) {
-    ros_image_free (img);
-    return NULL;
+    g_mutex_unlock (&self->lock);
   }
 
-  encoding = ros_image_get_encoding (img);
-  format = ros_encoding_to_gst_format (encoding);
+  buffer->pts = pts > base_time ? pts - base_time : 0;
 
-  if (format == GST_VIDEO_FORMAT_UNKNOWN) {
-    GST_WARNING_OBJECT (self, "Unsupported image encoding");
-    ros_image_free (img);
-    return NULL;
+  if (post) {
+    GST_DEBUG_OBJECT (self, "Latency rose to %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (latency));
+    gst_element_post_message (GST_ELEMENT (self),
+        gst_message_new_latency (GST_OBJECT (self)));
   }
-
-  gst_video_info_set_format (&info, format,
-      ros_image_get_width (img), ros_image_get_height (img));
-
-  buffer = gst_buffer_new_allocate (NULL, img_data_len, NULL);
-  gst_buffer_fill (buffer, 0, img_data, img_data_len);
-
-  *out_caps = gst_video_info_to_caps (&info);
-
-  ros_image_free (img);
-  return buffer;
 }
 
-static GstBuffer *
-handle_camera_info (EdgefirstZenohSub *self, const uint8_t *data, size_t len)
+static gboolean
+edgefirst_zenoh_sub_query (GstBaseSrc *src, GstQuery *query)
 {
-  ros_camera_info_t *ci;
-  GstBuffer *buffer;
-  EdgefirstCameraInfoMeta *meta;
-
-  ci = ros_camera_info_from_cdr (data, len);
-  if (!ci) {
-    GST_WARNING_OBJECT (self, "Failed to deserialize CameraInfo");
-    return NULL;
-  }
+  EdgefirstZenohSub *self = EDGEFIRST_ZENOH_SUB (src);
+  GstClockTime latency;
 
-  /* CameraInfo doesn't carry pixel data, create a minimal buffer */
-  buffer = gst_buffer_new ();
-  meta = edgefirst_buffer_add_camera_info_meta (buffer);
-  if (meta) {
-    meta->width  = ros_camera_info_get_width (ci);
-    meta->height = ros_camera_info_get_height (ci);
-
-    /* K/D/R/P matrix getters removed in 2.2.0; matrices stay zeroed */
-
-    const char *model = ros_camera_info_get_distortion_model (ci);  /* borrowed */
-    if (model) {
-      if (g_strcmp0 (model, "plumb_bob") == 0)
-        meta->distortion_model = EDGEFIRST_DISTORTION_PLUMB_BOB;
-      else if (g_strcmp0 (model, "equidistant") == 0)
-        meta->distortion_model = EDGEFIRST_DISTORTION_EQUIDISTANT;
-      else if (g_strcmp0 (model, "rational_polynomial") == 0)
-        meta->distortion_model = EDGEFIRST_DISTORTION_RATIONAL;
-    }
+  if (GST_QUERY_TYPE (query) != GST_QUERY_LATENCY ||
+      self->timestamp_mode != EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR)
+    return GST_BASE_SRC_CLASS (parent_class)->query (src, query);
 
-    const char *frame_id = ros_camera_info_get_frame_id (ci);  /* borrowed */
-    if (frame_id)
-      g_strlcpy (meta->frame_id, frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
-  }
+  /* Sensor-stamped buffers arrive up to the measured transport delay
+   * after their PTS */
+  g_mutex_lock (&self->lock);
+  latency = self->latency;
+  self->reported_latency = latency;
+  self->latency_posted = FALSE;
+  g_mutex_unlock (&self->lock);
 
-  ros_camera_info_free (ci);
-  return buffer;
+  GST_DEBUG_OBJECT (self, "Reporting latency %" GST_TIME_FORMAT,
+      GST_TIME_ARGS (latency));
+  gst_query_set_latency (query, TRUE, latency, GST_CLOCK_TIME_NONE);
+  return TRUE;
 }
 
-/* ── Zenoh callbacks ───────────────────────────────────────────────── */
+/* ── Start / Stop / Create ─────────────────────────────────────────── */
 
-static void
-zenoh_sub_data_handler (z_loaned_sample_t *sample, void *context)
+static GstStateChangeReturn
+edgefirst_zenoh_sub_change_state (GstElement *element,
+    GstStateChange transition)
 {
-  EdgefirstZenohSub *self = (EdgefirstZenohSub *) context;
-  const z_loaned_bytes_t *payload;
-  z_bytes_slice_iterator_t iter;
-  z_view_slice_t slice;
-  GstBuffer *buffer = NULL;
-  GstCaps *caps = NULL;
-
-  payload = z_sample_payload (sample);
-
-  /* Get raw bytes from payload */
-  iter = z_bytes_get_slice_iterator (payload);
-  if (!z_bytes_slice_iterator_next (&iter, &slice))
-    return;
-
-  const uint8_t *data = z_slice_data (z_view_slice_loan (&slice));
-  size_t len = z_slice_len (z_view_slice_loan (&slice));
-
-  if (!data || len == 0)
-    return;
-
-  /* message_type is read without a lock; it must be set before READY state */
-  switch (self->message_type) {
-    case EDGEFIRST_ZENOH_MSG_POINTCLOUD2:
-      buffer = handle_pointcloud2 (self, data, len, &caps);
-      break;
-    case EDGEFIRST_ZENOH_MSG_RADARCUBE:
-      buffer = handle_radarcube (self, data, len, &caps);
+  EdgefirstZenohSub *self = EDGEFIRST_ZENOH_SUB (element);
+
+  /* leaky=none may only block the Zenoh callback while create() runs, as
+   * in PAUSED nothing would ever wake it, and only on a private session,
+   * whose RX thread serves no other element */
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
+      g_mutex_lock (&self->lock);
+      edgefirst_zenoh_queue_set_blocking (&self->queue,
+          self->private_session);
+      g_mutex_unlock (&self->lock);
       break;
-    case EDGEFIRST_ZENOH_MSG_IMAGE:
-      buffer = handle_image (self, data, len, &caps);
+    case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+      g_mutex_lock (&self->lock);
+      edgefirst_zenoh_queue_set_blocking (&self->queue, FALSE);
+      g_mutex_unlock (&self->lock);
       break;
-    case EDGEFIRST_ZENOH_MSG_CAMERA_INFO:
-      buffer = handle_camera_info (self, data, len);
-      break;
-    case EDGEFIRST_ZENOH_MSG_TRANSFORM:
-      /* Transform messages handled via TF subscriber */
+    default:
       break;
   }
 
-  if (buffer) {
-    buffer->pts = gst_util_get_timestamp ();
-    push_to_queue (self, buffer, caps);
-    caps = NULL;   /* ownership transferred */
-  }
-  gst_clear_caps (&caps);
+  return GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
 }
 
-static void
-zenoh_sub_tf_handler (z_loaned_sample_t *sample, void *context)
-{
-  EdgefirstZenohSub *self = (EdgefirstZenohSub *) context;
-  const z_loaned_bytes_t *payload;
-  z_bytes_slice_iterator_t iter;
-  z_view_slice_t slice;
-
-  payload = z_sample_payload (sample);
-
-  iter = z_bytes_get_slice_iterator (payload);
-  if (!z_bytes_slice_iterator_next (&iter, &slice))
-    return;
-
-  const uint8_t *data = z_slice_data (z_view_slice_loan (&slice));
-  size_t len = z_slice_len (z_view_slice_loan (&slice));
-
-  if (!data || len == 0)
-    return;
-
-  ros_transform_stamped_t *tf = ros_transform_stamped_from_cdr (data, len);
-  if (!tf)
-    return;
-
-  EdgefirstTransformData td;
-  edgefirst_transform_data_set_identity (&td);
-
-  /* Extract translation and rotation from the raw CDR bytes (no per-field
-   * getters for transform components in 2.2.0 — parse CDR manually) */
-  {
-    size_t cdr_len;
-    const uint8_t *cdr = ros_transform_stamped_as_cdr (tf, &cdr_len);
-    double tx, ty, tz, rx, ry, rz, rw;
-    if (cdr && parse_transform_cdr (cdr, cdr_len, &tx, &ty, &tz, &rx, &ry, &rz, &rw)) {
-      td.translation[0] = tx;
-      td.translation[1] = ty;
-      td.translation[2] = tz;
-      td.rotation[0] = rx;
-      td.rotation[1] = ry;
-      td.rotation[2] = rz;
-      td.rotation[3] = rw;
-    }
-  }
-
-  /* Extract frame IDs (borrowed — do NOT free) */
-  const char *child_frame_id = ros_transform_stamped_get_child_frame_id (tf);
-  if (child_frame_id)
-    g_strlcpy (td.child_frame_id, child_frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
-
-  const char *frame_id = ros_transform_stamped_get_frame_id (tf);
-  if (frame_id)
-    g_strlcpy (td.parent_frame_id, frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
-
-  td.timestamp_ns =
-      (guint64) ros_transform_stamped_get_stamp_sec (tf) * G_GUINT64_CONSTANT (1000000000)
-      + ros_transform_stamped_get_stamp_nanosec (tf);
-
-  edgefirst_transform_cache_insert (self->transform_cache, &td);
-
-  GST_DEBUG_OBJECT (self, "Cached transform: %s -> %s",
-      td.child_frame_id, td.parent_frame_id);
-
-  ros_transform_stamped_free (tf);
-}
-
-/* ── Start / Stop / Create ─────────────────────────────────────────── */
-
 static gboolean
 edgefirst_zenoh_sub_start (GstBaseSrc *src)
 {
   EdgefirstZenohSub *self = EDGEFIRST_ZENOH_SUB (src);
   z_owned_closure_sample_t callback;
   z_view_keyexpr_t ke;
+  gboolean private_session;
 
   if (!self->topic) {
     GST_ERROR_OBJECT (self, "No topic specified");
@@ -709,37 +752,63 @@ edgefirst_zenoh_sub_start (GstBaseSrc *src)
 
   GST_INFO_OBJECT (self, "Starting Zenoh subscriber on topic: %s", self->topic);
 
-  if (!open_zenoh_session (self))
+  g_mutex_lock (&self->lock);
+  self->stat_received = 0;
+  self->stat_decoded = 0;
+  self->queue.dropped = 0;
+  self->stat_decode_failures = 0;
+  self->stat_filtered = 0;
+  self->queue.high_water = 0;
+  self->latency = 0;
+  self->reported_latency = 0;
+  self->latency_posted = FALSE;
+  edgefirst_zenoh_header_filter_reset (&self->filter);
+  private_session = self->leaky == EDGEFIRST_ZENOH_SUB_LEAKY_NONE;
+  self->private_session = private_session;
+  g_mutex_unlock (&self->lock);
+  edgefirst_zenoh_clock_sync_reset (&self->clock_sync);
+
+  /* leaky=none blocks the receive thread of its session, which must then
+   * not be shared */
+  if (private_session)
+    self->session = edgefirst_zenoh_session_open_private (
+        self->session_config, self->shm);
+  else
+    self->session = edgefirst_zenoh_session_obtain (GST_ELEMENT (self),
+        self->session_config, self->shm);
+  if (!self->session) {
+    GST_ERROR_OBJECT (self, "Failed to open Zenoh session");
     return FALSE;
+  }
+
+  self->decoder.message_type = self->message_type;
+  /* Copying SHM payloads would throw away the point of the transport */
+  self->decoder.wrap_payload = self->zero_copy ||
+      edgefirst_zenoh_session_has_shm (self->session);
 
   /* Subscribe to main topic */
   z_closure_sample (&callback, zenoh_sub_data_handler, NULL, self);
   z_view_keyexpr_from_str (&ke, self->topic);
 
-  if (z_declare_subscriber (z_loan (self->session), &self->subscriber,
-          z_loan (ke), z_move (callback), NULL) != Z_OK) {
+  if (z_declare_subscriber (edgefirst_zenoh_session_loan (self->session),
+          &self->subscriber, z_loan (ke), z_move (callback), NULL) != Z_OK) {
     GST_ERROR_OBJECT (self, "Failed to create subscriber for: %s", self->topic);
-    z_drop (z_move (self->session));
-    self->session_valid = FALSE;
+    g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
     return FALSE;
   }
 
-  /* Subscribe to rt/tf_static for transforms */
-  {
-    z_owned_closure_sample_t tf_callback;
-    z_view_keyexpr_t tf_ke;
-
-    z_closure_sample (&tf_callback, zenoh_sub_tf_handler, NULL, self);
-    z_view_keyexpr_from_str (&tf_ke, "rt/tf_static");
-
-    if (z_declare_subscriber (z_loan (self->session), &self->tf_subscriber,
-            z_loan (tf_ke), z_move (tf_callback), NULL) != Z_OK) {
-      GST_WARNING_OBJECT (self, "Failed to subscribe to rt/tf_static");
-      /* Non-fatal: transforms are optional */
-    }
-  }
+  /* Transforms come from subscribers shared by the session */
+  g_free (self->tf_topic_active);
+  self->tf_topic_active = g_strdup (self->tf_topic);
+  self->transform_cache = edgefirst_zenoh_session_acquire_transforms (
+      self->session, self->tf_topic_active);
+  self->decoder.normalize_layout = self->normalize_layout;
+  edgefirst_zenoh_decoder_start (&self->decoder, self->transform_cache,
+      self->target_frame);
 
+  g_mutex_lock (&self->lock);
   self->started = TRUE;
+  g_mutex_unlock (&self->lock);
   return TRUE;
 }
 
@@ -753,25 +822,29 @@ edgefirst_zenoh_sub_stop (GstBaseSrc *src)
   g_mutex_lock (&self->lock);
   self->started = FALSE;
   g_cond_signal (&self->cond);
+  edgefirst_zenoh_queue_set_blocking (&self->queue, FALSE);
   g_mutex_unlock (&self->lock);
 
-  z_drop (z_move (self->tf_subscriber));
   z_drop (z_move (self->subscriber));
 
-  if (self->session_valid) {
-    z_drop (z_move (self->session));
-    self->session_valid = FALSE;
+  if (self->session) {
+    edgefirst_zenoh_session_release_transforms (self->session,
+        self->tf_topic_active);
+    self->transform_cache = NULL;
+    g_clear_pointer (&self->tf_topic_active, g_free);
   }
+  g_clear_pointer (&self->session, edgefirst_zenoh_session_unref);
 
   /* Drain the queue */
   g_mutex_lock (&self->lock);
-  while (!g_queue_is_empty (self->buffer_queue)) {
-    EdgefirstQueueItem *item = g_queue_pop_head (self->buffer_queue);
-    queue_item_free (item);
-  }
+  edgefirst_zenoh_queue_flush (&self->queue);
   g_mutex_unlock (&self->lock);
 
-  gst_clear_caps (&self->last_caps);
+  edgefirst_zenoh_decoder_stop (&self->decoder);
+
+  g_mutex_lock (&self->import_lock);
+  edgefirst_zenoh_fd_importer_clear (&self->fd_importer);
+  g_mutex_unlock (&self->import_lock);
 
   return TRUE;
 }
@@ -780,36 +853,46 @@ static GstFlowReturn
 edgefirst_zenoh_sub_create (GstPushSrc *src, GstBuffer **buf)
 {
   EdgefirstZenohSub *self = EDGEFIRST_ZENOH_SUB (src);
-  EdgefirstQueueItem *item = NULL;
+  EdgefirstQueueItem item;
+  GstBuffer *buffer = NULL;
+  GstCaps *caps = NULL;
+  guint64 stamp;
 
-  g_mutex_lock (&self->lock);
+  /* Decode only the sample that is about to be pushed; samples that fail to
+   * decode are skipped and the next one is taken. */
+  while (!buffer) {
+    g_mutex_lock (&self->lock);
 
-  while (self->started && g_queue_is_empty (self->buffer_queue)) {
-    g_cond_wait (&self->cond, &self->lock);
-  }
+    while (self->started && !edgefirst_zenoh_queue_pop (&self->queue, &item))
+      g_cond_wait (&self->cond, &self->lock);
 
-  if (!self->started) {
+    if (!self->started) {
+      g_mutex_unlock (&self->lock);
+      return GST_FLOW_FLUSHING;
+    }
     g_mutex_unlock (&self->lock);
-    return GST_FLOW_FLUSHING;
-  }
-
-  item = g_queue_pop_head (self->buffer_queue);
-  g_mutex_unlock (&self->lock);
 
-  if (!item) {
-    return GST_FLOW_ERROR;
+    buffer = edgefirst_zenoh_decoder_decode (&self->decoder,
+        z_loan (item.sample), &item.fd, &caps, &stamp);
+    if (buffer)
+      timestamp_buffer (self, buffer, item.received, stamp);
+    queue_item_clear (&item);
+
+    g_mutex_lock (&self->lock);
+    if (buffer)
+      self->stat_decoded++;
+    else
+      self->stat_decode_failures++;
+    g_mutex_unlock (&self->lock);
   }
 
-  /* Set caps on the streaming thread only when they change */
-  if (item->caps) {
-    if (!self->last_caps || !gst_caps_is_equal (self->last_caps, item->caps)) {
-      gst_base_src_set_caps (GST_BASE_SRC (self), item->caps);
-      gst_caps_replace (&self->last_caps, item->caps);
-    }
-    gst_caps_unref (item->caps);
+  /* Handlers only return caps when the stream signature changed */
+  if (caps) {
+    GST_DEBUG_OBJECT (self, "Stream changed, caps %" GST_PTR_FORMAT, caps);
+    gst_base_src_set_caps (GST_BASE_SRC (self), caps);
+    gst_caps_unref (caps);
   }
 
-  *buf = item->buf;
-  g_free (item);
+  *buf = buffer;
   return GST_FLOW_OK;
 }
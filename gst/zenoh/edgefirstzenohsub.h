@@ -19,6 +19,10 @@ G_DECLARE_FINAL_TYPE (EdgefirstZenohSub, edgefirst_zenoh_sub, EDGEFIRST, ZENOH_S
  * EdgefirstZenohSubMessageType:
  * @EDGEFIRST_ZENOH_MSG_POINTCLOUD2: PointCloud2 message
  * @EDGEFIRST_ZENOH_MSG_RADARCUBE: RadarCube message
+ * @EDGEFIRST_ZENOH_MSG_IMAGE: sensor_msgs/Image message
+ * @EDGEFIRST_ZENOH_MSG_CAMERA_INFO: sensor_msgs/CameraInfo message
+ * @EDGEFIRST_ZENOH_MSG_TRANSFORM: tf2_msgs/TFMessage (cached only)
+ * @EDGEFIRST_ZENOH_MSG_DMABUFFER: edgefirst_msgs/DmaBuffer from a same-host publisher
  *
  * Message types supported by the Zenoh subscriber.
  */
@@ -28,8 +32,39 @@ typedef enum {
   EDGEFIRST_ZENOH_MSG_IMAGE = 2,
   EDGEFIRST_ZENOH_MSG_CAMERA_INFO = 3,
   EDGEFIRST_ZENOH_MSG_TRANSFORM = 4,
+  EDGEFIRST_ZENOH_MSG_DMABUFFER = 5,
 } EdgefirstZenohSubMessageType;
 
+/**
+ * EdgefirstZenohSubLeaky:
+ * @EDGEFIRST_ZENOH_SUB_LEAKY_NONE: Block the Zenoh callback until there is room
+ * @EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM: Drop the newly received sample
+ * @EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM: Drop the oldest pending sample
+ * @EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY: Keep only the newest sample
+ *
+ * What the subscriber does when its pending sample queue is full.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_SUB_LEAKY_NONE = 0,
+  EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM = 1,
+  EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM = 2,
+  EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY = 3,
+} EdgefirstZenohSubLeaky;
+
+/**
+ * EdgefirstZenohSubTimestampMode:
+ * @EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL: Running time at which the sample
+ *   was received
+ * @EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR: Header stamp mapped onto the
+ *   pipeline clock
+ *
+ * How the subscriber timestamps its output buffers.
+ */
+typedef enum {
+  EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL = 0,
+  EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR = 1,
+} EdgefirstZenohSubTimestampMode;
+
 G_END_DECLS
 
 #endif /* __EDGEFIRST_ZENOH_SUB_H__ */
@@ -11,6 +11,7 @@
 #include <gst/gst.h>
 #include <gst/edgefirst/edgefirst.h>
 #include "edgefirstzenohsub.h"
+#include "edgefirstzenohdemux.h"
 #include "edgefirstzenohpub.h"
 
 static gboolean
@@ -24,6 +25,9 @@ plugin_init (GstPlugin *plugin)
   ret &= gst_element_register (plugin, "edgefirstzenohsub",
       GST_RANK_NONE, EDGEFIRST_TYPE_ZENOH_SUB);
 
+  ret &= gst_element_register (plugin, "edgefirstzenohdemux",
+      GST_RANK_NONE, EDGEFIRST_TYPE_ZENOH_DEMUX);
+
   ret &= gst_element_register (plugin, "edgefirstzenohpub",
       GST_RANK_NONE, EDGEFIRST_TYPE_ZENOH_PUB);
 
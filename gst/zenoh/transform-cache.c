@@ -9,21 +9,529 @@
 #endif
 
 #include "transform-cache.h"
+#include <math.h>
+#include <stdatomic.h>
 #include <string.h>
 
+/* Quaternions closer than this are interpolated linearly, where SLERP
+ * would divide by a vanishing sine */
+#define SLERP_DOT_THRESHOLD 0.9995
+
+/* Slots of the direct-mapped memo of resolved frame pairs */
+#define MEMO_SLOTS 256
+
+/* One stamped transform of a frame's history */
+typedef struct {
+  guint64 stamp;
+  gdouble translation[3];
+  gdouble rotation[4];
+} TransformSample;
+
+/* Transforms of one child frame.  Samples form a ring ordered by stamp,
+ * starting at head; a static frame keeps a single sample.
+ *
+ * Written under the cache mutex between two increments of seq, so seq is
+ * odd during a write.  Readers copy what they need and retry if seq moved.
+ * The slot itself is never freed or moved while the cache lives. */
+typedef struct {
+  gint seq;
+  gchar frame_id[EDGEFIRST_FRAME_ID_MAX_LEN];  /* set once when interned */
+  guint parent;                                /* handle, 0 = none */
+  gboolean is_static;
+  guint head;
+  guint len;
+  TransformSample samples[EDGEFIRST_TRANSFORM_CACHE_DEPTH];
+} FrameSlot;
+
+/* A resolved frame pair, guarded by seq like a frame, and valid while
+ * generation matches the cache.  A path that crosses only static frames
+ * holds at every stamp, so time_ns is part of the key only for dynamic
+ * paths. */
+typedef struct {
+  gint seq;
+  guint source;
+  guint target;
+  gint generation;
+  guint64 time_ns;
+  gboolean is_static;
+  gboolean found;
+  gdouble matrix[12];
+  gdouble rotation[4];
+} MemoSlot;
+
 struct _EdgefirstTransformCache {
-  GHashTable *transforms;  /* child_frame_id → EdgefirstTransformData */
-  GMutex lock;
+  GMutex lock;          /* serializes writers and interning */
+  GHashTable *handles;  /* frame_id → handle, protected by lock */
+  gint n_frames;        /* published with an atomic store */
+  FrameSlot *frames[EDGEFIRST_TRANSFORM_CACHE_MAX_FRAMES + 1];
+  gint generation;      /* bumped after every change to a frame */
+  MemoSlot memo[MEMO_SLOTS];
 };
 
+/* ── Frames ────────────────────────────────────────────────────────── */
+
+static inline FrameSlot *
+frame_get (EdgefirstTransformCache *cache, guint handle)
+{
+  if (handle == 0 || handle > (guint) g_atomic_int_get (&cache->n_frames))
+    return NULL;
+  return cache->frames[handle];
+}
+
+static inline TransformSample *
+frame_at (FrameSlot *frame, guint i)
+{
+  return &frame->samples[(frame->head + i) % EDGEFIRST_TRANSFORM_CACHE_DEPTH];
+}
+
+/* Index of the first of @len samples stamped after @stamp, by binary
+ * search */
+static guint
+frame_upper_bound (FrameSlot *frame, guint len, guint64 stamp)
+{
+  guint lo = 0, hi = len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (frame_at (frame, mid)->stamp <= stamp)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static guint
+find_locked (EdgefirstTransformCache *cache, const gchar *frame_id)
+{
+  return GPOINTER_TO_UINT (g_hash_table_lookup (cache->handles, frame_id));
+}
+
+static guint
+intern_locked (EdgefirstTransformCache *cache, const gchar *frame_id)
+{
+  FrameSlot *frame;
+  guint handle;
+
+  handle = find_locked (cache, frame_id);
+  if (handle != 0 || cache->n_frames >= EDGEFIRST_TRANSFORM_CACHE_MAX_FRAMES)
+    return handle;
+
+  frame = g_new0 (FrameSlot, 1);
+  g_strlcpy (frame->frame_id, frame_id, EDGEFIRST_FRAME_ID_MAX_LEN);
+  handle = cache->n_frames + 1;
+  cache->frames[handle] = frame;
+  g_hash_table_insert (cache->handles, g_strdup (frame_id),
+      GUINT_TO_POINTER (handle));
+
+  /* Readers see the slot only once it is complete */
+  g_atomic_int_set (&cache->n_frames, handle);
+  return handle;
+}
+
+/* Get the frame of @transform's child for writing, and restart its
+ * history if it is of the wrong kind or has a new parent.  Returns NULL
+ * when the cache is full; otherwise end with frame_write_end(). */
+static FrameSlot *
+frame_write_begin (EdgefirstTransformCache *cache,
+    const EdgefirstTransformData *transform, gboolean is_static)
+{
+  FrameSlot *frame;
+  guint child, parent;
+
+  child = intern_locked (cache, transform->child_frame_id);
+  parent = intern_locked (cache, transform->parent_frame_id);
+  if (child == 0 || parent == 0)
+    return NULL;
+
+  frame = cache->frames[child];
+  g_atomic_int_inc (&frame->seq);
+
+  if (frame->is_static != is_static || frame->parent != parent) {
+    frame->is_static = is_static;
+    frame->parent = parent;
+    frame->len = 0;
+  }
+  if (frame->len == 0)
+    frame->head = 0;
+
+  return frame;
+}
+
+static void
+frame_write_end (EdgefirstTransformCache *cache, FrameSlot *frame)
+{
+  g_atomic_int_inc (&frame->seq);
+
+  /* After the write, so a path resolved from the old transform is never
+   * memoized under the new generation */
+  g_atomic_int_inc (&cache->generation);
+}
+
+static void
+sample_from_data (TransformSample *sample,
+    const EdgefirstTransformData *transform)
+{
+  sample->stamp = transform->timestamp_ns;
+  memcpy (sample->translation, transform->translation,
+      sizeof (sample->translation));
+  memcpy (sample->rotation, transform->rotation, sizeof (sample->rotation));
+}
+
+static void
+sample_to_data (const TransformSample *sample, const gchar *child_frame_id,
+    const gchar *parent_frame_id, EdgefirstTransformData *transform)
+{
+  memcpy (transform->translation, sample->translation,
+      sizeof (transform->translation));
+  memcpy (transform->rotation, sample->rotation, sizeof (transform->rotation));
+  g_strlcpy (transform->child_frame_id, child_frame_id,
+      EDGEFIRST_FRAME_ID_MAX_LEN);
+  g_strlcpy (transform->parent_frame_id, parent_frame_id,
+      EDGEFIRST_FRAME_ID_MAX_LEN);
+  transform->timestamp_ns = sample->stamp;
+}
+
+/* Shortest-path spherical interpolation of unit quaternions (x, y, z, w) */
+static void
+quaternion_slerp (const gdouble a[4], const gdouble b[4], gdouble t,
+    gdouble out[4])
+{
+  gdouble dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+  gdouble sign = 1.0, wa, wb, norm;
+
+  /* q and -q are the same rotation; take the nearer one */
+  if (dot < 0.0) {
+    dot = -dot;
+    sign = -1.0;
+  }
+
+  if (dot > SLERP_DOT_THRESHOLD) {
+    wa = 1.0 - t;
+    wb = t;
+  } else {
+    gdouble theta = acos (dot);
+    gdouble s = sin (theta);
+
+    wa = sin ((1.0 - t) * theta) / s;
+    wb = sin (t * theta) / s;
+  }
+
+  norm = 0.0;
+  for (guint i = 0; i < 4; i++) {
+    out[i] = wa * a[i] + sign * wb * b[i];
+    norm += out[i] * out[i];
+  }
+  norm = sqrt (norm);
+  for (guint i = 0; norm > 0.0 && i < 4; i++)
+    out[i] /= norm;
+}
+
+/* Transform of @frame at @time_ns, see
+ * edgefirst_transform_cache_lookup_at_time().  Runs concurrently with
+ * writers, so it must stay in bounds whatever it reads. */
+static gboolean
+frame_sample_at (FrameSlot *frame, guint64 time_ns, TransformSample *out)
+{
+  const TransformSample *a, *b;
+  guint len = MIN (frame->len, EDGEFIRST_TRANSFORM_CACHE_DEPTH);
+  gdouble t;
+  guint i;
+
+  if (len == 0)
+    return FALSE;
+
+  if (frame->is_static || time_ns == 0) {
+    *out = *frame_at (frame, len - 1);
+    return TRUE;
+  }
+
+  i = frame_upper_bound (frame, len, time_ns);
+  if (i == 0 || i == len) {
+    /* Outside the history: hold the nearest transform for a while */
+    a = frame_at (frame, i == 0 ? 0 : len - 1);
+    if ((a->stamp > time_ns ? a->stamp - time_ns : time_ns - a->stamp) >
+        EDGEFIRST_TRANSFORM_CACHE_MAX_EXTRAPOLATION)
+      return FALSE;
+    *out = *a;
+    return TRUE;
+  }
+
+  a = frame_at (frame, i - 1);
+  b = frame_at (frame, i);
+  t = (gdouble) (time_ns - a->stamp) / (gdouble) (b->stamp - a->stamp);
+
+  out->stamp = time_ns;
+  for (guint axis = 0; axis < 3; axis++)
+    out->translation[axis] = a->translation[axis] + t *
+        (b->translation[axis] - a->translation[axis]);
+  quaternion_slerp (a->rotation, b->rotation, t, out->rotation);
+  return TRUE;
+}
+
+/* Consistent read of one frame: its transform at @time_ns, its parent and
+ * whether it is static */
+static gboolean
+frame_read (FrameSlot *frame, guint64 time_ns, TransformSample *out,
+    guint *parent, gboolean *is_static)
+{
+  gboolean found;
+  gint seq;
+
+  for (;;) {
+    seq = g_atomic_int_get (&frame->seq);
+    if (seq & 1)
+      continue;
+
+    found = frame_sample_at (frame, time_ns, out);
+    *parent = frame->parent;
+    if (is_static)
+      *is_static = frame->is_static;
+
+    atomic_thread_fence (memory_order_acquire);
+    if (g_atomic_int_get (&frame->seq) == seq)
+      return found && *parent != 0;
+  }
+}
+
+/* ── Frame graph ───────────────────────────────────────────────────── */
+
+/* Row-major 3x4 affine matrices [R | t] */
+
+static void
+matrix_identity (gdouble m[12])
+{
+  memset (m, 0, 12 * sizeof (gdouble));
+  m[0] = m[5] = m[10] = 1.0;
+}
+
+static void
+matrix_from_sample (const TransformSample *sample, gdouble m[12])
+{
+  const gdouble x = sample->rotation[0], y = sample->rotation[1];
+  const gdouble z = sample->rotation[2], w = sample->rotation[3];
+
+  m[0] = 1.0 - 2.0 * (y * y + z * z);
+  m[1] = 2.0 * (x * y - z * w);
+  m[2] = 2.0 * (x * z + y * w);
+  m[4] = 2.0 * (x * y + z * w);
+  m[5] = 1.0 - 2.0 * (x * x + z * z);
+  m[6] = 2.0 * (y * z - x * w);
+  m[8] = 2.0 * (x * z - y * w);
+  m[9] = 2.0 * (y * z + x * w);
+  m[10] = 1.0 - 2.0 * (x * x + y * y);
+  m[3] = sample->translation[0];
+  m[7] = sample->translation[1];
+  m[11] = sample->translation[2];
+}
+
+/* out = a * b, i.e. b applied first; out may alias b */
+static void
+matrix_multiply (const gdouble a[12], const gdouble b[12], gdouble out[12])
+{
+  gdouble r[12];
+
+  for (guint row = 0; row < 3; row++) {
+    const gdouble *ar = a + row * 4;
+
+    for (guint col = 0; col < 4; col++)
+      r[row * 4 + col] = ar[0] * b[col] + ar[1] * b[4 + col] +
+          ar[2] * b[8 + col] + (col == 3 ? ar[3] : 0.0);
+  }
+  memcpy (out, r, sizeof (r));
+}
+
+/* Inverse of a rigid transform: [R^T | -R^T t] */
+static void
+matrix_invert (const gdouble m[12], gdouble out[12])
+{
+  for (guint row = 0; row < 3; row++) {
+    for (guint col = 0; col < 3; col++)
+      out[row * 4 + col] = m[col * 4 + row];
+    out[row * 4 + 3] = -(m[row] * m[3] + m[4 + row] * m[7] +
+        m[8 + row] * m[11]);
+  }
+}
+
+/* Unit quaternion (x, y, z, w) of the rotation part of @m */
+static void
+quaternion_from_matrix (const gdouble m[12], gdouble q[4])
+{
+  gdouble trace = m[0] + m[5] + m[10], s;
+
+  if (trace > 0.0) {
+    s = 2.0 * sqrt (trace + 1.0);
+    q[3] = 0.25 * s;
+    q[0] = (m[9] - m[6]) / s;
+    q[1] = (m[2] - m[8]) / s;
+    q[2] = (m[4] - m[1]) / s;
+  } else if (m[0] > m[5] && m[0] > m[10]) {
+    s = 2.0 * sqrt (1.0 + m[0] - m[5] - m[10]);
+    q[3] = (m[9] - m[6]) / s;
+    q[0] = 0.25 * s;
+    q[1] = (m[1] + m[4]) / s;
+    q[2] = (m[2] + m[8]) / s;
+  } else if (m[5] > m[10]) {
+    s = 2.0 * sqrt (1.0 + m[5] - m[0] - m[10]);
+    q[3] = (m[2] - m[8]) / s;
+    q[0] = (m[1] + m[4]) / s;
+    q[1] = 0.25 * s;
+    q[2] = (m[6] + m[9]) / s;
+  } else {
+    s = 2.0 * sqrt (1.0 + m[10] - m[0] - m[5]);
+    q[3] = (m[4] - m[1]) / s;
+    q[0] = (m[2] + m[8]) / s;
+    q[1] = (m[6] + m[9]) / s;
+    q[2] = 0.25 * s;
+  }
+}
+
+/* Ancestors of a frame at one stamp.  frames[k] is the k-th ancestor
+ * (frames[0] the frame itself) and to[k] takes points from the frame into
+ * frames[k].  The first static_len frames were read from static frames, so
+ * to[k] does not depend on the stamp for k <= static_len. */
+typedef struct {
+  guint frames[EDGEFIRST_TRANSFORM_CACHE_MAX_DEPTH + 1];
+  gdouble to[EDGEFIRST_TRANSFORM_CACHE_MAX_DEPTH + 1][12];
+  guint len;
+  guint static_len;
+} FrameChain;
+
+static void
+chain_build (EdgefirstTransformCache *cache, guint handle, guint64 time_ns,
+    FrameChain *chain)
+{
+  TransformSample sample;
+  FrameSlot *frame;
+  gdouble edge[12];
+  gboolean is_static;
+  gboolean found;
+  guint parent;
+
+  chain->frames[0] = handle;
+  matrix_identity (chain->to[0]);
+  chain->len = 1;
+  chain->static_len = 0;
+
+  while (chain->len <= EDGEFIRST_TRANSFORM_CACHE_MAX_DEPTH) {
+    frame = frame_get (cache, chain->frames[chain->len - 1]);
+    is_static = TRUE;
+    found = frame && frame_read (frame, time_ns, &sample, &parent,
+        &is_static);
+    /* Counted even if the read fails, as where the walk stops can depend
+     * on the stamp too */
+    if (is_static && chain->static_len == chain->len - 1)
+      chain->static_len = chain->len;
+    if (!found)
+      break;
+
+    matrix_from_sample (&sample, edge);
+    matrix_multiply (edge, chain->to[chain->len - 1], chain->to[chain->len]);
+    chain->frames[chain->len] = parent;
+    chain->len++;
+  }
+}
+
+static gboolean
+memo_read (MemoSlot *slot, guint source, guint target, guint64 time_ns,
+    gint generation, MemoSlot *out)
+{
+  gint seq = g_atomic_int_get (&slot->seq);
+
+  if (seq & 1)
+    return FALSE;
+
+  *out = *slot;
+  atomic_thread_fence (memory_order_acquire);
+  return g_atomic_int_get (&slot->seq) == seq && out->source == source &&
+      out->target == target &&
+      (out->is_static || out->time_ns == time_ns) &&
+      out->generation == generation;
+}
+
+/* Publish a result, unless another reader is publishing to the slot */
+static void
+memo_write (MemoSlot *slot, const MemoSlot *path)
+{
+  gint seq = g_atomic_int_get (&slot->seq);
+
+  if ((seq & 1) || !g_atomic_int_compare_and_exchange (&slot->seq, seq,
+          seq + 1))
+    return;
+
+  slot->source = path->source;
+  slot->target = path->target;
+  slot->generation = path->generation;
+  slot->time_ns = path->time_ns;
+  slot->is_static = path->is_static;
+  slot->found = path->found;
+  memcpy (slot->matrix, path->matrix, sizeof (slot->matrix));
+  memcpy (slot->rotation, path->rotation, sizeof (slot->rotation));
+
+  g_atomic_int_inc (&slot->seq);
+}
+
+/* Resolve @source to @target through their nearest common ancestor, using
+ * and filling the memo */
+static void
+resolve (EdgefirstTransformCache *cache, guint source, guint target,
+    guint64 time_ns, MemoSlot *path)
+{
+  MemoSlot *slot = &cache->memo[(source * 31 + target) % MEMO_SLOTS];
+  gint generation = g_atomic_int_get (&cache->generation);
+  FrameChain chains[2];         /* about 6 KB, cheaper than the heap */
+  FrameChain *up = &chains[0], *down = &chains[1];
+  gdouble inverse[12];
+
+  if (memo_read (slot, source, target, time_ns, generation, path))
+    return;
+
+  path->source = source;
+  path->target = target;
+  path->time_ns = time_ns;
+  path->generation = generation;
+  path->is_static = FALSE;
+  path->found = FALSE;
+
+  if (frame_get (cache, source) && frame_get (cache, target)) {
+    chain_build (cache, source, time_ns, up);
+    chain_build (cache, target, time_ns, down);
+
+    for (guint i = 0; i < up->len && !path->found; i++) {
+      for (guint j = 0; j < down->len; j++) {
+        if (up->frames[i] != down->frames[j])
+          continue;
+
+        /* source → ancestor, then ancestor → target */
+        matrix_invert (down->to[j], inverse);
+        matrix_multiply (inverse, up->to[i], path->matrix);
+        quaternion_from_matrix (path->matrix, path->rotation);
+        path->is_static = i <= up->static_len && j <= down->static_len;
+        path->found = TRUE;
+        break;
+      }
+    }
+
+    /* Unconnected at any stamp only if neither walk was cut short by time */
+    if (!path->found)
+      path->is_static = up->static_len == up->len &&
+          down->static_len == down->len;
+  }
+
+  memo_write (slot, path);
+}
+
+/* ── Public API ────────────────────────────────────────────────────── */
+
 EdgefirstTransformCache *
 edgefirst_transform_cache_new (void)
 {
   EdgefirstTransformCache *cache = g_new0 (EdgefirstTransformCache, 1);
 
-  cache->transforms = g_hash_table_new_full (g_str_hash, g_str_equal,
-      g_free, g_free);
   g_mutex_init (&cache->lock);
+  cache->handles = g_hash_table_new_full (g_str_hash, g_str_equal,
+      g_free, NULL);
 
   return cache;
 }
@@ -34,26 +542,88 @@ edgefirst_transform_cache_free (EdgefirstTransformCache *cache)
   if (!cache)
     return;
 
-  g_hash_table_destroy (cache->transforms);
+  for (gint i = 1; i <= cache->n_frames; i++)
+    g_free (cache->frames[i]);
+  g_hash_table_destroy (cache->handles);
   g_mutex_clear (&cache->lock);
   g_free (cache);
 }
 
+guint
+edgefirst_transform_cache_intern (EdgefirstTransformCache *cache,
+    const gchar *frame_id)
+{
+  guint handle;
+
+  g_return_val_if_fail (cache != NULL, 0);
+  g_return_val_if_fail (frame_id != NULL, 0);
+
+  g_mutex_lock (&cache->lock);
+  handle = intern_locked (cache, frame_id);
+  g_mutex_unlock (&cache->lock);
+
+  return handle;
+}
+
 void
 edgefirst_transform_cache_insert (EdgefirstTransformCache *cache,
     const EdgefirstTransformData *transform)
 {
-  EdgefirstTransformData *copy;
+  FrameSlot *frame;
 
   g_return_if_fail (cache != NULL);
   g_return_if_fail (transform != NULL);
 
-  copy = g_new (EdgefirstTransformData, 1);
-  memcpy (copy, transform, sizeof (EdgefirstTransformData));
+  g_mutex_lock (&cache->lock);
+  frame = frame_write_begin (cache, transform, TRUE);
+  if (frame) {
+    sample_from_data (&frame->samples[0], transform);
+    frame->head = 0;
+    frame->len = 1;
+    frame_write_end (cache, frame);
+  }
+  g_mutex_unlock (&cache->lock);
+}
+
+void
+edgefirst_transform_cache_insert_dynamic (EdgefirstTransformCache *cache,
+    const EdgefirstTransformData *transform)
+{
+  FrameSlot *frame;
+  guint pos;
+
+  g_return_if_fail (cache != NULL);
+  g_return_if_fail (transform != NULL);
 
   g_mutex_lock (&cache->lock);
-  g_hash_table_replace (cache->transforms,
-      g_strdup (transform->child_frame_id), copy);
+  frame = frame_write_begin (cache, transform, FALSE);
+  if (!frame)
+    goto done;
+
+  /* Almost always appended; a late transform is moved into place */
+  pos = frame_upper_bound (frame, frame->len, transform->timestamp_ns);
+  if (pos > 0 && frame_at (frame, pos - 1)->stamp == transform->timestamp_ns) {
+    sample_from_data (frame_at (frame, pos - 1), transform);
+    goto end;
+  }
+
+  if (frame->len == EDGEFIRST_TRANSFORM_CACHE_DEPTH) {
+    /* Older than the whole full history */
+    if (pos == 0)
+      goto end;
+    frame->head = (frame->head + 1) % EDGEFIRST_TRANSFORM_CACHE_DEPTH;
+    frame->len--;
+    pos--;
+  }
+
+  for (guint i = frame->len; i > pos; i--)
+    *frame_at (frame, i) = *frame_at (frame, i - 1);
+  sample_from_data (frame_at (frame, pos), transform);
+  frame->len++;
+
+end:
+  frame_write_end (cache, frame);
+done:
   g_mutex_unlock (&cache->lock);
 }
 
@@ -63,36 +633,141 @@ edgefirst_transform_cache_lookup (EdgefirstTransformCache *cache,
     const gchar *parent_frame_id,
     EdgefirstTransformData *transform_out)
 {
-  EdgefirstTransformData *found;
-  gboolean result = FALSE;
+  return edgefirst_transform_cache_lookup_at_time (cache, child_frame_id,
+      parent_frame_id, 0, transform_out);
+}
+
+gboolean
+edgefirst_transform_cache_lookup_at_time (EdgefirstTransformCache *cache,
+    const gchar *child_frame_id, const gchar *parent_frame_id,
+    guint64 time_ns, EdgefirstTransformData *transform_out)
+{
+  guint child;
 
   g_return_val_if_fail (cache != NULL, FALSE);
   g_return_val_if_fail (child_frame_id != NULL, FALSE);
   g_return_val_if_fail (transform_out != NULL, FALSE);
 
   g_mutex_lock (&cache->lock);
+  child = find_locked (cache, child_frame_id);
+  g_mutex_unlock (&cache->lock);
 
-  found = g_hash_table_lookup (cache->transforms, child_frame_id);
-  if (found) {
-    /* If parent_frame_id is specified, verify it matches */
-    if (parent_frame_id == NULL ||
-        g_strcmp0 (found->parent_frame_id, parent_frame_id) == 0) {
-      memcpy (transform_out, found, sizeof (EdgefirstTransformData));
-      result = TRUE;
-    }
-  }
+  if (!edgefirst_transform_cache_lookup_frame (cache, child, time_ns,
+          transform_out))
+    return FALSE;
+
+  /* If parent_frame_id is specified, verify it matches */
+  return parent_frame_id == NULL ||
+      strcmp (transform_out->parent_frame_id, parent_frame_id) == 0;
+}
+
+gboolean
+edgefirst_transform_cache_lookup_frame (EdgefirstTransformCache *cache,
+    guint child_frame, guint64 time_ns, EdgefirstTransformData *transform_out)
+{
+  TransformSample sample;
+  FrameSlot *frame;
+  guint parent;
+
+  g_return_val_if_fail (cache != NULL, FALSE);
+  g_return_val_if_fail (transform_out != NULL, FALSE);
+
+  frame = frame_get (cache, child_frame);
+  if (!frame || !frame_read (frame, time_ns, &sample, &parent, NULL))
+    return FALSE;
+
+  sample_to_data (&sample, frame->frame_id,
+      frame_get (cache, parent)->frame_id, transform_out);
+  return TRUE;
+}
+
+gboolean
+edgefirst_transform_cache_resolve (EdgefirstTransformCache *cache,
+    const gchar *source_frame_id, const gchar *target_frame_id,
+    guint64 time_ns, gdouble matrix_out[12])
+{
+  guint source, target;
 
+  g_return_val_if_fail (cache != NULL, FALSE);
+  g_return_val_if_fail (source_frame_id != NULL, FALSE);
+  g_return_val_if_fail (target_frame_id != NULL, FALSE);
+  g_return_val_if_fail (matrix_out != NULL, FALSE);
+
+  g_mutex_lock (&cache->lock);
+  source = intern_locked (cache, source_frame_id);
+  target = intern_locked (cache, target_frame_id);
   g_mutex_unlock (&cache->lock);
 
-  return result;
+  return edgefirst_transform_cache_resolve_frames (cache, source, target,
+      time_ns, matrix_out, NULL);
+}
+
+gboolean
+edgefirst_transform_cache_resolve_transform (EdgefirstTransformCache *cache,
+    const gchar *source_frame_id, const gchar *target_frame_id,
+    guint64 time_ns, EdgefirstTransformData *transform_out)
+{
+  guint source, target;
+
+  g_return_val_if_fail (cache != NULL, FALSE);
+  g_return_val_if_fail (source_frame_id != NULL, FALSE);
+  g_return_val_if_fail (target_frame_id != NULL, FALSE);
+  g_return_val_if_fail (transform_out != NULL, FALSE);
+
+  g_mutex_lock (&cache->lock);
+  source = intern_locked (cache, source_frame_id);
+  target = intern_locked (cache, target_frame_id);
+  g_mutex_unlock (&cache->lock);
+
+  return edgefirst_transform_cache_resolve_frames (cache, source, target,
+      time_ns, NULL, transform_out);
+}
+
+gboolean
+edgefirst_transform_cache_resolve_frames (EdgefirstTransformCache *cache,
+    guint source_frame, guint target_frame, guint64 time_ns,
+    gdouble matrix_out[12], EdgefirstTransformData *transform_out)
+{
+  MemoSlot path;
+
+  g_return_val_if_fail (cache != NULL, FALSE);
+
+  resolve (cache, source_frame, target_frame, time_ns, &path);
+  if (!path.found)
+    return FALSE;
+
+  if (matrix_out)
+    memcpy (matrix_out, path.matrix, sizeof (path.matrix));
+  if (transform_out) {
+    for (guint axis = 0; axis < 3; axis++)
+      transform_out->translation[axis] = path.matrix[axis * 4 + 3];
+    memcpy (transform_out->rotation, path.rotation,
+        sizeof (transform_out->rotation));
+    g_strlcpy (transform_out->child_frame_id,
+        frame_get (cache, source_frame)->frame_id,
+        EDGEFIRST_FRAME_ID_MAX_LEN);
+    g_strlcpy (transform_out->parent_frame_id,
+        frame_get (cache, target_frame)->frame_id,
+        EDGEFIRST_FRAME_ID_MAX_LEN);
+    transform_out->timestamp_ns = time_ns;
+  }
+  return TRUE;
 }
 
 void
 edgefirst_transform_cache_clear (EdgefirstTransformCache *cache)
 {
+  FrameSlot *frame;
+
   g_return_if_fail (cache != NULL);
 
   g_mutex_lock (&cache->lock);
-  g_hash_table_remove_all (cache->transforms);
+  for (gint i = 1; i <= cache->n_frames; i++) {
+    frame = cache->frames[i];
+    g_atomic_int_inc (&frame->seq);
+    frame->parent = 0;
+    frame->len = 0;
+    frame_write_end (cache, frame);
+  }
   g_mutex_unlock (&cache->lock);
 }
@@ -12,6 +12,51 @@
 
 G_BEGIN_DECLS
 
+/**
+ * EDGEFIRST_TRANSFORM_CACHE_DEPTH:
+ *
+ * Transforms kept per dynamic frame, about 1.3 s of history at 200 Hz.
+ */
+#define EDGEFIRST_TRANSFORM_CACHE_DEPTH 256
+
+/**
+ * EDGEFIRST_TRANSFORM_CACHE_MAX_EXTRAPOLATION:
+ *
+ * How far (in nanoseconds) a lookup may fall outside the buffered history
+ * of a dynamic frame and still return the nearest transform.
+ */
+#define EDGEFIRST_TRANSFORM_CACHE_MAX_EXTRAPOLATION \
+  (G_GUINT64_CONSTANT (100) * 1000 * 1000)
+
+/**
+ * EDGEFIRST_TRANSFORM_CACHE_MAX_DEPTH:
+ *
+ * Longest chain of parent frames followed when resolving a path; deeper
+ * trees, and cycles, do not resolve.
+ */
+#define EDGEFIRST_TRANSFORM_CACHE_MAX_DEPTH 32
+
+/**
+ * EDGEFIRST_TRANSFORM_CACHE_MAX_FRAMES:
+ *
+ * Frame ids a cache can intern; transforms of further frames are dropped.
+ */
+#define EDGEFIRST_TRANSFORM_CACHE_MAX_FRAMES 256
+
+/**
+ * EdgefirstTransformCache:
+ *
+ * Transforms keyed by child frame.  A static frame holds the latest
+ * transform; a dynamic frame holds a time-ordered ring of the last
+ * %EDGEFIRST_TRANSFORM_CACHE_DEPTH transforms.  All functions are
+ * thread-safe.
+ *
+ * Frame ids are interned to integer handles that stay valid for the life
+ * of the cache.  Lookups by handle take no lock and do no string work:
+ * each frame is guarded by a sequence counter, and a reader that races an
+ * insert into the same frame simply reads it again.  Inserts and the
+ * string-keyed functions serialize on a mutex.
+ */
 typedef struct _EdgefirstTransformCache EdgefirstTransformCache;
 
 /**
@@ -31,16 +76,43 @@ EdgefirstTransformCache *edgefirst_transform_cache_new (void);
  */
 void edgefirst_transform_cache_free (EdgefirstTransformCache *cache);
 
+/**
+ * edgefirst_transform_cache_intern:
+ * @cache: a #EdgefirstTransformCache
+ * @frame_id: a frame id
+ *
+ * Returns the handle of @frame_id, registering the frame if it is new.
+ * Takes the cache mutex; call it once per frame and keep the handle.
+ *
+ * Returns: the frame handle, or 0 if the cache holds
+ *   %EDGEFIRST_TRANSFORM_CACHE_MAX_FRAMES frames already
+ */
+guint edgefirst_transform_cache_intern (EdgefirstTransformCache *cache,
+    const gchar *frame_id);
+
 /**
  * edgefirst_transform_cache_insert:
  * @cache: a #EdgefirstTransformCache
  * @transform: the transform to insert
  *
- * Inserts a transform into the cache, keyed by child_frame_id.
+ * Inserts a static transform into the cache, keyed by child_frame_id.
+ * It replaces any earlier transform or history of the frame.
  */
 void edgefirst_transform_cache_insert (EdgefirstTransformCache *cache,
     const EdgefirstTransformData *transform);
 
+/**
+ * edgefirst_transform_cache_insert_dynamic:
+ * @cache: a #EdgefirstTransformCache
+ * @transform: the transform to insert, stamped with timestamp_ns
+ *
+ * Adds a transform to the history of its child frame, dropping the oldest
+ * one when the history is full.  Late transforms are inserted in stamp
+ * order.  A new parent frame restarts the history.
+ */
+void edgefirst_transform_cache_insert_dynamic (EdgefirstTransformCache *cache,
+    const EdgefirstTransformData *transform);
+
 /**
  * edgefirst_transform_cache_lookup:
  * @cache: a #EdgefirstTransformCache
@@ -48,7 +120,7 @@ void edgefirst_transform_cache_insert (EdgefirstTransformCache *cache,
  * @parent_frame_id: the target frame
  * @transform_out: (out): location to store the transform
  *
- * Looks up a transform from child_frame to parent_frame.
+ * Looks up the latest transform from child_frame to parent_frame.
  *
  * Returns: TRUE if the transform was found
  */
@@ -57,11 +129,110 @@ gboolean edgefirst_transform_cache_lookup (EdgefirstTransformCache *cache,
     const gchar *parent_frame_id,
     EdgefirstTransformData *transform_out);
 
+/**
+ * edgefirst_transform_cache_lookup_at_time:
+ * @cache: a #EdgefirstTransformCache
+ * @child_frame_id: the source frame
+ * @parent_frame_id: (nullable): the target frame, or %NULL for any
+ * @time_ns: stamp to look up, 0 for the latest
+ * @transform_out: (out): location to store the transform
+ *
+ * Looks up the transform of a dynamic frame at @time_ns, interpolating
+ * between the two transforms around it: linearly for the translation and
+ * by SLERP for the rotation.  Outside the history, the nearest transform
+ * is returned if it is within %EDGEFIRST_TRANSFORM_CACHE_MAX_EXTRAPOLATION.
+ * Static frames return their transform at any time.
+ *
+ * Returns: TRUE if a transform was found
+ */
+gboolean edgefirst_transform_cache_lookup_at_time (
+    EdgefirstTransformCache *cache, const gchar *child_frame_id,
+    const gchar *parent_frame_id, guint64 time_ns,
+    EdgefirstTransformData *transform_out);
+
+/**
+ * edgefirst_transform_cache_resolve:
+ * @cache: a #EdgefirstTransformCache
+ * @source_frame_id: frame the points are in
+ * @target_frame_id: frame the points are wanted in
+ * @time_ns: stamp to look up, 0 for the latest
+ * @matrix_out: (out) (array fixed-size=12): row-major 3x4 matrix [R | t]
+ *   taking points from @source_frame_id to @target_frame_id
+ *
+ * Resolves the transform between two frames of the same tree, walking
+ * from each frame up to their common ancestor and inverting the target
+ * side.  Each edge is looked up at @time_ns as in
+ * edgefirst_transform_cache_lookup_at_time().
+ *
+ * Composed matrices are memoized per frame pair and stamp until the next
+ * insert, so repeated lookups for the same pair cost one hash lookup.
+ *
+ * Returns: TRUE if both frames are connected at @time_ns
+ */
+gboolean edgefirst_transform_cache_resolve (EdgefirstTransformCache *cache,
+    const gchar *source_frame_id, const gchar *target_frame_id,
+    guint64 time_ns, gdouble matrix_out[12]);
+
+/**
+ * edgefirst_transform_cache_resolve_transform:
+ * @cache: a #EdgefirstTransformCache
+ * @source_frame_id: frame the points are in
+ * @target_frame_id: frame the points are wanted in
+ * @time_ns: stamp to look up, 0 for the latest
+ * @transform_out: (out): location to store the transform
+ *
+ * Same as edgefirst_transform_cache_resolve(), as a translation and
+ * quaternion with @source_frame_id as child and @target_frame_id as
+ * parent.
+ *
+ * Returns: TRUE if both frames are connected at @time_ns
+ */
+gboolean edgefirst_transform_cache_resolve_transform (
+    EdgefirstTransformCache *cache, const gchar *source_frame_id,
+    const gchar *target_frame_id, guint64 time_ns,
+    EdgefirstTransformData *transform_out);
+
+/**
+ * edgefirst_transform_cache_lookup_frame:
+ * @cache: a #EdgefirstTransformCache
+ * @child_frame: handle of the source frame
+ * @time_ns: stamp to look up, 0 for the latest
+ * @transform_out: (out): location to store the transform
+ *
+ * Lock-free edgefirst_transform_cache_lookup_at_time() by frame handle,
+ * for any parent frame.
+ *
+ * Returns: TRUE if a transform was found
+ */
+gboolean edgefirst_transform_cache_lookup_frame (
+    EdgefirstTransformCache *cache, guint child_frame, guint64 time_ns,
+    EdgefirstTransformData *transform_out);
+
+/**
+ * edgefirst_transform_cache_resolve_frames:
+ * @cache: a #EdgefirstTransformCache
+ * @source_frame: handle of the frame the points are in
+ * @target_frame: handle of the frame the points are wanted in
+ * @time_ns: stamp to look up, 0 for the latest
+ * @matrix_out: (out) (optional) (array fixed-size=12): row-major 3x4
+ *   matrix [R | t] taking points from @source_frame to @target_frame
+ * @transform_out: (out) (optional): the same as a translation and
+ *   quaternion
+ *
+ * Lock-free edgefirst_transform_cache_resolve() by frame handle.
+ *
+ * Returns: TRUE if both frames are connected at @time_ns
+ */
+gboolean edgefirst_transform_cache_resolve_frames (
+    EdgefirstTransformCache *cache, guint source_frame, guint target_frame,
+    guint64 time_ns, gdouble matrix_out[12],
+    EdgefirstTransformData *transform_out);
+
 /**
  * edgefirst_transform_cache_clear:
  * @cache: a #EdgefirstTransformCache
  *
- * Clears all transforms from the cache.
+ * Clears all transforms from the cache.  Frame handles stay valid.
  */
 void edgefirst_transform_cache_clear (EdgefirstTransformCache *cache);
 
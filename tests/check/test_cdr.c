@@ -0,0 +1,656 @@
+/*
+ * EdgeFirst Perception for GStreamer - CDR View Parser Tests
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/edgefirst/edgefirst.h>
+#include <string.h>
+
+#include "edgefirstzenoh-encode.h"
+
+/* ── Minimal little-endian CDR builder ─────────────────────────────── */
+
+typedef struct {
+  guint8 buf[4096];
+  gsize len;
+} CdrBuilder;
+
+static void
+cdr_begin (CdrBuilder *b)
+{
+  static const guint8 cdr_le_header[4] = { 0x00, 0x01, 0x00, 0x00 };
+
+  memcpy (b->buf, cdr_le_header, 4);
+  b->len = 4;
+}
+
+static void
+cdr_align (CdrBuilder *b, gsize align)
+{
+  while ((b->len - 4) % align)
+    b->buf[b->len++] = 0;
+}
+
+static void
+cdr_put (CdrBuilder *b, gsize align, const void *v, gsize n)
+{
+  cdr_align (b, align);
+  memcpy (b->buf + b->len, v, n);
+  b->len += n;
+}
+
+static void
+cdr_u8 (CdrBuilder *b, guint8 v)
+{
+  cdr_put (b, 1, &v, 1);
+}
+
+static void
+cdr_u16 (CdrBuilder *b, guint16 v)
+{
+  cdr_put (b, 2, &v, 2);
+}
+
+static void
+cdr_u32 (CdrBuilder *b, guint32 v)
+{
+  cdr_put (b, 4, &v, 4);
+}
+
+static void
+cdr_f32 (CdrBuilder *b, gfloat v)
+{
+  cdr_put (b, 4, &v, 4);
+}
+
+static void
+cdr_u64 (CdrBuilder *b, guint64 v)
+{
+  cdr_put (b, 8, &v, 8);
+}
+
+static void
+cdr_f64 (CdrBuilder *b, gdouble v)
+{
+  cdr_put (b, 8, &v, 8);
+}
+
+static void
+cdr_string (CdrBuilder *b, const gchar *s)
+{
+  cdr_u32 (b, (guint32) strlen (s) + 1);
+  cdr_put (b, 1, s, strlen (s) + 1);
+}
+
+static void
+cdr_header (CdrBuilder *b, gint32 sec, guint32 nsec, const gchar *frame_id)
+{
+  cdr_u32 (b, (guint32) sec);
+  cdr_u32 (b, nsec);
+  cdr_string (b, frame_id);
+}
+
+static void
+cdr_point_field (CdrBuilder *b, const gchar *name, guint32 offset,
+    guint8 datatype)
+{
+  cdr_string (b, name);
+  cdr_u32 (b, offset);
+  cdr_u8 (b, datatype);
+  cdr_u32 (b, 1);
+}
+
+/* PointCloud2 with 2 points of x/y/z F32 + intensity U16 (point_step 14) */
+static void
+build_pointcloud2 (CdrBuilder *b)
+{
+  static const guint8 points[28] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+  };
+
+  cdr_begin (b);
+  cdr_header (b, 100, 500, "lidar");
+  cdr_u32 (b, 1);     /* height */
+  cdr_u32 (b, 2);     /* width */
+  cdr_u32 (b, 4);     /* fields */
+  cdr_point_field (b, "x", 0, EDGEFIRST_POINT_FIELD_FLOAT32);
+  cdr_point_field (b, "y", 4, EDGEFIRST_POINT_FIELD_FLOAT32);
+  cdr_point_field (b, "z", 8, EDGEFIRST_POINT_FIELD_FLOAT32);
+  cdr_point_field (b, "intensity", 12, EDGEFIRST_POINT_FIELD_UINT16);
+  cdr_u8 (b, 0);      /* is_bigendian */
+  cdr_u32 (b, 14);    /* point_step */
+  cdr_u32 (b, 28);    /* row_step */
+  cdr_u32 (b, sizeof (points));
+  cdr_put (b, 1, points, sizeof (points));
+  cdr_u8 (b, 1);      /* is_dense */
+}
+
+/* ── Minimal little-endian CDR reader ──────────────────────────────── */
+
+/* Reads what the publisher's encoders wrote, for messages the core library
+ * has no view of */
+typedef struct {
+  const guint8 *buf;
+  gsize len;
+  gsize pos;
+} CdrReader;
+
+static void
+cdr_read (CdrReader *r, gsize align, void *v, gsize n)
+{
+  while ((r->pos - 4) % align)
+    r->pos++;
+  fail_unless (r->pos + n <= r->len);
+  memcpy (v, r->buf + r->pos, n);
+  r->pos += n;
+}
+
+static guint32
+cdr_read_u32 (CdrReader *r)
+{
+  guint32 v;
+
+  cdr_read (r, 4, &v, 4);
+  return v;
+}
+
+static gfloat
+cdr_read_f32 (CdrReader *r)
+{
+  gfloat v;
+
+  cdr_read (r, 4, &v, 4);
+  return v;
+}
+
+static guint64
+cdr_read_time_ns (CdrReader *r)
+{
+  guint64 sec = cdr_read_u32 (r);
+
+  return sec * G_GUINT64_CONSTANT (1000000000) + cdr_read_u32 (r);
+}
+
+static const gchar *
+cdr_read_string (CdrReader *r)
+{
+  guint32 n = cdr_read_u32 (r);
+  const gchar *str = (const gchar *) r->buf + r->pos;
+
+  fail_unless (n > 0 && r->pos + n <= r->len);
+  fail_unless (str[n - 1] == '\0');
+  r->pos += n;
+  return str;
+}
+
+/* ── Tests ─────────────────────────────────────────────────────────── */
+
+GST_START_TEST (test_cdr_header)
+{
+  CdrBuilder b;
+  EdgefirstCdrHeader header;
+
+  cdr_begin (&b);
+  cdr_header (&b, 12, 345, "base_link");
+
+  fail_unless (edgefirst_cdr_header_parse (b.buf, b.len, &header));
+  fail_unless_equals_int (header.stamp_sec, 12);
+  fail_unless_equals_int (header.stamp_nanosec, 345);
+  fail_unless_equals_string (header.frame_id, "base_link");
+  fail_unless_equals_int (header.frame_id_len, 9);
+  fail_unless (edgefirst_cdr_header_get_timestamp_ns (&header) ==
+      G_GUINT64_CONSTANT (12000000345));
+
+  /* frame_id must point into the payload, not a copy */
+  fail_unless ((const guint8 *) header.frame_id > b.buf &&
+      (const guint8 *) header.frame_id < b.buf + b.len);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_pointcloud2)
+{
+  CdrBuilder b;
+  EdgefirstCdrPointCloud2View view;
+  EdgefirstPointFieldDesc fields[8];
+  guint n;
+
+  build_pointcloud2 (&b);
+
+  fail_unless (edgefirst_cdr_pointcloud2_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_string (view.header.frame_id, "lidar");
+  fail_unless_equals_int (view.height, 1);
+  fail_unless_equals_int (view.width, 2);
+  fail_unless_equals_int (view.point_step, 14);
+  fail_unless_equals_int (view.row_step, 28);
+  fail_unless_equals_int (view.is_bigendian, FALSE);
+  fail_unless_equals_int (view.is_dense, TRUE);
+  fail_unless_equals_int (view.data_len, 28);
+  fail_unless (view.data == b.buf + view.data_offset);
+  fail_unless_equals_int (view.data[0], 1);
+  fail_unless_equals_int (view.data[27], 28);
+
+  fail_unless_equals_int (view.num_fields, 4);
+  /* First PointField starts with the length of "x" including NUL */
+  fail_unless_equals_int (view.fields[0], 2);
+  fail_unless (view.fields + view.fields_len <= view.data);
+  n = edgefirst_cdr_pointcloud2_view_get_fields (&view, fields, 8);
+  fail_unless_equals_int (n, 4);
+  fail_unless_equals_string (fields[0].name, "x");
+  fail_unless_equals_int (fields[1].offset, 4);
+  fail_unless_equals_string (fields[3].name, "intensity");
+  fail_unless_equals_int (fields[3].datatype, EDGEFIRST_POINT_FIELD_UINT16);
+  fail_unless_equals_int (fields[3].offset, 12);
+
+  /* Caller capacity is honoured */
+  n = edgefirst_cdr_pointcloud2_view_get_fields (&view, fields, 2);
+  fail_unless_equals_int (n, 2);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_pointcloud2_truncated)
+{
+  CdrBuilder b;
+  EdgefirstCdrPointCloud2View view;
+
+  build_pointcloud2 (&b);
+
+  /* Every proper prefix of the message must be rejected */
+  for (gsize len = 0; len < b.len; len++)
+    fail_if (edgefirst_cdr_pointcloud2_view_parse (b.buf, len, &view),
+        "accepted truncated message of %" G_GSIZE_FORMAT " bytes", len);
+
+  /* A data length pointing past the end must be rejected */
+  build_pointcloud2 (&b);
+  b.buf[b.len - 1 - 28 - 4] = 0xff;
+  fail_if (edgefirst_cdr_pointcloud2_view_parse (b.buf, b.len, &view));
+
+  fail_if (edgefirst_cdr_pointcloud2_view_parse (NULL, 0, &view));
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_pointcloud2_split)
+{
+  CdrBuilder b;
+  EdgefirstCdrPointCloud2View full, view;
+  gsize head_len;
+
+  build_pointcloud2 (&b);
+  fail_unless (edgefirst_cdr_pointcloud2_view_parse (b.buf, b.len, &full));
+
+  /* Head up to the point data, tail holding only is_dense */
+  head_len = full.data_offset;
+  fail_unless (edgefirst_cdr_pointcloud2_view_parse_split (b.buf, head_len,
+          b.buf + b.len - 1, 1, b.len, &view));
+  fail_unless (view.data == NULL);
+  fail_unless_equals_int (view.data_offset, full.data_offset);
+  fail_unless_equals_int (view.data_len, 28);
+  fail_unless_equals_int (view.point_step, 14);
+  fail_unless_equals_int (view.is_dense, TRUE);
+  fail_unless (view.fields == full.fields);
+
+  /* The head must reach the data length, the tail the trailing flag */
+  fail_if (edgefirst_cdr_pointcloud2_view_parse_split (b.buf, head_len - 4,
+          b.buf + b.len - 1, 1, b.len, &view));
+  fail_if (edgefirst_cdr_pointcloud2_view_parse_split (b.buf, head_len,
+          NULL, 0, b.len, &view));
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_radar_cube)
+{
+  CdrBuilder b;
+  EdgefirstCdrRadarCubeView view;
+  static const gint16 cube[8] = { 1, -2, 3, -4, 5, -6, 7, -8 };
+  gint16 first, last;
+
+  cdr_begin (&b);
+  cdr_header (&b, 1, 2, "radar");
+  cdr_u64 (&b, G_GUINT64_CONSTANT (123456789012));
+  cdr_u32 (&b, 3);    /* layout */
+  cdr_u8 (&b, EDGEFIRST_RADAR_DIM_RANGE);
+  cdr_u8 (&b, EDGEFIRST_RADAR_DIM_DOPPLER);
+  cdr_u8 (&b, EDGEFIRST_RADAR_DIM_RXCHANNEL);
+  cdr_u32 (&b, 3);    /* shape */
+  cdr_u16 (&b, 2);
+  cdr_u16 (&b, 2);
+  cdr_u16 (&b, 2);
+  cdr_u32 (&b, 3);    /* scales */
+  cdr_f32 (&b, 0.25f);
+  cdr_f32 (&b, 0.5f);
+  cdr_f32 (&b, 1.0f);
+  cdr_u32 (&b, G_N_ELEMENTS (cube));
+  cdr_put (&b, 2, cube, sizeof (cube));
+  cdr_u8 (&b, 1);     /* is_complex */
+
+  fail_unless (edgefirst_cdr_radar_cube_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_string (view.header.frame_id, "radar");
+  fail_unless (view.timestamp == G_GUINT64_CONSTANT (123456789012));
+  fail_unless_equals_int (view.layout_len, 3);
+  fail_unless_equals_int (view.layout[1], EDGEFIRST_RADAR_DIM_DOPPLER);
+  fail_unless_equals_int (view.shape_len, 3);
+  fail_unless_equals_int (view.shape[2], 2);
+  fail_unless_equals_int (view.scales_len, 3);
+  fail_unless_equals_float (view.scales[0], 0.25f);
+  fail_unless_equals_float (view.scales[2], 1.0f);
+  fail_unless_equals_int (view.cube_len, 8);
+  fail_unless (view.cube == b.buf + view.cube_offset);
+  fail_unless_equals_int (view.is_complex, TRUE);
+
+  memcpy (&first, view.cube, 2);
+  memcpy (&last, view.cube + 14, 2);
+  fail_unless_equals_int (first, 1);
+  fail_unless_equals_int (last, -8);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_image)
+{
+  CdrBuilder b;
+  EdgefirstCdrImageView view;
+  static const guint8 pixels[12] = { 0 };
+
+  cdr_begin (&b);
+  cdr_header (&b, 5, 6, "camera");
+  cdr_u32 (&b, 2);    /* height */
+  cdr_u32 (&b, 2);    /* width */
+  cdr_string (&b, "rgb8");
+  cdr_u8 (&b, 0);     /* is_bigendian */
+  cdr_u32 (&b, 6);    /* step */
+  cdr_u32 (&b, sizeof (pixels));
+  cdr_put (&b, 1, pixels, sizeof (pixels));
+
+  fail_unless (edgefirst_cdr_image_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_int (view.width, 2);
+  fail_unless_equals_int (view.height, 2);
+  fail_unless_equals_string (view.encoding, "rgb8");
+  fail_unless_equals_int (view.encoding_len, 4);
+  fail_unless_equals_int (view.step, 6);
+  fail_unless_equals_int (view.data_len, 12);
+  fail_unless_equals_int (view.data_offset + view.data_len, b.len);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_camera_info)
+{
+  CdrBuilder b;
+  EdgefirstCdrCameraInfoView view;
+
+  cdr_begin (&b);
+  cdr_header (&b, 0, 0, "camera");
+  cdr_u32 (&b, 1080);
+  cdr_u32 (&b, 1920);
+  cdr_string (&b, "plumb_bob");
+  cdr_u32 (&b, 5);
+  for (guint i = 0; i < 5; i++)
+    cdr_f64 (&b, 0.01 * (i + 1));
+  for (guint i = 0; i < 9; i++)
+    cdr_f64 (&b, i);                /* K */
+  for (guint i = 0; i < 9; i++)
+    cdr_f64 (&b, i == 0 || i == 4 || i == 8 ? 1.0 : 0.0);   /* R */
+  for (guint i = 0; i < 12; i++)
+    cdr_f64 (&b, 100.0 + i);        /* P */
+  cdr_u32 (&b, 1);    /* binning_x */
+  cdr_u32 (&b, 2);    /* binning_y */
+  cdr_u32 (&b, 10);   /* roi */
+  cdr_u32 (&b, 20);
+  cdr_u32 (&b, 30);
+  cdr_u32 (&b, 40);
+  cdr_u8 (&b, 1);
+
+  fail_unless (edgefirst_cdr_camera_info_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_int (view.width, 1920);
+  fail_unless_equals_int (view.height, 1080);
+  fail_unless_equals_string (view.distortion_model, "plumb_bob");
+  fail_unless_equals_int (view.D_len, 5);
+  fail_unless_equals_float (view.D[4], 0.05);
+  fail_unless_equals_float (view.K[5], 5.0);
+  fail_unless_equals_float (view.R[8], 1.0);
+  fail_unless_equals_float (view.P[11], 111.0);
+  fail_unless_equals_int (view.binning_y, 2);
+  fail_unless_equals_int (view.roi_width, 40);
+  fail_unless_equals_int (view.roi_do_rectify, TRUE);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_transform)
+{
+  CdrBuilder b;
+  EdgefirstCdrTransformView view;
+  EdgefirstTransformData td;
+
+  cdr_begin (&b);
+  cdr_header (&b, 3, 4, "base_link");
+  cdr_string (&b, "lidar");
+  cdr_f64 (&b, 1.0);
+  cdr_f64 (&b, 2.0);
+  cdr_f64 (&b, 3.0);
+  cdr_f64 (&b, 0.0);
+  cdr_f64 (&b, 0.0);
+  cdr_f64 (&b, 0.0);
+  cdr_f64 (&b, 1.0);
+
+  fail_unless (edgefirst_cdr_transform_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_string (view.child_frame_id, "lidar");
+
+  edgefirst_cdr_transform_view_to_data (&view, &td);
+  fail_unless_equals_string (td.child_frame_id, "lidar");
+  fail_unless_equals_string (td.parent_frame_id, "base_link");
+  fail_unless_equals_float (td.translation[1], 2.0);
+  fail_unless_equals_float (td.rotation[3], 1.0);
+  fail_unless (td.timestamp_ns == G_GUINT64_CONSTANT (3000000004));
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_dma_buffer)
+{
+  CdrBuilder b;
+  EdgefirstCdrDmaBufferView view;
+
+  cdr_begin (&b);
+  cdr_header (&b, 1, 2, "camera");
+  cdr_u32 (&b, 4242);
+  cdr_u32 (&b, 17);
+  cdr_u32 (&b, 1920);
+  cdr_u32 (&b, 1080);
+  cdr_u32 (&b, 3840);
+  cdr_u32 (&b, GST_MAKE_FOURCC ('Y', 'U', 'Y', 'V'));
+  cdr_u32 (&b, 3840 * 1080);
+
+  fail_unless (edgefirst_cdr_dma_buffer_view_parse (b.buf, b.len, &view));
+  fail_unless_equals_string (view.header.frame_id, "camera");
+  fail_unless_equals_int (view.pid, 4242);
+  fail_unless_equals_int (view.fd, 17);
+  fail_unless_equals_int (view.width, 1920);
+  fail_unless_equals_int (view.height, 1080);
+  fail_unless_equals_int (view.stride, 3840);
+  fail_unless (view.fourcc == GST_MAKE_FOURCC ('Y', 'U', 'Y', 'V'));
+  fail_unless_equals_int (view.length, 3840 * 1080);
+
+  /* Truncated before length */
+  fail_if (edgefirst_cdr_dma_buffer_view_parse (b.buf, b.len - 1, &view));
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_detect_roundtrip)
+{
+  EdgefirstZenohDetectBoxMsg boxes[2] = {
+    { { 0.25f, 0.5f, 0.75f, 1.0f, 3, 0.875f, 42 }, "3", "42" },
+    { { 0.0f, 0.0f, 0.5f, 0.25f, 0, 0.5f, -1 }, "0", "" },
+  };
+  EdgefirstZenohDetectMsg msg = { 0, };
+  EdgefirstZenohCdrWriter w;
+  EdgefirstCdrHeader header;
+  CdrReader r;
+  guint8 *data;
+  gsize size;
+
+  msg.stamp_sec = 1700000000;
+  msg.stamp_nanosec = 123456789;
+  msg.frame_id = "camera";
+  msg.input_timestamp = G_GUINT64_CONSTANT (1700000000123456789);
+  msg.model_time = 4500000;
+  msg.output_time = G_GUINT64_CONSTANT (1700000000130000000);
+  msg.boxes = boxes;
+  msg.num_boxes = G_N_ELEMENTS (boxes);
+
+  /* Sized first, then written into exactly that many bytes */
+  edgefirst_zenoh_cdr_writer_init (&w, NULL, FALSE);
+  edgefirst_zenoh_encode_detect (&w, &msg);
+  size = w.len;
+  data = g_malloc (size);
+  edgefirst_zenoh_cdr_writer_init (&w, data, FALSE);
+  edgefirst_zenoh_encode_detect (&w, &msg);
+  fail_unless_equals_int (w.len, size);
+
+  fail_unless (edgefirst_cdr_header_parse (data, size, &header));
+  fail_unless_equals_int (header.stamp_sec, 1700000000);
+  fail_unless_equals_int (header.stamp_nanosec, 123456789);
+  fail_unless_equals_string (header.frame_id, "camera");
+
+  r.buf = data;
+  r.len = size;
+  r.pos = 4;
+  cdr_read_u32 (&r);
+  cdr_read_u32 (&r);
+  cdr_read_string (&r);
+
+  fail_unless (cdr_read_time_ns (&r) == msg.input_timestamp);
+  fail_unless (cdr_read_time_ns (&r) == msg.model_time);
+  fail_unless (cdr_read_time_ns (&r) == msg.output_time);
+
+  fail_unless_equals_int (cdr_read_u32 (&r), 2);
+  for (guint i = 0; i < 2; i++) {
+    const EdgeFirstDetectBox *box = &boxes[i].box;
+
+    /* Corners travel as centre and size */
+    fail_unless_equals_float (cdr_read_f32 (&r), (box->x1 + box->x2) / 2);
+    fail_unless_equals_float (cdr_read_f32 (&r), (box->y1 + box->y2) / 2);
+    fail_unless_equals_float (cdr_read_f32 (&r), box->x2 - box->x1);
+    fail_unless_equals_float (cdr_read_f32 (&r), box->y2 - box->y1);
+    fail_unless_equals_string (cdr_read_string (&r), boxes[i].label);
+    fail_unless_equals_float (cdr_read_f32 (&r), box->score);
+    fail_unless_equals_float (cdr_read_f32 (&r), 0.0f);   /* distance */
+    fail_unless_equals_float (cdr_read_f32 (&r), 0.0f);   /* speed */
+    fail_unless_equals_string (cdr_read_string (&r), boxes[i].track_id);
+    fail_unless_equals_int (cdr_read_u32 (&r), 0);        /* lifetime */
+    fail_unless (cdr_read_time_ns (&r) == 0);             /* created */
+  }
+  fail_unless_equals_int (r.pos, size);
+
+  g_free (data);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_detect_from_meta)
+{
+  EdgefirstZenohDetectMsg msg;
+  EdgeFirstDetectBoxList *boxes;
+  EdgefirstDetectionMeta *meta;
+  GArray *entries;
+  GstBuffer *buf;
+
+  edgefirst_perception_init ();
+  entries = g_array_new (FALSE, FALSE, sizeof (EdgefirstZenohDetectBoxMsg));
+
+  /* Nothing to publish without the meta */
+  buf = gst_buffer_new ();
+  fail_if (edgefirst_zenoh_detect_msg_init (&msg, entries, buf, 1000));
+
+  boxes = g_object_new (EDGEFIRST_TYPE_DETECT_BOX_LIST, NULL);
+  meta = edgefirst_buffer_add_detection_meta (buf, boxes);
+  g_object_unref (boxes);
+  meta->input_timestamp = G_GUINT64_CONSTANT (5000000007);
+  meta->model_time_ns = 3000000;
+  g_strlcpy (meta->frame_id, "camera", EDGEFIRST_FRAME_ID_MAX_LEN);
+
+  fail_unless (edgefirst_zenoh_detect_msg_init (&msg, entries, buf,
+          G_GUINT64_CONSTANT (6000000000)));
+  fail_unless_equals_int (msg.stamp_sec, 5);
+  fail_unless_equals_int (msg.stamp_nanosec, 7);
+  fail_unless_equals_string (msg.frame_id, "camera");
+  fail_unless (msg.input_timestamp == G_GUINT64_CONSTANT (5000000007));
+  fail_unless (msg.model_time == 3000000);
+  fail_unless (msg.output_time == G_GUINT64_CONSTANT (6000000000));
+  fail_unless_equals_int (msg.num_boxes, 0);
+
+  /* Without an input timestamp the message is stamped with output_time */
+  meta->input_timestamp = 0;
+  fail_unless (edgefirst_zenoh_detect_msg_init (&msg, entries, buf,
+          G_GUINT64_CONSTANT (6000000000)));
+  fail_unless_equals_int (msg.stamp_sec, 6);
+  fail_unless_equals_int (msg.stamp_nanosec, 0);
+
+  gst_buffer_unref (buf);
+  g_array_unref (entries);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_big_endian)
+{
+  /* Header: stamp 0x00000102 s, 7 ns, frame_id "f" in CDR_BE */
+  static const guint8 be[] = {
+    0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x02,
+    0x00, 0x00, 0x00, 0x07,
+    0x00, 0x00, 0x00, 0x02, 'f', '\0',
+  };
+  EdgefirstCdrHeader header;
+
+  fail_unless (edgefirst_cdr_header_parse (be, sizeof (be), &header));
+  fail_unless_equals_int (header.stamp_sec, 0x102);
+  fail_unless_equals_int (header.stamp_nanosec, 7);
+  fail_unless_equals_string (header.frame_id, "f");
+}
+GST_END_TEST;
+
+GST_START_TEST (test_cdr_bad_string)
+{
+  CdrBuilder b;
+  EdgefirstCdrHeader header;
+
+  cdr_begin (&b);
+  cdr_header (&b, 0, 0, "frame");
+  /* Overwrite the string terminator */
+  b.buf[b.len - 1] = 'x';
+
+  fail_if (edgefirst_cdr_header_parse (b.buf, b.len, &header));
+
+  /* Unknown encapsulation */
+  cdr_begin (&b);
+  cdr_header (&b, 0, 0, "frame");
+  b.buf[1] = 0x07;
+  fail_if (edgefirst_cdr_header_parse (b.buf, b.len, &header));
+}
+GST_END_TEST;
+
+static Suite *
+edgefirst_cdr_suite (void)
+{
+  Suite *s = suite_create ("EdgeFirst CDR");
+  TCase *tc_views = tcase_create ("Views");
+  TCase *tc_errors = tcase_create ("Errors");
+
+  tcase_add_test (tc_views, test_cdr_header);
+  tcase_add_test (tc_views, test_cdr_pointcloud2);
+  tcase_add_test (tc_views, test_cdr_pointcloud2_split);
+  tcase_add_test (tc_views, test_cdr_radar_cube);
+  tcase_add_test (tc_views, test_cdr_image);
+  tcase_add_test (tc_views, test_cdr_camera_info);
+  tcase_add_test (tc_views, test_cdr_transform);
+  tcase_add_test (tc_views, test_cdr_dma_buffer);
+  tcase_add_test (tc_views, test_cdr_detect_roundtrip);
+  tcase_add_test (tc_views, test_cdr_detect_from_meta);
+  tcase_add_test (tc_views, test_cdr_big_endian);
+  suite_add_tcase (s, tc_views);
+
+  tcase_add_test (tc_errors, test_cdr_pointcloud2_truncated);
+  tcase_add_test (tc_errors, test_cdr_bad_string);
+  suite_add_tcase (s, tc_errors);
+
+  return s;
+}
+
+GST_CHECK_MAIN (edgefirst_cdr);
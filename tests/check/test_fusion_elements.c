@@ -6,6 +6,11 @@
 
 #include <gst/check/gstcheck.h>
 #include <gst/base/gstbasetransform.h>
+#include <gst/edgefirst/edgefirst.h>
+#include <string.h>
+
+#include "edgefirstfusion-pool.h"
+#include "edgefirstfusion-project.h"
 
 #ifndef FIXTURE_DIR
 #define FIXTURE_DIR "."
@@ -63,6 +68,31 @@ GST_START_TEST (test_pcd_classify_output_mode_property)
 }
 GST_END_TEST;
 
+GST_START_TEST (test_pcd_classify_n_threads_property)
+{
+  GstElement *el;
+  guint n_threads;
+
+  el = gst_element_factory_make ("edgefirstpcdclassify", NULL);
+  fail_unless (el != NULL);
+
+  /* Default is a single thread */
+  g_object_get (el, "n-threads", &n_threads, NULL);
+  fail_unless_equals_int (n_threads, 1);
+
+  g_object_set (el, "n-threads", 4, NULL);
+  g_object_get (el, "n-threads", &n_threads, NULL);
+  fail_unless_equals_int (n_threads, 4);
+
+  /* 0 = one thread per CPU */
+  g_object_set (el, "n-threads", 0, NULL);
+  g_object_get (el, "n-threads", &n_threads, NULL);
+  fail_unless_equals_int (n_threads, 0);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
 GST_START_TEST (test_transform_inject_properties)
 {
   GstElement *el;
@@ -325,6 +355,117 @@ GST_START_TEST (test_pcd_classify_state_null_to_ready)
 }
 GST_END_TEST;
 
+GST_START_TEST (test_pcd_classify_projection)
+{
+  /* 640x480 camera, f = 500, principal point at the centre */
+  const gsize num_points = 70;
+  const gsize layouts[2][4] = {
+    /* point_step, x_off, y_off, z_off */
+    { 16, 0, 4, 8 },            /* packed x, y, z */
+    { 20, 12, 4, 16 },          /* scattered fields */
+  };
+  const gfloat cloud[5][3] = {
+    { 0.0f, 0.0f, 1.0f },       /* centre */
+    { 0.4f, -0.2f, 1.0f },      /* left and below once rotated */
+    { 0.0f, 0.0f, -2.0f },      /* behind the camera */
+    { 10.0f, 0.0f, 1.0f },      /* left of the mask */
+    { 0.0f, -3.0f, 1.0f },      /* below the mask */
+  };
+  const gint32 expected[5] = { 240 * 640 + 320, 290 * 640 + 220, -1, -1, -1 };
+  GstBuffer *buf = gst_buffer_new ();
+  EdgefirstCameraInfoMeta *camera = edgefirst_buffer_add_camera_info_meta (buf);
+  EdgefirstTransformData transform;
+  EdgefirstFusionProjection proj;
+  gint32 pixels[70];
+
+  camera->width = 640;
+  camera->height = 480;
+  camera->K[0] = 500.0;
+  camera->K[2] = 320.0;
+  camera->K[4] = 500.0;
+  camera->K[5] = 240.0;
+  camera->K[8] = 1.0;
+
+  /* Half a turn about z, one metre back from the camera */
+  edgefirst_transform_data_set_identity (&transform);
+  transform.translation[2] = 1.0;
+  transform.rotation[2] = 1.0;
+  transform.rotation[3] = 0.0;
+  edgefirst_fusion_projection_init (&proj, camera, &transform);
+
+  /* 70 points span a full block and a tail, in both gather paths */
+  for (guint l = 0; l < G_N_ELEMENTS (layouts); l++) {
+    const gsize step = layouts[l][0];
+    guint8 *points = g_malloc0 (num_points * step);
+
+    for (gsize i = 0; i < num_points; i++) {
+      memcpy (points + i * step + layouts[l][1], &cloud[i % 5][0], 4);
+      memcpy (points + i * step + layouts[l][2], &cloud[i % 5][1], 4);
+      memcpy (points + i * step + layouts[l][3], &cloud[i % 5][2], 4);
+    }
+
+    memset (pixels, 0, sizeof (pixels));
+    edgefirst_fusion_project_points (&proj, points, step, layouts[l][1],
+        layouts[l][2], layouts[l][3], num_points, pixels);
+    for (gsize i = 0; i < num_points; i++)
+      fail_unless_equals_int (pixels[i], expected[i % 5]);
+
+    g_free (points);
+  }
+
+  /* Without a transform the centre point sits on the optical axis */
+  edgefirst_fusion_projection_init (&proj, camera, NULL);
+  edgefirst_fusion_project_points (&proj, (const guint8 *) cloud[0],
+      sizeof (cloud[0]), 0, 4, 8, 1, pixels);
+  fail_unless_equals_int (pixels[0], 240 * 640 + 320);
+
+  gst_buffer_unref (buf);
+}
+GST_END_TEST;
+
+static void
+count_task (gpointer data, guint index)
+{
+  gint *counts = data;
+
+  g_atomic_int_inc (&counts[index]);
+}
+
+GST_START_TEST (test_pcd_classify_worker_pool)
+{
+  const guint thread_counts[] = { 1, 3, 8 };
+  gint counts[100];
+
+  for (guint t = 0; t < G_N_ELEMENTS (thread_counts); t++) {
+    EdgefirstFusionPool *pool = edgefirst_fusion_pool_new (thread_counts[t]);
+
+    fail_unless_equals_int (edgefirst_fusion_pool_get_n_threads (pool),
+        thread_counts[t]);
+
+    /* The same workers serve every job; each task runs exactly once */
+    for (guint job = 0; job < 200; job++) {
+      guint n_tasks = job % G_N_ELEMENTS (counts);
+
+      memset (counts, 0, sizeof (counts));
+      edgefirst_fusion_pool_run (pool, n_tasks, count_task, counts);
+      for (guint i = 0; i < G_N_ELEMENTS (counts); i++)
+        fail_unless_equals_int (counts[i], i < n_tasks ? 1 : 0);
+    }
+
+    edgefirst_fusion_pool_free (pool);
+  }
+
+  /* 0 threads sizes the pool to the CPUs */
+  {
+    EdgefirstFusionPool *pool = edgefirst_fusion_pool_new (0);
+
+    fail_unless_equals_int (edgefirst_fusion_pool_get_n_threads (pool),
+        g_get_num_processors ());
+    edgefirst_fusion_pool_free (pool);
+  }
+}
+GST_END_TEST;
+
 /* ── Suite ─────────────────────────────────────────────────────────── */
 
 static Suite *
@@ -339,6 +480,7 @@ edgefirst_fusion_elements_suite (void)
 
   TCase *tc_props = tcase_create ("Properties");
   tcase_add_test (tc_props, test_pcd_classify_output_mode_property);
+  tcase_add_test (tc_props, test_pcd_classify_n_threads_property);
   tcase_add_test (tc_props, test_transform_inject_properties);
   suite_add_tcase (s, tc_props);
 
@@ -350,6 +492,8 @@ edgefirst_fusion_elements_suite (void)
   TCase *tc_behavior = tcase_create ("Behavior");
   tcase_add_test (tc_behavior, test_transform_inject_not_passthrough);
   tcase_add_test (tc_behavior, test_transform_inject_is_in_place);
+  tcase_add_test (tc_behavior, test_pcd_classify_projection);
+  tcase_add_test (tc_behavior, test_pcd_classify_worker_pool);
   suite_add_tcase (s, tc_behavior);
 
   TCase *tc_metadata = tcase_create ("Metadata");
@@ -877,6 +877,7 @@ GST_START_TEST (test_overlay_properties)
   fail_unless_equals_string (s, "yolov8");
   g_free (s);
   g_object_get (el, "model-config", &s, NULL); fail_unless (s == NULL);
+  g_object_get (el, "frame-id",     &s, NULL); fail_unless (s == NULL);
 
   /* Roundtrip */
   g_object_set (el, "score-threshold", 0.5f, NULL);
@@ -887,6 +888,11 @@ GST_START_TEST (test_overlay_properties)
   g_object_get (el, "color-mode", &e, NULL);
   fail_unless_equals_int (e, EDGEFIRST_COLOR_MODE_INSTANCE);
 
+  g_object_set (el, "frame-id", "camera_optical", NULL);
+  g_object_get (el, "frame-id", &s, NULL);
+  fail_unless_equals_string (s, "camera_optical");
+  g_free (s);
+
   gst_object_unref (el);
 }
 GST_END_TEST;
@@ -192,6 +192,50 @@ GST_START_TEST (test_transform_meta_copy)
 }
 GST_END_TEST;
 
+GST_START_TEST (test_detection_meta_copy)
+{
+  GstBuffer *src, *dst;
+  EdgeFirstDetectBoxList *boxes;
+  EdgefirstDetectionMeta *meta, *copy;
+
+  edgefirst_perception_init ();
+
+  src = gst_buffer_new ();
+  boxes = g_object_new (EDGEFIRST_TYPE_DETECT_BOX_LIST, NULL);
+  meta = edgefirst_buffer_add_detection_meta (src, boxes);
+  g_object_unref (boxes);
+
+  meta->input_timestamp = 1234567890123ULL;
+  meta->model_time_ns = 4500000ULL;
+  g_strlcpy (meta->frame_id, "camera", EDGEFIRST_FRAME_ID_MAX_LEN);
+
+  dst = gst_buffer_copy (src);
+  copy = edgefirst_buffer_get_detection_meta (dst);
+  fail_unless (copy != NULL);
+  fail_unless (copy != meta);
+
+  /* The box list is immutable and shared, not duplicated */
+  fail_unless (copy->boxes == meta->boxes);
+  fail_unless_equals_int (edgefirst_detect_box_list_get_length (copy->boxes),
+      0);
+  fail_unless_equals_uint64 (copy->input_timestamp, 1234567890123ULL);
+  fail_unless_equals_uint64 (copy->model_time_ns, 4500000ULL);
+  fail_unless_equals_string (copy->frame_id, "camera");
+
+  /* The copy keeps the list alive on its own */
+  gst_buffer_unref (src);
+  fail_unless (EDGEFIRST_IS_DETECT_BOX_LIST (copy->boxes));
+  gst_buffer_unref (dst);
+
+  /* A buffer without the meta copies to one without it */
+  src = gst_buffer_new ();
+  dst = gst_buffer_copy (src);
+  fail_unless (edgefirst_buffer_get_detection_meta (dst) == NULL);
+  gst_buffer_unref (src);
+  gst_buffer_unref (dst);
+}
+GST_END_TEST;
+
 /* ── TCase "MiscMeta" ─────────────────────────────────────────────── */
 
 GST_START_TEST (test_meta_absent_on_empty_buffer)
@@ -206,6 +250,7 @@ GST_START_TEST (test_meta_absent_on_empty_buffer)
   fail_unless (edgefirst_buffer_get_radar_cube_meta (buf) == NULL);
   fail_unless (edgefirst_buffer_get_camera_info_meta (buf) == NULL);
   fail_unless (edgefirst_buffer_get_transform_meta (buf) == NULL);
+  fail_unless (edgefirst_buffer_get_detection_meta (buf) == NULL);
 
   gst_buffer_unref (buf);
 }
@@ -306,6 +351,7 @@ edgefirst_meta_copy_suite (void)
   tcase_add_test (tc_copy, test_radar_cube_meta_copy);
   tcase_add_test (tc_copy, test_camera_info_meta_copy);
   tcase_add_test (tc_copy, test_transform_meta_copy);
+  tcase_add_test (tc_copy, test_detection_meta_copy);
   suite_add_tcase (s, tc_copy);
 
   TCase *tc_misc = tcase_create ("MiscMeta");
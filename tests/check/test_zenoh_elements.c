@@ -0,0 +1,1327 @@
+/*
+ * EdgeFirst Perception for GStreamer - Zenoh Element Tests
+ * Copyright (C) 2026 Au-Zone Technologies
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define _GNU_SOURCE             /* memfd_create, F_ADD_SEALS */
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/allocators/gstdmabuf.h>
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "edgefirstzenohsub.h"
+#include "edgefirstzenoh-dmabuf.h"
+#include "edgefirstzenoh-compress.h"
+#include "edgefirstzenoh-normalize.h"
+#include "edgefirstzenoh-clocksync.h"
+#include "edgefirstzenoh-filter.h"
+#include "edgefirstzenoh-queue.h"
+#include "transform-cache.h"
+
+/* These tests never leave NULL state, so no Zenoh router is needed, except
+ * test_zenoh_dmabuf_end_to_end, which publishes to itself over a default
+ * peer session. */
+
+/* ── TCase "Creation" ──────────────────────────────────────────────── */
+
+GST_START_TEST (test_zenoh_sub_create)
+{
+  GstElement *el;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL, "Failed to create edgefirstzenohsub element");
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_demux_create)
+{
+  GstElement *el;
+
+  el = gst_element_factory_make ("edgefirstzenohdemux", NULL);
+  fail_unless (el != NULL, "Failed to create edgefirstzenohdemux element");
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_pub_create)
+{
+  GstElement *el;
+
+  el = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (el != NULL, "Failed to create edgefirstzenohpub element");
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+/* ── TCase "Queue" ─────────────────────────────────────────────────── */
+
+GST_START_TEST (test_zenoh_sub_queue_depth)
+{
+  GstElement *el;
+  guint depth;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+
+  g_object_get (el, "queue-depth", &depth, NULL);
+  fail_unless_equals_int (depth, 16);
+
+  g_object_set (el, "queue-depth", 1, NULL);
+  g_object_get (el, "queue-depth", &depth, NULL);
+  fail_unless_equals_int (depth, 1);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+typedef struct {
+  gint value;
+} TestQueueItem;
+
+static guint test_queue_cleared;
+
+static void
+test_queue_item_clear (gpointer data)
+{
+  test_queue_cleared++;
+}
+
+/* Pushes @from to @to, returns how many the queue took */
+static guint
+test_queue_push_range (EdgefirstZenohQueue *queue, GMutex *lock, gint from,
+    gint to)
+{
+  TestQueueItem *item;
+  guint taken = 0;
+
+  g_mutex_lock (lock);
+  for (gint v = from; v <= to; v++) {
+    item = edgefirst_zenoh_queue_push (queue, lock);
+    if (item) {
+      item->value = v;
+      taken++;
+    }
+  }
+  g_mutex_unlock (lock);
+
+  return taken;
+}
+
+/* Pops every item, checking they are @values in order */
+static void
+test_queue_expect (EdgefirstZenohQueue *queue, const gint *values, guint n)
+{
+  TestQueueItem item;
+
+  fail_unless_equals_int (edgefirst_zenoh_queue_get_length (queue), n);
+  for (guint i = 0; i < n; i++) {
+    fail_unless (edgefirst_zenoh_queue_pop (queue, &item));
+    fail_unless_equals_int (item.value, values[i]);
+  }
+  fail_if (edgefirst_zenoh_queue_pop (queue, &item));
+}
+
+typedef struct {
+  EdgefirstZenohQueue *queue;
+  GMutex *lock;
+  gint value;
+  gboolean done;
+} TestQueuePusher;
+
+static gpointer
+test_queue_pusher (gpointer data)
+{
+  TestQueuePusher *pusher = data;
+  TestQueueItem *item;
+
+  g_mutex_lock (pusher->lock);
+  item = edgefirst_zenoh_queue_push (pusher->queue, pusher->lock);
+  item->value = pusher->value;
+  pusher->done = TRUE;
+  g_mutex_unlock (pusher->lock);
+
+  return NULL;
+}
+
+/* Starts a push of @value on a full blocking queue and checks it waits */
+static GThread *
+test_queue_start_blocked_push (TestQueuePusher *pusher)
+{
+  GThread *thread;
+
+  pusher->done = FALSE;
+  thread = g_thread_new ("pusher", test_queue_pusher, pusher);
+  g_usleep (50 * G_TIME_SPAN_MILLISECOND);
+  g_mutex_lock (pusher->lock);
+  fail_if (pusher->done);
+  fail_unless_equals_int (edgefirst_zenoh_queue_get_length (pusher->queue),
+      3);
+  g_mutex_unlock (pusher->lock);
+
+  return thread;
+}
+
+GST_START_TEST (test_zenoh_sub_leaky)
+{
+  static const gint newest[] = { 2, 3, 4 }, oldest[] = { 0, 1, 2 },
+      latest[] = { 4 }, unblocked[] = { 1, 2, 3 }, released[] = { 2, 3, 4 },
+      resized[] = { 1, 2 };
+  EdgefirstZenohQueue queue;
+  GMutex lock;
+  TestQueuePusher pusher;
+  TestQueueItem item;
+  GThread *thread;
+  GstElement *el;
+  gint leaky;
+
+  /* The element defaults to the historical drop-oldest behaviour */
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+  g_object_get (el, "leaky", &leaky, NULL);
+  fail_unless_equals_int (leaky, EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM);
+  gst_object_unref (el);
+
+  g_mutex_init (&lock);
+  edgefirst_zenoh_queue_init (&queue, sizeof (TestQueueItem), 3,
+      test_queue_item_clear);
+
+  /* downstream: five into three keeps the newest, dropping the oldest */
+  test_queue_cleared = 0;
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 4), 5);
+  fail_unless (queue.dropped == 2);
+  fail_unless_equals_int (queue.high_water, 3);
+  fail_unless_equals_int (test_queue_cleared, 2);
+  test_queue_expect (&queue, newest, 3);
+
+  /* upstream: the new samples are refused instead */
+  queue.dropped = queue.high_water = 0;
+  test_queue_cleared = 0;
+  edgefirst_zenoh_queue_set_leaky (&queue, EDGEFIRST_ZENOH_SUB_LEAKY_UPSTREAM);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 4), 3);
+  fail_unless (queue.dropped == 2);
+  fail_unless_equals_int (queue.high_water, 3);
+  fail_unless_equals_int (test_queue_cleared, 0);
+  test_queue_expect (&queue, oldest, 3);
+
+  /* latest-only: every arrival drops everything pending */
+  queue.dropped = queue.high_water = 0;
+  test_queue_cleared = 0;
+  edgefirst_zenoh_queue_set_leaky (&queue,
+      EDGEFIRST_ZENOH_SUB_LEAKY_LATEST_ONLY);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 4), 5);
+  fail_unless (queue.dropped == 4);
+  fail_unless_equals_int (queue.high_water, 1);
+  fail_unless_equals_int (test_queue_cleared, 4);
+  test_queue_expect (&queue, latest, 1);
+
+  /* none without blocking (outside PLAYING, shared session) drops the
+   * oldest */
+  queue.dropped = queue.high_water = 0;
+  edgefirst_zenoh_queue_set_leaky (&queue, EDGEFIRST_ZENOH_SUB_LEAKY_NONE);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 4), 5);
+  fail_unless (queue.dropped == 2);
+  test_queue_expect (&queue, newest, 3);
+
+  /* none with blocking waits for a pop and drops nothing */
+  queue.dropped = queue.high_water = 0;
+  edgefirst_zenoh_queue_set_blocking (&queue, TRUE);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 2), 3);
+  pusher.queue = &queue;
+  pusher.lock = &lock;
+  pusher.value = 3;
+  thread = test_queue_start_blocked_push (&pusher);
+  g_mutex_lock (&lock);
+  fail_unless (edgefirst_zenoh_queue_pop (&queue, &item));
+  fail_unless_equals_int (item.value, 0);
+  g_mutex_unlock (&lock);
+  g_thread_join (thread);
+  fail_unless (pusher.done);
+  fail_unless (queue.dropped == 0);
+  test_queue_expect (&queue, unblocked, 3);
+
+  /* Turning blocking off releases a waiting push, which drops the oldest */
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 1, 3), 3);
+  pusher.value = 4;
+  thread = test_queue_start_blocked_push (&pusher);
+  g_mutex_lock (&lock);
+  edgefirst_zenoh_queue_set_blocking (&queue, FALSE);
+  g_mutex_unlock (&lock);
+  g_thread_join (thread);
+  fail_unless (pusher.done);
+  fail_unless (queue.dropped == 1);
+  fail_unless_equals_int (queue.high_water, 3);
+  test_queue_expect (&queue, released, 3);
+
+  /* Shrinking keeps the newest and counts the rest as dropped; flushing
+   * does not count */
+  queue.dropped = 0;
+  edgefirst_zenoh_queue_set_leaky (&queue,
+      EDGEFIRST_ZENOH_SUB_LEAKY_DOWNSTREAM);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 2), 3);
+  edgefirst_zenoh_queue_resize (&queue, 2);
+  fail_unless (queue.dropped == 1);
+  test_queue_expect (&queue, resized, 2);
+  fail_unless_equals_int (test_queue_push_range (&queue, &lock, 0, 1), 2);
+  test_queue_cleared = 0;
+  edgefirst_zenoh_queue_flush (&queue);
+  fail_unless_equals_int (test_queue_cleared, 2);
+  fail_unless (queue.dropped == 1);
+  fail_if (edgefirst_zenoh_queue_pop (&queue, &item));
+
+  edgefirst_zenoh_queue_clear (&queue);
+  g_mutex_clear (&lock);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_sub_stats)
+{
+  GstElement *el;
+  GstStructure *stats = NULL;
+  guint64 v64;
+  guint v;
+  GParamSpec *pspec;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (el), "stats");
+  fail_unless (pspec != NULL);
+  fail_if (pspec->flags & G_PARAM_WRITABLE);
+
+  g_object_get (el, "stats", &stats, NULL);
+  fail_unless (stats != NULL);
+
+  fail_unless (gst_structure_get_uint64 (stats, "received", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "decoded", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "dropped", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "decode-failures", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "filtered", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint (stats, "queue-high-water", &v));
+  fail_unless_equals_int (v, 0);
+  fail_unless (gst_structure_get_uint64 (stats, "latency", &v64));
+  fail_unless (v64 == 0);
+
+  gst_structure_free (stats);
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_sub_header_filters)
+{
+  GstElement *el;
+  guint max_age, min_interval;
+  gchar *frame_id;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+
+  /* All filters are off by default */
+  g_object_get (el, "max-age", &max_age, "min-interval", &min_interval,
+      "frame-id", &frame_id, NULL);
+  fail_unless_equals_int (max_age, 0);
+  fail_unless_equals_int (min_interval, 0);
+  fail_unless (frame_id == NULL);
+
+  g_object_set (el, "max-age", 200, "min-interval", 100,
+      "frame-id", "lidar_front, lidar_rear", NULL);
+  g_object_get (el, "max-age", &max_age, "min-interval", &min_interval,
+      "frame-id", &frame_id, NULL);
+  fail_unless_equals_int (max_age, 200);
+  fail_unless_equals_int (min_interval, 100);
+  fail_unless_equals_string (frame_id, "lidar_front, lidar_rear");
+  g_free (frame_id);
+
+  g_object_set (el, "frame-id", NULL, NULL);
+  g_object_get (el, "frame-id", &frame_id, NULL);
+  fail_unless (frame_id == NULL);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+static EdgefirstCdrHeader
+make_header (guint64 stamp_ms, const gchar *frame_id)
+{
+  EdgefirstCdrHeader header;
+
+  header.stamp_sec = (gint32) (stamp_ms / 1000);
+  header.stamp_nanosec = (guint32) (stamp_ms % 1000) * GST_MSECOND;
+  header.frame_id = frame_id;
+  header.frame_id_len = strlen (frame_id);
+  return header;
+}
+
+GST_START_TEST (test_zenoh_header_filter)
+{
+  EdgefirstZenohHeaderFilter filter;
+  EdgefirstCdrHeader h;
+  const guint64 now = G_GUINT64_CONSTANT (1700000000000) * GST_MSECOND;
+  const guint64 t0 = G_GUINT64_CONSTANT (1700000000000);  /* now, in ms */
+
+  edgefirst_zenoh_header_filter_init (&filter);
+
+  /* No filters: anything passes */
+  h = make_header (t0 - 60000, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+
+  /* max-age: 100 ms old passes, 101 ms old is dropped, unstamped and
+   * future-stamped samples pass */
+  filter.max_age = 100;
+  h = make_header (t0 - 100, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 - 101, "lidar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (0, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 + 50, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  filter.max_age = 0;
+
+  /* min-interval: 100 ms between accepted samples per stream and
+   * frame_id */
+  filter.min_interval = 100;
+  h = make_header (t0, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 + 50, "lidar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 + 50, "radar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, "rt/b", 4, &h,
+          now));
+  h = make_header (t0 + 99, "lidar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 + 100, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+
+  /* A stamp going backwards is accepted and restarts the interval */
+  h = make_header (t0 - 5000, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 - 4950, "lidar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0 - 4900, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+
+  /* Reset forgets the last stamps */
+  edgefirst_zenoh_header_filter_reset (&filter);
+  h = make_header (t0 - 4890, "lidar");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  filter.min_interval = 0;
+
+  /* frame-id allow-list, with surrounding spaces stripped */
+  edgefirst_zenoh_header_filter_set_frame_ids (&filter,
+      "lidar_front, lidar_rear");
+  h = make_header (t0, "lidar_front");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0, "lidar_rear");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (t0, "lidar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  h = make_header (0, "radar");
+  fail_if (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+  edgefirst_zenoh_header_filter_set_frame_ids (&filter, "");
+  fail_unless (edgefirst_zenoh_header_filter_accept (&filter, NULL, 0, &h,
+          now));
+
+  edgefirst_zenoh_header_filter_clear (&filter);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_pub_stats)
+{
+  GstElement *el;
+  GstStructure *stats = NULL;
+  guint64 v64;
+  gint when;
+
+  el = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (el != NULL);
+
+  g_object_get (el, "publish-when", &when, NULL);
+  fail_unless_equals_int (when, 0);
+  gst_util_set_object_arg (G_OBJECT (el), "publish-when", "matched");
+  g_object_get (el, "publish-when", &when, NULL);
+  fail_unless_equals_int (when, 1);
+
+  g_object_get (el, "stats", &stats, NULL);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "published", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "skipped", &v64));
+  fail_unless (v64 == 0);
+  fail_unless (gst_structure_get_uint64 (stats, "dropped", &v64));
+  fail_unless (v64 == 0);
+
+  gst_structure_free (stats);
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+/* ── TCase "Transport" ─────────────────────────────────────────────── */
+
+GST_START_TEST (test_zenoh_shm_properties)
+{
+  GstElement *sub, *pub;
+  gboolean shm;
+  guint size;
+
+  sub = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  pub = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (sub != NULL && pub != NULL);
+
+  /* Shared memory is opt-in on both sides */
+  g_object_get (sub, "shm", &shm, NULL);
+  fail_if (shm);
+  g_object_get (pub, "shm", &shm, "shm-size", &size, NULL);
+  fail_if (shm);
+  fail_unless_equals_int (size, 32 * 1024 * 1024);
+
+  g_object_set (sub, "shm", TRUE, NULL);
+  g_object_set (pub, "shm", TRUE, "shm-size", 4 * 1024 * 1024, NULL);
+  g_object_get (sub, "shm", &shm, NULL);
+  fail_unless (shm);
+  g_object_get (pub, "shm", &shm, "shm-size", &size, NULL);
+  fail_unless (shm);
+  fail_unless_equals_int (size, 4 * 1024 * 1024);
+
+  gst_object_unref (sub);
+  gst_object_unref (pub);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_pub_qos_properties)
+{
+  GstElement *pub;
+  GParamSpec *pspec;
+  GEnumValue *value;
+  gint congestion, priority;
+  gboolean express;
+  guint depth;
+
+  pub = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (pub != NULL);
+
+  g_object_get (pub, "congestion-control", &congestion, "priority", &priority,
+      "express", &express, "queue-depth", &depth, NULL);
+  fail_unless_equals_int (depth, 4);
+  fail_if (express);
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (pub),
+      "congestion-control");
+  value = g_enum_get_value (G_PARAM_SPEC_ENUM (pspec)->enum_class, congestion);
+  fail_unless_equals_string (value->value_nick, "drop");
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (pub), "priority");
+  value = g_enum_get_value (G_PARAM_SPEC_ENUM (pspec)->enum_class, priority);
+  fail_unless_equals_string (value->value_nick, "data");
+
+  /* Enums are settable from gst-launch style nicks */
+  gst_util_set_object_arg (G_OBJECT (pub), "congestion-control", "block");
+  gst_util_set_object_arg (G_OBJECT (pub), "priority", "real-time");
+  g_object_set (pub, "express", TRUE, "queue-depth", 0, NULL);
+  g_object_get (pub, "congestion-control", &congestion, "priority", &priority,
+      "express", &express, "queue-depth", &depth, NULL);
+  fail_unless_equals_int (congestion, 1);
+  fail_unless_equals_int (priority, 1);
+  fail_unless (express);
+  fail_unless_equals_int (depth, 0);
+
+  gst_object_unref (pub);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_pub_message_types)
+{
+  GstElement *el;
+  gint type;
+  guint hold;
+
+  el = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (el != NULL);
+
+  gst_util_set_object_arg (G_OBJECT (el), "message-type", "detect");
+  g_object_get (el, "message-type", &type, NULL);
+  fail_unless_equals_int (type, 4);
+
+  g_object_get (el, "dmabuf-hold", &hold, NULL);
+  fail_unless_equals_int (hold, 2);
+  g_object_set (el, "dmabuf-hold", 8, NULL);
+  g_object_get (el, "dmabuf-hold", &hold, NULL);
+  fail_unless_equals_int (hold, 8);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_dmabuf_fourcc)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_RGB,
+    GST_VIDEO_FORMAT_RGBA, GST_VIDEO_FORMAT_GRAY8,
+  };
+
+  for (guint i = 0; i < G_N_ELEMENTS (formats); i++) {
+    guint32 fourcc = edgefirst_zenoh_fourcc_from_video_format (formats[i]);
+
+    fail_if (fourcc == 0);
+    fail_unless_equals_int (edgefirst_zenoh_video_format_from_fourcc (fourcc),
+        formats[i]);
+  }
+
+  fail_unless (edgefirst_zenoh_fourcc_from_video_format
+      (GST_VIDEO_FORMAT_YUY2) == GST_MAKE_FOURCC ('Y', 'U', 'Y', 'V'));
+  fail_unless_equals_int (edgefirst_zenoh_fourcc_from_video_format
+      (GST_VIDEO_FORMAT_v210), 0);
+}
+GST_END_TEST;
+
+/* A memfd stands in for a DMA-BUF for the import itself: both are plain
+ * shareable fds */
+GST_START_TEST (test_zenoh_dmabuf_import_memfd)
+{
+  EdgefirstZenohFdImporter importer;
+  GError *error = NULL;
+  guint8 *map;
+  gint memfd, fd;
+
+  memfd = memfd_create ("zenoh-dmabuf-test", 0);
+  fail_unless (memfd >= 0);
+  fail_unless (ftruncate (memfd, 4096) == 0);
+  map = mmap (NULL, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+  fail_unless (map != MAP_FAILED);
+  map[100] = 0x5a;
+
+  edgefirst_zenoh_fd_importer_init (&importer);
+  fd = edgefirst_zenoh_fd_importer_import (&importer, getpid (), memfd,
+      &error);
+  fail_unless (fd >= 0, "import failed: %s", error ? error->message : "");
+  fail_unless (fd != memfd);
+  munmap (map, 4096);
+
+  /* Same pages through the imported fd */
+  map = mmap (NULL, 4096, PROT_READ, MAP_SHARED, fd, 0);
+  fail_unless (map != MAP_FAILED);
+  fail_unless_equals_int (map[100], 0x5a);
+  munmap (map, 4096);
+
+  /* A pid that cannot exist */
+  fail_unless (edgefirst_zenoh_fd_importer_import (&importer, G_MAXINT, memfd,
+          &error) < 0);
+  fail_unless (error != NULL);
+  g_clear_error (&error);
+
+  edgefirst_zenoh_fd_importer_clear (&importer);
+  close (fd);
+  close (memfd);
+}
+GST_END_TEST;
+
+/* Only a DMA-BUF or a memfd sealed against shrinking, long enough for the
+ * frame, may be mapped, and only a pid from this host is imported */
+GST_START_TEST (test_zenoh_dmabuf_checks)
+{
+  static const gchar remote[] =
+      "edgefirst-host=00000000-0000-0000-0000-000000000000";
+  const gchar *local;
+  GError *error = NULL;
+  gint memfd;
+
+  /* Unsealed: the publisher could truncate it under the mapping */
+  memfd = memfd_create ("zenoh-dmabuf-test", MFD_ALLOW_SEALING);
+  fail_unless (memfd >= 0);
+  fail_unless (ftruncate (memfd, 4096) == 0);
+  fail_if (edgefirst_zenoh_fd_is_dmabuf (memfd));
+  fail_if (edgefirst_zenoh_dmabuf_check (memfd, 4096, &error));
+  fail_unless (error != NULL);
+  g_clear_error (&error);
+
+  /* The publisher seals it, once */
+  fail_unless (edgefirst_zenoh_dmabuf_seal (memfd, &error));
+  fail_unless (fcntl (memfd, F_GET_SEALS) & F_SEAL_SHRINK);
+  fail_unless (edgefirst_zenoh_dmabuf_seal (memfd, &error));
+  fail_unless (ftruncate (memfd, 1024) != 0);
+  fail_unless (edgefirst_zenoh_dmabuf_check (memfd, 4096, &error));
+  fail_unless (edgefirst_zenoh_dmabuf_check (memfd, 100, &error));
+
+  /* Sealed but shorter than the frame */
+  fail_if (edgefirst_zenoh_dmabuf_check (memfd, 4097, &error));
+  g_clear_error (&error);
+  fail_if (edgefirst_zenoh_dmabuf_check (memfd, 0, &error));
+  g_clear_error (&error);
+  close (memfd);
+
+  /* Without MFD_ALLOW_SEALING it cannot be sealed */
+  memfd = memfd_create ("zenoh-dmabuf-test", 0);
+  fail_unless (memfd >= 0);
+  fail_unless (ftruncate (memfd, 4096) == 0);
+  fail_if (edgefirst_zenoh_dmabuf_seal (memfd, &error));
+  fail_unless (error != NULL);
+  g_clear_error (&error);
+  close (memfd);
+
+  fail_if (edgefirst_zenoh_dmabuf_check (-1, 4096, &error));
+  g_clear_error (&error);
+
+  local = edgefirst_zenoh_dmabuf_attachment ();
+  if (local) {
+    fail_unless (g_str_has_prefix (local, "edgefirst-host="));
+    fail_unless (edgefirst_zenoh_dmabuf_attachment_is_local (local,
+            strlen (local)));
+    /* A truncated boot id does not match */
+    fail_if (edgefirst_zenoh_dmabuf_attachment_is_local (local,
+            strlen (local) - 1));
+  }
+  fail_if (edgefirst_zenoh_dmabuf_attachment_is_local (remote,
+          strlen (remote)));
+  fail_if (edgefirst_zenoh_dmabuf_attachment_is_local (NULL, 0));
+}
+GST_END_TEST;
+
+/* A sealable memfd frame published with message-type=dmabuffer comes back
+ * out of a subscriber in the same process, mapped from the imported fd */
+GST_START_TEST (test_zenoh_dmabuf_end_to_end)
+{
+  GstHarness *pub, *sub;
+  GstAllocator *allocator;
+  GstBuffer *buffer, *out = NULL;
+  GstCaps *caps;
+  GstMapInfo map;
+  guint8 *data;
+  gint memfd;
+
+  /* The subscriber only imports fds from samples tagged with this host */
+  if (!edgefirst_zenoh_dmabuf_attachment ())
+    return;
+
+  memfd = memfd_create ("zenoh-dmabuf-e2e", MFD_ALLOW_SEALING);
+  fail_unless (memfd >= 0);
+  fail_unless (ftruncate (memfd, 64 * 16) == 0);
+  data = mmap (NULL, 64 * 16, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+  fail_unless (data != MAP_FAILED);
+  for (guint i = 0; i < 64 * 16; i++)
+    data[i] = (guint8) i;
+  munmap (data, 64 * 16);
+
+  allocator = gst_fd_allocator_new ();
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, gst_fd_allocator_alloc (allocator, memfd,
+          64 * 16, GST_FD_MEMORY_FLAG_NONE));
+
+  /* max-age only passes wall-clock header stamps */
+  sub = gst_harness_new_parse ("edgefirstzenohsub topic=test/dmabuf/e2e "
+      "message-type=dmabuffer max-age=60000");
+  gst_harness_play (sub);
+  pub = gst_harness_new_parse ("edgefirstzenohpub topic=test/dmabuf/e2e "
+      "message-type=dmabuffer queue-depth=0 sync=false");
+  gst_harness_set_src_caps_str (pub,
+      "video/x-raw, format=GRAY8, width=64, height=16, framerate=30/1");
+
+  /* Keep publishing until the subscriber is declared and a frame is
+   * through */
+  for (guint i = 0; i < 100 && !out; i++) {
+    fail_unless_equals_int (gst_harness_push (pub, gst_buffer_ref (buffer)),
+        GST_FLOW_OK);
+    g_usleep (20 * G_TIME_SPAN_MILLISECOND);
+    out = gst_harness_try_pull (sub);
+  }
+  fail_unless (out != NULL, "no DmaBuffer sample received");
+
+  /* Sealed memfds come out as plain fd memory, not DMA-BUF */
+  fail_unless (fcntl (memfd, F_GET_SEALS) & F_SEAL_SHRINK);
+  fail_unless_equals_int (gst_buffer_n_memory (out), 1);
+  fail_unless (gst_is_fd_memory (gst_buffer_peek_memory (out, 0)));
+  fail_if (gst_is_dmabuf_memory (gst_buffer_peek_memory (out, 0)));
+  caps = gst_pad_get_current_caps (sub->sinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_caps_features_is_equal (gst_caps_get_features (caps, 0),
+          GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY));
+  gst_caps_unref (caps);
+
+  fail_unless (gst_buffer_map (out, &map, GST_MAP_READ));
+  fail_unless_equals_int (map.size, 64 * 16);
+  fail_unless_equals_int (map.data[0], 0);
+  fail_unless_equals_int (map.data[321], 321 & 0xff);
+  gst_buffer_unmap (out, &map);
+
+  gst_buffer_unref (out);
+  gst_harness_teardown (sub);
+  gst_harness_teardown (pub);
+  gst_buffer_unref (buffer);
+  gst_object_unref (allocator);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_pub_compression_properties)
+{
+  GstElement *el;
+  gint compression;
+  gfloat precision;
+
+  el = gst_element_factory_make ("edgefirstzenohpub", NULL);
+  fail_unless (el != NULL);
+
+  g_object_get (el, "compression", &compression,
+      "compression-precision", &precision, NULL);
+  fail_unless_equals_int (compression, 0);
+  fail_unless (precision == 1.0f);
+
+  gst_util_set_object_arg (G_OBJECT (el), "compression", "quantized-zstd");
+  g_object_set (el, "compression-precision", 5.0f, NULL);
+  g_object_get (el, "compression", &compression,
+      "compression-precision", &precision, NULL);
+  fail_unless_equals_int (compression, 3);
+  fail_unless (precision == 5.0f);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_compress_roundtrip)
+{
+  EdgefirstZenohCompressionInfo info = {
+    EDGEFIRST_ZENOH_PUB_COMPRESSION_QUANTIZED_ZSTD, 4096, 2.0f
+  }, parsed;
+  EdgefirstPointFieldDesc fields[4];
+  EdgefirstZenohCodec *codec;
+  gfloat points[256][4], restored[256][4];
+  guint offsets[3];
+  gchar *attachment;
+
+  /* Attachment text */
+  attachment = edgefirst_zenoh_compression_to_attachment (&info);
+  fail_unless (edgefirst_zenoh_compression_from_attachment (attachment,
+          strlen (attachment), &parsed));
+  fail_unless_equals_int (parsed.codec, info.codec);
+  fail_unless (parsed.size == 4096);
+  fail_unless (parsed.precision == 2.0f);
+  fail_if (edgefirst_zenoh_compression_from_attachment ("other=1", 7,
+          &parsed));
+  g_free (attachment);
+
+  /* x/y/z quantization keeps the other fields and NaN */
+  fail_unless_equals_int (edgefirst_parse_point_fields
+      ("x:F32:0,y:F32:4,z:F32:8,intensity:F32:12", fields, 4), 4);
+  fail_unless (edgefirst_zenoh_find_xyz (fields, 4, offsets));
+  for (guint i = 0; i < 256; i++) {
+    points[i][0] = i * 0.0123f;
+    points[i][1] = -1.5f + i * 0.001f;
+    points[i][2] = 42.0f;
+    points[i][3] = i * 0.5f;
+  }
+  points[7][2] = NAN;
+
+  edgefirst_zenoh_quantize_xyz ((guint8 *) restored, (guint8 *) points, 256,
+      16, offsets, 2.0f);
+  edgefirst_zenoh_dequantize_xyz ((guint8 *) restored, 256, 16, offsets,
+      2.0f);
+  for (guint i = 0; i < 256; i++) {
+    for (guint axis = 0; axis < 3; axis++) {
+      if (i == 7 && axis == 2)
+        fail_unless (isnan (restored[i][axis]));
+      else
+        fail_unless (fabsf (restored[i][axis] - points[i][axis]) <= 0.001f);
+    }
+    fail_unless (restored[i][3] == points[i][3]);
+  }
+
+  /* Lossless codecs, fed in pieces as from a multi-slice payload */
+  codec = edgefirst_zenoh_codec_new ();
+  for (gint c = EDGEFIRST_ZENOH_PUB_COMPRESSION_LZ4;
+      c <= EDGEFIRST_ZENOH_PUB_COMPRESSION_ZSTD; c++) {
+    guint8 *packed;
+    gsize len;
+
+    if (!edgefirst_zenoh_compression_available (c))
+      continue;
+
+    packed = edgefirst_zenoh_codec_compress (codec, c, (guint8 *) points,
+        sizeof (points), &len);
+    fail_unless (packed != NULL);
+    fail_unless (len > 2);
+
+    memset (restored, 0, sizeof (restored));
+    fail_unless (edgefirst_zenoh_codec_decompress_begin (codec, c,
+            (guint8 *) restored, sizeof (restored)));
+    fail_unless (edgefirst_zenoh_codec_decompress_feed (codec, packed, 2));
+    fail_unless (edgefirst_zenoh_codec_decompress_feed (codec, packed + 2,
+            len - 2));
+    fail_unless (edgefirst_zenoh_codec_decompress_end (codec));
+    fail_unless (memcmp (restored, points, sizeof (points)) == 0);
+
+    /* A truncated block is rejected */
+    fail_unless (edgefirst_zenoh_codec_decompress_begin (codec, c,
+            (guint8 *) restored, sizeof (restored)));
+    edgefirst_zenoh_codec_decompress_feed (codec, packed, len / 2);
+    fail_if (edgefirst_zenoh_codec_decompress_end (codec));
+
+    g_free (packed);
+  }
+  edgefirst_zenoh_codec_free (codec);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_sub_timestamp_mode)
+{
+  GstElement *el;
+  GParamSpec *pspec;
+  GEnumClass *klass;
+  gint mode;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+
+  g_object_get (el, "timestamp-mode", &mode, NULL);
+  fail_unless_equals_int (mode, EDGEFIRST_ZENOH_SUB_TIMESTAMP_ARRIVAL);
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (el),
+      "timestamp-mode");
+  klass = G_PARAM_SPEC_ENUM (pspec)->enum_class;
+  fail_unless (g_enum_get_value_by_nick (klass, "arrival") != NULL);
+  fail_unless (g_enum_get_value_by_nick (klass, "sensor") != NULL);
+
+  gst_util_set_object_arg (G_OBJECT (el), "timestamp-mode", "sensor");
+  g_object_get (el, "timestamp-mode", &mode, NULL);
+  fail_unless_equals_int (mode, EDGEFIRST_ZENOH_SUB_TIMESTAMP_SENSOR);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_clock_sync)
+{
+  const GstClockTime epoch = 1700000000 * GST_SECOND;
+  const gdouble drift = 200e-6;
+  EdgefirstZenohClockSync sync;
+  GstClockTime stamp, arrival, mapped;
+  gdouble earliest;
+  guint32 jitter = 12345;
+
+  edgefirst_zenoh_clock_sync_reset (&sync);
+
+  /* 10 Hz sensor, pipeline clock 200 ppm fast and 5 s behind, 2 ms
+   * transport delay plus up to 5 ms of jitter and a 40 ms stall now and
+   * then.  After warm-up the mapping tracks the earliest possible arrival
+   * within 2 ms. */
+  for (guint i = 0; i < 2000; i++) {
+    stamp = epoch + i * 100 * GST_MSECOND;
+    earliest = (stamp - epoch) * (1.0 + drift) + 5 * GST_SECOND +
+        2 * GST_MSECOND;
+    jitter = jitter * 1103515245 + 12345;
+    arrival = (GstClockTime) earliest + (jitter >> 16) % (5 * 1000) *
+        GST_USECOND + (i % 97 == 0 ? 40 * GST_MSECOND : 0);
+
+    mapped = edgefirst_zenoh_clock_sync_update (&sync, stamp, arrival);
+    fail_unless (mapped <= arrival);
+    if (i >= 300)
+      fail_unless (fabs ((gdouble) mapped - earliest) < 2 * GST_MSECOND);
+  }
+  fail_unless (fabs (edgefirst_zenoh_clock_sync_get_drift (&sync) - drift) <
+      50e-6);
+  fail_unless (edgefirst_zenoh_clock_sync_get_latency (&sync) >=
+      4 * GST_MSECOND);
+
+  /* A publisher restart with an older stamp restarts the estimate */
+  mapped = edgefirst_zenoh_clock_sync_update (&sync, epoch, arrival);
+  fail_unless (mapped == arrival);
+  fail_unless (edgefirst_zenoh_clock_sync_get_latency (&sync) == 0);
+}
+GST_END_TEST;
+
+static void
+make_transform (EdgefirstTransformData *td, const gchar *parent,
+    guint64 stamp, gdouble x, gdouble yaw)
+{
+  memset (td, 0, sizeof (*td));
+  g_strlcpy (td->child_frame_id, "lidar", EDGEFIRST_FRAME_ID_MAX_LEN);
+  g_strlcpy (td->parent_frame_id, parent, EDGEFIRST_FRAME_ID_MAX_LEN);
+  td->timestamp_ns = stamp;
+  td->translation[0] = x;
+  td->rotation[2] = sin (yaw / 2);
+  td->rotation[3] = cos (yaw / 2);
+}
+
+GST_START_TEST (test_zenoh_transform_history)
+{
+  const guint64 ms = 1000 * 1000;
+  EdgefirstTransformCache *cache = edgefirst_transform_cache_new ();
+  EdgefirstTransformData td, out;
+  GstElement *el;
+  gchar *topic;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+  g_object_get (el, "tf-topic", &topic, NULL);
+  fail_unless (topic == NULL);
+  g_object_set (el, "tf-topic", "rt/tf", NULL);
+  g_object_get (el, "tf-topic", &topic, NULL);
+  fail_unless_equals_string (topic, "rt/tf");
+  g_free (topic);
+  gst_object_unref (el);
+
+  /* Base moving at 1 m per 100 ms while turning 90 degrees; the 200 ms
+   * transform arrives late */
+  make_transform (&td, "base", 100 * ms, 0.0, 0.0);
+  edgefirst_transform_cache_insert_dynamic (cache, &td);
+  make_transform (&td, "base", 300 * ms, 2.0, G_PI);
+  edgefirst_transform_cache_insert_dynamic (cache, &td);
+  make_transform (&td, "base", 200 * ms, 1.0, G_PI / 2);
+  edgefirst_transform_cache_insert_dynamic (cache, &td);
+
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          "base", 150 * ms, &out));
+  fail_unless (fabs (out.translation[0] - 0.5) < 1e-9);
+  fail_unless (fabs (out.rotation[2] - sin (G_PI / 8)) < 1e-9);
+  fail_unless (fabs (out.rotation[3] - cos (G_PI / 8)) < 1e-9);
+  fail_unless (out.timestamp_ns == 150 * ms);
+
+  /* Latest, held briefly past either end, then given up on */
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 0, &out));
+  fail_unless (out.translation[0] == 2.0);
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 350 * ms, &out));
+  fail_unless (out.translation[0] == 2.0);
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 50 * ms, &out));
+  fail_unless (out.translation[0] == 0.0);
+  fail_if (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 500 * ms, &out));
+  fail_if (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          "map", 150 * ms, &out));
+
+  /* The history is bounded; the oldest transforms go first */
+  for (guint i = 0; i < EDGEFIRST_TRANSFORM_CACHE_DEPTH; i++) {
+    make_transform (&td, "base", (400 + i) * ms, 3.0, 0.0);
+    edgefirst_transform_cache_insert_dynamic (cache, &td);
+  }
+  fail_if (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 150 * ms, &out));
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          NULL, 400 * ms, &out));
+
+  /* A static transform replaces the history and holds at any time */
+  make_transform (&td, "base", 0, 4.0, 0.0);
+  edgefirst_transform_cache_insert (cache, &td);
+  fail_unless (edgefirst_transform_cache_lookup_at_time (cache, "lidar",
+          "base", 10000 * ms, &out));
+  fail_unless (out.translation[0] == 4.0);
+
+  edgefirst_transform_cache_free (cache);
+}
+GST_END_TEST;
+
+static void
+insert_edge (EdgefirstTransformCache *cache, const gchar *child,
+    const gchar *parent, gdouble x, gdouble y, gdouble yaw)
+{
+  EdgefirstTransformData td;
+
+  make_transform (&td, parent, 0, x, yaw);
+  g_strlcpy (td.child_frame_id, child, EDGEFIRST_FRAME_ID_MAX_LEN);
+  td.translation[1] = y;
+  edgefirst_transform_cache_insert (cache, &td);
+}
+
+GST_START_TEST (test_zenoh_transform_resolve)
+{
+  EdgefirstTransformCache *cache = edgefirst_transform_cache_new ();
+  EdgefirstTransformData out;
+  guint lidar, map;
+  gdouble m[12];
+  GstElement *el;
+  gchar *frame;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+  g_object_get (el, "target-frame", &frame, NULL);
+  fail_unless (frame == NULL);
+  g_object_set (el, "target-frame", "camera", NULL);
+  g_object_get (el, "target-frame", &frame, NULL);
+  fail_unless_equals_string (frame, "camera");
+  g_free (frame);
+  gst_object_unref (el);
+
+  /* lidar 1 m ahead of base_link, camera 1 m left of it turned 90 degrees
+   * left, and base_link on map */
+  insert_edge (cache, "lidar", "base_link", 1.0, 0.0, 0.0);
+  insert_edge (cache, "camera", "base_link", 0.0, 1.0, G_PI / 2);
+  insert_edge (cache, "base_link", "map", 10.0, 0.0, 0.0);
+
+  /* The lidar origin is 1 m right and 1 m behind in the camera frame, and
+   * lidar x is camera -y */
+  fail_unless (edgefirst_transform_cache_resolve (cache, "lidar", "camera",
+          0, m));
+  fail_unless (fabs (m[3] - -1.0) < 1e-9 && fabs (m[7] - -1.0) < 1e-9 &&
+      fabs (m[11]) < 1e-9);
+  fail_unless (fabs (m[0]) < 1e-9 && fabs (m[4] - -1.0) < 1e-9);
+
+  fail_unless (edgefirst_transform_cache_resolve_transform (cache, "camera",
+          "lidar", 0, &out));
+  fail_unless_equals_string (out.child_frame_id, "camera");
+  fail_unless_equals_string (out.parent_frame_id, "lidar");
+  fail_unless (fabs (out.translation[0] - -1.0) < 1e-9);
+  fail_unless (fabs (out.translation[1] - 1.0) < 1e-9);
+  fail_unless (fabs (out.rotation[2] - sin (G_PI / 4)) < 1e-9);
+  fail_unless (fabs (out.rotation[3] - cos (G_PI / 4)) < 1e-9);
+
+  /* Up the tree through two edges, and back down */
+  fail_unless (edgefirst_transform_cache_resolve (cache, "lidar", "map",
+          0, m));
+  fail_unless (fabs (m[3] - 11.0) < 1e-9);
+  fail_unless (edgefirst_transform_cache_resolve (cache, "map", "lidar",
+          0, m));
+  fail_unless (fabs (m[3] - -11.0) < 1e-9);
+
+  fail_unless (edgefirst_transform_cache_resolve (cache, "lidar", "lidar",
+          0, m));
+  fail_unless (m[0] == 1.0 && m[3] == 0.0);
+  fail_if (edgefirst_transform_cache_resolve (cache, "lidar", "radar",
+          0, m));
+
+  /* A new transform invalidates the memoized path */
+  insert_edge (cache, "lidar", "base_link", 2.0, 0.0, 0.0);
+  fail_unless (edgefirst_transform_cache_resolve (cache, "lidar", "map",
+          0, m));
+  fail_unless (fabs (m[3] - 12.0) < 1e-9);
+
+  /* Handles are stable, and lock-free lookups by handle agree */
+  lidar = edgefirst_transform_cache_intern (cache, "lidar");
+  map = edgefirst_transform_cache_intern (cache, "map");
+  fail_unless (lidar != 0 && map != 0 && lidar != map);
+  fail_unless_equals_int (edgefirst_transform_cache_intern (cache, "lidar"),
+      lidar);
+  fail_unless (edgefirst_transform_cache_resolve_frames (cache, lidar, map,
+          0, m, &out));
+  fail_unless (fabs (m[3] - 12.0) < 1e-9);
+  fail_unless_equals_string (out.parent_frame_id, "map");
+  fail_unless (edgefirst_transform_cache_lookup_frame (cache, lidar, 0,
+          &out));
+  fail_unless_equals_string (out.parent_frame_id, "base_link");
+  fail_if (edgefirst_transform_cache_lookup_frame (cache, 0, 0, &out));
+
+  edgefirst_transform_cache_clear (cache);
+  fail_if (edgefirst_transform_cache_resolve_frames (cache, lidar, map, 0,
+          m, NULL));
+  fail_unless_equals_int (edgefirst_transform_cache_intern (cache, "lidar"),
+      lidar);
+
+  edgefirst_transform_cache_free (cache);
+}
+GST_END_TEST;
+
+static void
+write_be64 (guint8 *p, gdouble v)
+{
+  guint64 u;
+
+  memcpy (&u, &v, sizeof (u));
+  u = GUINT64_TO_BE (u);
+  memcpy (p, &u, sizeof (u));
+}
+
+GST_START_TEST (test_zenoh_normalize_layout)
+{
+  EdgefirstPointFieldDesc fields[4];
+  EdgefirstZenohPointLayout layout;
+  guint8 src[40 * 9];
+  gfloat out[9][4];
+  gfloat packed[5][4];
+  GstElement *el;
+  gboolean normalize;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+  g_object_get (el, "normalize-layout", &normalize, NULL);
+  fail_if (normalize);
+  g_object_set (el, "normalize-layout", TRUE, NULL);
+  g_object_get (el, "normalize-layout", &normalize, NULL);
+  fail_unless (normalize);
+  gst_object_unref (el);
+
+  /* The normalized layout passes through */
+  fail_unless_equals_int (edgefirst_parse_point_fields
+      (EDGEFIRST_ZENOH_NORMALIZED_FIELDS, fields, 4), 4);
+  fail_unless (edgefirst_zenoh_point_layout_init (&layout, fields, 4, 16,
+          G_BYTE_ORDER == G_BIG_ENDIAN));
+  fail_unless (edgefirst_zenoh_point_layout_is_normalized (&layout));
+
+  /* Big-endian FLOAT64 x/y/z, UINT16 intensity, 40-byte points */
+  fail_unless_equals_int (edgefirst_parse_point_fields
+      ("intensity:U16:0,x:F64:8,y:F64:16,z:F64:24", fields, 4), 4);
+  fail_unless (edgefirst_zenoh_point_layout_init (&layout, fields, 4, 40,
+          TRUE));
+  fail_if (edgefirst_zenoh_point_layout_is_normalized (&layout));
+  memset (src, 0, sizeof (src));
+  for (guint i = 0; i < 9; i++) {
+    guint16 intensity = GUINT16_TO_BE (i * 1000);
+
+    memcpy (src + i * 40, &intensity, sizeof (intensity));
+    write_be64 (src + i * 40 + 8, i * 1.5);
+    write_be64 (src + i * 40 + 16, -(gdouble) i);
+    write_be64 (src + i * 40 + 24, i * 0.25);
+  }
+  edgefirst_zenoh_normalize_points (&layout, (guint8 *) out, src, 9);
+  for (guint i = 0; i < 9; i++) {
+    fail_unless (out[i][0] == i * 1.5f);
+    fail_unless (out[i][1] == -(gfloat) i);
+    fail_unless (out[i][2] == i * 0.25f);
+    fail_unless (out[i][3] == i * 1000.0f);
+  }
+
+  /* Shuffled FLOAT32 x/z/y without intensity */
+  fail_unless_equals_int (edgefirst_parse_point_fields
+      ("x:F32:0,z:F32:4,y:F32:12", fields, 4), 3);
+  fail_unless (edgefirst_zenoh_point_layout_init (&layout, fields, 3, 16,
+          G_BYTE_ORDER == G_BIG_ENDIAN));
+  for (guint i = 0; i < 5; i++) {
+    packed[i][0] = i;
+    packed[i][1] = i + 2.0f;
+    packed[i][2] = 7.0f;
+    packed[i][3] = i + 1.0f;
+  }
+  edgefirst_zenoh_normalize_points (&layout, (guint8 *) out,
+      (guint8 *) packed, 5);
+  for (guint i = 0; i < 5; i++) {
+    fail_unless (out[i][0] == i);
+    fail_unless (out[i][1] == i + 1.0f);
+    fail_unless (out[i][2] == i + 2.0f);
+    fail_unless (out[i][3] == 0.0f);
+  }
+
+  /* No z */
+  fail_if (edgefirst_zenoh_point_layout_init (&layout, fields, 2, 16,
+          FALSE));
+}
+GST_END_TEST;
+
+/* ── TCase "Pads" ──────────────────────────────────────────────────── */
+
+GST_START_TEST (test_zenoh_sub_pad_templates)
+{
+  GstElement *el;
+  GstPad *pad;
+
+  el = gst_element_factory_make ("edgefirstzenohsub", NULL);
+  fail_unless (el != NULL);
+
+  pad = gst_element_get_static_pad (el, "src");
+  fail_unless (pad != NULL);
+  gst_object_unref (pad);
+
+  pad = gst_element_get_static_pad (el, "sink");
+  fail_unless (pad == NULL);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_zenoh_demux_pad_templates)
+{
+  GstElement *el;
+  GstPadTemplate *templ;
+  GstStructure *stats = NULL;
+  guint depth, streams;
+
+  el = gst_element_factory_make ("edgefirstzenohdemux", NULL);
+  fail_unless (el != NULL);
+
+  /* Pads appear per key expression once samples arrive */
+  fail_unless (el->numsrcpads == 0);
+  templ = gst_element_class_get_pad_template (GST_ELEMENT_GET_CLASS (el),
+      "src_%s");
+  fail_unless (templ != NULL);
+  fail_unless_equals_int (GST_PAD_TEMPLATE_PRESENCE (templ),
+      GST_PAD_SOMETIMES);
+  fail_unless (gst_element_class_get_pad_template (GST_ELEMENT_GET_CLASS
+          (el), "sink") == NULL);
+
+  g_object_get (el, "queue-depth", &depth, NULL);
+  fail_unless_equals_int (depth, 16);
+
+  g_object_get (el, "stats", &stats, NULL);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint (stats, "streams", &streams));
+  fail_unless_equals_int (streams, 0);
+  gst_structure_free (stats);
+
+  gst_object_unref (el);
+}
+GST_END_TEST;
+
+static Suite *
+edgefirst_zenoh_elements_suite (void)
+{
+  Suite *s = suite_create ("EdgeFirst Zenoh Elements");
+
+  TCase *tc_create = tcase_create ("Creation");
+  tcase_add_test (tc_create, test_zenoh_sub_create);
+  tcase_add_test (tc_create, test_zenoh_demux_create);
+  tcase_add_test (tc_create, test_zenoh_pub_create);
+  suite_add_tcase (s, tc_create);
+
+  TCase *tc_queue = tcase_create ("Queue");
+  tcase_add_test (tc_queue, test_zenoh_sub_queue_depth);
+  tcase_add_test (tc_queue, test_zenoh_sub_leaky);
+  tcase_add_test (tc_queue, test_zenoh_sub_stats);
+  tcase_add_test (tc_queue, test_zenoh_sub_header_filters);
+  tcase_add_test (tc_queue, test_zenoh_header_filter);
+  tcase_add_test (tc_queue, test_zenoh_pub_stats);
+  suite_add_tcase (s, tc_queue);
+
+  TCase *tc_transport = tcase_create ("Transport");
+  tcase_add_test (tc_transport, test_zenoh_shm_properties);
+  tcase_add_test (tc_transport, test_zenoh_pub_qos_properties);
+  tcase_add_test (tc_transport, test_zenoh_pub_message_types);
+  tcase_add_test (tc_transport, test_zenoh_dmabuf_fourcc);
+  tcase_add_test (tc_transport, test_zenoh_dmabuf_import_memfd);
+  tcase_add_test (tc_transport, test_zenoh_dmabuf_checks);
+  tcase_add_test (tc_transport, test_zenoh_dmabuf_end_to_end);
+  tcase_add_test (tc_transport, test_zenoh_pub_compression_properties);
+  tcase_add_test (tc_transport, test_zenoh_compress_roundtrip);
+  tcase_add_test (tc_transport, test_zenoh_normalize_layout);
+  tcase_add_test (tc_transport, test_zenoh_sub_timestamp_mode);
+  tcase_add_test (tc_transport, test_zenoh_clock_sync);
+  tcase_add_test (tc_transport, test_zenoh_transform_history);
+  tcase_add_test (tc_transport, test_zenoh_transform_resolve);
+  suite_add_tcase (s, tc_transport);
+
+  TCase *tc_pads = tcase_create ("Pads");
+  tcase_add_test (tc_pads, test_zenoh_sub_pad_templates);
+  tcase_add_test (tc_pads, test_zenoh_demux_pad_templates);
+  suite_add_tcase (s, tc_pads);
+
+  return s;
+}
+
+GST_CHECK_MAIN (edgefirst_zenoh_elements);